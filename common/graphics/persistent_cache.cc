@@ -4,10 +4,17 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <tuple>
 
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
@@ -24,6 +31,8 @@ namespace flutter {
 
 std::string PersistentCache::cache_base_path_;
 
+bool PersistentCache::use_archive_ = false;
+
 std::shared_ptr<AssetManager> PersistentCache::asset_manager_;
 
 std::mutex PersistentCache::instance_mutex_;
@@ -78,6 +87,10 @@ void PersistentCache::SetCacheDirectoryPath(std::string path) {
   cache_base_path_ = path;
 }
 
+void PersistentCache::SetUseArchive(bool value) {
+  use_archive_ = value;
+}
+
 bool PersistentCache::Purge() {
   // Make sure that this is called after the worker task runner setup so all the
   // file system modifications would happen on that single thread to avoid
@@ -85,8 +98,11 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   archive = archive_,
+                                   sksl_archive = sksl_archive_,
+                                   usage = usage_,
+                                   read_only = is_read_only_]() {
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -98,7 +114,17 @@ bool PersistentCache::Purge() {
         }
         return fml::UnlinkFile(directory, filename.c_str());
       };
-      removed.set_value(VisitFilesRecursively(*cache_directory, delete_file));
+      bool success = VisitFilesRecursively(*cache_directory, delete_file);
+      // Start new archives in place of the removed ones.
+      for (const auto& cache_archive : {archive, sksl_archive}) {
+        if (cache_archive && !read_only) {
+          success = cache_archive->Clear() && success;
+        }
+      }
+      if (usage) {
+        usage->Clear();
+      }
+      removed.set_value(success);
     } else {
       removed.set_value(false);
     }
@@ -106,6 +132,182 @@ bool PersistentCache::Purge() {
   return removed.get_future().get();
 }
 
+static void RunOnWorker(fml::RefPtr<fml::TaskRunner> worker,
+                        const fml::closure& task) {
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostTask(task);
+  }
+}
+
+// The cache is pruned again once the entries stored since it was last pruned
+// take up this fraction of its maximum size.
+static constexpr size_t kPruneGrowthDivisor = 8;
+
+// Uses are written some time after they happen so that the many uses of a
+// burst of shader compilations are written at once.
+static constexpr fml::TimeDelta kUsageSaveDelay =
+    fml::TimeDelta::FromSeconds(5);
+
+static int64_t NowInSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static std::string KeyToString(const SkData& key) {
+  return std::string(reinterpret_cast<const char*>(key.data()), key.size());
+}
+
+namespace {
+
+// An entry of a cache directory that may be removed by |PruneCacheEntries|.
+struct PruneCandidate {
+  std::string key;
+  size_t size;
+  PersistentCacheUsage::Entry usage;
+  // Where the entry is stored: either as a file in |directory| or in
+  // |archive|.
+  std::shared_ptr<fml::UniqueFD> directory;
+  std::string file_name;
+  std::shared_ptr<PersistentCacheArchive> archive;
+};
+
+using CacheLocation = std::pair<std::shared_ptr<fml::UniqueFD>,
+                                std::shared_ptr<PersistentCacheArchive>>;
+
+size_t PruneCacheEntries(size_t max_bytes,
+                         const std::vector<CacheLocation>& locations,
+                         PersistentCacheUsage& usage) {
+  TRACE_EVENT0("flutter", "PersistentCache::Prune");
+  const PersistentCacheUsage::Entries entries_usage = usage.GetAll();
+  auto get_usage = [&entries_usage](const std::string& key) {
+    auto found = entries_usage.find(key);
+    return found != entries_usage.end() ? found->second
+                                        : PersistentCacheUsage::Entry{};
+  };
+
+  std::vector<PruneCandidate> candidates;
+  for (const auto& [directory, archive] : locations) {
+    if (archive) {
+      for (auto& [key, size] : archive->ListEntries()) {
+        candidates.push_back({key, size, get_usage(key), nullptr, "", archive});
+      }
+    }
+    if (!directory || !directory->is_valid()) {
+      continue;
+    }
+    fml::VisitFiles(*directory, [&](const fml::UniqueFD&,
+                                    const std::string& file_name) {
+      if (file_name == PersistentCache::kArchiveFileName ||
+          file_name == PersistentCache::kUsageFileName ||
+          fml::IsDirectory(*directory, file_name.c_str())) {
+        return true;
+      }
+      // Files whose names are not keys (e.g. SKP dumps) are not entries.
+      auto [decoded, key] = fml::Base32Decode(file_name);
+      if (!decoded || key.empty()) {
+        return true;
+      }
+      fml::FileMapping mapping(
+          fml::OpenFileReadOnly(*directory, file_name.c_str()));
+      candidates.push_back({key, mapping.GetSize(), get_usage(key), directory,
+                            file_name, nullptr});
+      return true;
+    });
+  }
+
+  size_t total_bytes = 0;
+  for (const auto& candidate : candidates) {
+    total_bytes += candidate.size;
+  }
+  if (total_bytes <= max_bytes) {
+    return 0;
+  }
+
+  // Least recently used first, and least often used among those used at the
+  // same time.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const PruneCandidate& a, const PruneCandidate& b) {
+              return std::tie(a.usage.last_used, a.usage.hits) <
+                     std::tie(b.usage.last_used, b.usage.hits);
+            });
+  size_t removed_count = 0;
+  for (const auto& candidate : candidates) {
+    if (total_bytes <= max_bytes) {
+      break;
+    }
+    const bool removed =
+        candidate.archive
+            ? candidate.archive->Remove(*SkData::MakeWithCopy(
+                  candidate.key.data(), candidate.key.size()))
+            : fml::UnlinkFile(*candidate.directory,
+                              candidate.file_name.c_str());
+    if (removed) {
+      total_bytes -= candidate.size;
+      usage.Remove(candidate.key);
+      removed_count++;
+    }
+  }
+
+  for (const auto& [directory, archive] : locations) {
+    if (archive && archive->NeedsCompaction()) {
+      archive->Compact();
+    }
+  }
+  usage.Save();
+  FML_LOG(INFO) << "Pruned " << removed_count
+                << " entries from the persistent cache.";
+  return removed_count;
+}
+
+}  // namespace
+
+void PersistentCache::Prune(size_t max_bytes) {
+  if (is_read_only_ || !IsValid() || !usage_) {
+    return;
+  }
+  std::vector<CacheLocation> locations = {
+      {cache_directory_, archive_}, {sksl_cache_directory_, sksl_archive_}};
+  RunOnWorker(GetWorkerTaskRunner(),
+              [max_bytes, locations = std::move(locations), usage = usage_]() {
+                PruneCacheEntries(max_bytes, locations, *usage);
+              });
+}
+
+void PersistentCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  stored_bytes_since_prune_ = 0;
+  if (max_bytes > 0) {
+    Prune(max_bytes);
+  }
+}
+
+PersistentCacheUsage::Entry PersistentCache::GetUsage(const SkData& key) const {
+  if (!usage_) {
+    return {};
+  }
+  return usage_->Get(KeyToString(key));
+}
+
+void PersistentCache::RecordUse(const SkData& key) {
+  if (!usage_) {
+    return;
+  }
+  usage_->RecordUse(KeyToString(key), NowInSeconds());
+  auto worker = GetWorkerTaskRunner();
+  // Without a worker the uses are written by a later save.
+  if (worker && usage_->ScheduleSave()) {
+    worker->PostDelayedTask([usage = usage_]() { usage->Save(); },
+                            kUsageSaveDelay);
+  }
+}
+
 namespace {
 
 constexpr char kEngineComponent[] = "flutter_engine";
@@ -156,6 +358,26 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     return std::make_shared<fml::UniqueFD>();
   }
 }
+
+static std::shared_ptr<PersistentCacheUsage> MakeUsage(
+    const std::shared_ptr<fml::UniqueFD>& cache_directory,
+    bool read_only) {
+  if (!cache_directory->is_valid()) {
+    return nullptr;
+  }
+  return std::make_shared<PersistentCacheUsage>(
+      cache_directory, PersistentCache::kUsageFileName, read_only);
+}
+
+static std::shared_ptr<PersistentCacheArchive> MakeArchive(
+    const std::shared_ptr<fml::UniqueFD>& cache_directory,
+    bool read_only) {
+  if (!PersistentCache::use_archive() || !cache_directory->is_valid()) {
+    return nullptr;
+  }
+  return std::make_shared<PersistentCacheArchive>(
+      cache_directory, PersistentCache::kArchiveFileName, read_only);
+}
 }  // namespace
 
 sk_sp<SkData> ParseBase32(const std::string& input) {
@@ -179,33 +401,173 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return SkData::MakeWithCopy(decoder.getData(), decoder.getDataSize());
 }
 
-std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
-  TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
-  std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
-    sk_sp<SkData> key = ParseBase32(filename);
-    sk_sp<SkData> data = LoadFile(directory, filename);
-    if (key != nullptr && data != nullptr) {
-      result.push_back({key, data});
-    } else {
-      FML_LOG(ERROR) << "Failed to load: " << filename;
-    }
-    return true;
+// The number of SkSL files read by each task of |PrefetchSkSLs|.
+static constexpr size_t kSkSLFilesPerPrefetchTask = 16;
+
+/// The state shared by the tasks of |PersistentCache::PrefetchSkSLs|.
+struct PersistentCache::SkSLPrefetch {
+  /// Marks the prefetch as done when destroyed. Every task holds a reference
+  /// to it, so this happens once the last task has either run or been
+  /// dropped by a task runner that is shutting down.
+  struct Completion {
+    explicit Completion(std::shared_ptr<SkSLPrefetch> p)
+        : prefetch(std::move(p)) {}
+    ~Completion() { prefetch->Finish(); }
+
+    const std::shared_ptr<SkSLPrefetch> prefetch;
   };
 
+  std::vector<SkSLCache> archive_sksls;
+  std::vector<std::vector<SkSLCache>> file_sksls;
+  std::atomic_size_t loaded_file_chunks = 0;
+  bool listed_files = false;
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  bool done = false;
+  // Whether every task ran, in which case |sksls| holds all the SkSLs.
+  bool complete = false;
+  std::vector<SkSLCache> sksls;
+
+  void Finish() {
+    std::scoped_lock lock(mutex);
+    complete = listed_files && loaded_file_chunks == file_sksls.size();
+    if (complete) {
+      sksls = std::move(archive_sksls);
+      for (auto& chunk : file_sksls) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(sksls));
+      }
+    }
+    done = true;
+    done_cv.notify_all();
+  }
+};
+
+void PersistentCache::PrefetchSkSLs(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  if (!task_runner || !IsValid()) {
+    return;
+  }
+
+  auto prefetch = std::make_shared<SkSLPrefetch>();
+  {
+    std::scoped_lock lock(sksl_prefetch_mutex_);
+    sksl_prefetch_ = prefetch;
+  }
+
+  auto completion = std::make_shared<SkSLPrefetch::Completion>(prefetch);
+  task_runner->PostTask([completion, task_runner,
+                         cache_directory = cache_directory_,
+                         sksl_archive = sksl_archive_]() {
+    TRACE_EVENT0("flutter", "PersistentCache::PrefetchSkSLs");
+    SkSLPrefetch& prefetch = *completion->prefetch;
+    if (sksl_archive) {
+      prefetch.archive_sksls = sksl_archive->LoadAll();
+    }
+
+    auto directory = std::make_shared<fml::UniqueFD>(
+        fml::OpenDirectoryReadOnly(*cache_directory, kSkSLSubdirName));
+    std::vector<std::string> file_names;
+    if (directory->is_valid()) {
+      fml::VisitFiles(*directory, [&file_names](const fml::UniqueFD& directory,
+                                                const std::string& filename) {
+        if (filename != kArchiveFileName) {
+          file_names.push_back(filename);
+        }
+        return true;
+      });
+    }
+
+    // Each task fills in its own chunk, so they need no synchronization.
+    const size_t chunk_count =
+        (file_names.size() + kSkSLFilesPerPrefetchTask - 1) /
+        kSkSLFilesPerPrefetchTask;
+    prefetch.file_sksls.resize(chunk_count);
+    prefetch.listed_files = true;
+    auto shared_file_names =
+        std::make_shared<std::vector<std::string>>(std::move(file_names));
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+      task_runner->PostTask([completion, directory, chunk,
+                             file_names = shared_file_names]() {
+        TRACE_EVENT0("flutter", "PersistentCache::PrefetchSkSLFiles");
+        SkSLPrefetch& prefetch = *completion->prefetch;
+        const size_t begin = chunk * kSkSLFilesPerPrefetchTask;
+        const size_t end =
+            std::min(begin + kSkSLFilesPerPrefetchTask, file_names->size());
+        for (size_t i = begin; i < end; i++) {
+          LoadSkSLFile(*directory, (*file_names)[i],
+                       prefetch.file_sksls[chunk]);
+        }
+        prefetch.loaded_file_chunks++;
+      });
+    }
+  });
+}
+
+void PersistentCache::LoadSkSLFile(const fml::UniqueFD& directory,
+                                   const std::string& filename,
+                                   std::vector<SkSLCache>& result) {
+  sk_sp<SkData> key = ParseBase32(filename);
+  sk_sp<SkData> data = LoadFile(directory, filename);
+  if (key != nullptr && data != nullptr) {
+    result.push_back({key, data});
+  } else {
+    FML_LOG(ERROR) << "Failed to load: " << filename;
+  }
+}
+
+std::vector<PersistentCache::SkSLCache> PersistentCache::LoadCachedSkSLs()
+    const {
+  std::vector<PersistentCache::SkSLCache> result;
   // Only visit sksl_cache_directory_ if this persistent cache is valid.
-  // However, we'd like to continue visit the asset dir even if this persistent
-  // cache is invalid.
-  if (IsValid()) {
-    // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
-    // opened directory (https://github.com/flutter/flutter/issues/65258).
-    fml::UniqueFD fresh_dir =
-        fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
-    if (fresh_dir.is_valid()) {
-      fml::VisitFiles(fresh_dir, visitor);
+  if (!IsValid()) {
+    return result;
+  }
+
+  if (sksl_archive_) {
+    result = sksl_archive_->LoadAll();
+  }
+  // Entries may also have been stored as separate files before the cache
+  // used an archive.
+  // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
+  // opened directory (https://github.com/flutter/flutter/issues/65258).
+  fml::UniqueFD fresh_dir =
+      fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
+  if (fresh_dir.is_valid()) {
+    fml::VisitFiles(fresh_dir, [&result](const fml::UniqueFD& directory,
+                                         const std::string& filename) {
+      if (filename != kArchiveFileName) {
+        LoadSkSLFile(directory, filename, result);
+      }
+      return true;
+    });
+  }
+  return result;
+}
+
+std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
+  std::shared_ptr<SkSLPrefetch> prefetch;
+  {
+    std::scoped_lock lock(sksl_prefetch_mutex_);
+    prefetch = std::move(sksl_prefetch_);
+  }
+
+  std::vector<PersistentCache::SkSLCache> result;
+  bool prefetched = false;
+  if (prefetch) {
+    TRACE_EVENT0("flutter", "PersistentCache::WaitForSkSLPrefetch");
+    std::unique_lock lock(prefetch->mutex);
+    prefetch->done_cv.wait(lock, [&prefetch] { return prefetch->done; });
+    if (prefetch->complete) {
+      result = std::move(prefetch->sksls);
+      prefetched = true;
     }
   }
+  // The asset dir is visited below even if this persistent cache is invalid.
+  if (!prefetched) {
+    result = LoadCachedSkSLs();
+  }
 
   std::unique_ptr<fml::Mapping> mapping = nullptr;
   if (asset_manager_ != nullptr) {
@@ -237,11 +599,61 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
   return result;
 }
 
+std::vector<PersistentCache::SkSLCache> PersistentCache::LoadHotSkSLs(
+    size_t max_count) {
+  std::vector<SkSLCache> sksls = LoadSkSLs();
+  const PersistentCacheUsage::Entries usage =
+      usage_ ? usage_->GetAll() : PersistentCacheUsage::Entries{};
+  auto get_usage = [&usage](const SkSLCache& sksl) {
+    auto found = usage.find(KeyToString(*sksl.first));
+    return found != usage.end() ? found->second : PersistentCacheUsage::Entry{};
+  };
+  // Most often used first, and most recently used among those used as often.
+  std::stable_sort(sksls.begin(), sksls.end(),
+                   [&get_usage](const SkSLCache& a, const SkSLCache& b) {
+                     const auto a_usage = get_usage(a);
+                     const auto b_usage = get_usage(b);
+                     return std::tie(a_usage.hits, a_usage.last_used) >
+                            std::tie(b_usage.hits, b_usage.last_used);
+                   });
+  if (sksls.size() > max_count) {
+    sksls.resize(max_count);
+  }
+  return sksls;
+}
+
+size_t PersistentCache::PrecompileSkSLs(
+    GrDirectContext* context,
+    const PrecompileProgressCallback& progress_callback) {
+  TRACE_EVENT0("flutter", "PersistentCache::PrecompileSkSLs");
+  // The hottest shaders are compiled first, so that they are ready by the time
+  // the first frames need them even if compiling all of them takes longer.
+  std::vector<SkSLCache> caches =
+      LoadHotSkSLs(std::numeric_limits<size_t>::max());
+  size_t compiled_count = 0;
+  for (size_t i = 0; i < caches.size(); i++) {
+    compiled_count +=
+        context->precompileShader(*caches[i].first, *caches[i].second);
+    FML_TRACE_COUNTER("flutter", "SkSLPrecompile",
+                      reinterpret_cast<int64_t>(this),  //
+                      "Compiled", i + 1, "Total", caches.size());
+    if (progress_callback) {
+      progress_callback(i + 1, caches.size());
+    }
+  }
+  FML_LOG(INFO) << "Found " << caches.size() << " SkSL shaders; precompiled "
+                << compiled_count;
+  return compiled_count;
+}
+
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      archive_(MakeArchive(cache_directory_, read_only)),
+      sksl_archive_(MakeArchive(sksl_cache_directory_, read_only)),
+      usage_(MakeUsage(cache_directory_, read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -273,13 +685,20 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.size() == 0) {
-    return nullptr;
+  sk_sp<SkData> result;
+  if (archive_) {
+    result = archive_->Load(key);
+  }
+  if (result == nullptr) {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.size() == 0) {
+      return nullptr;
+    }
+    result = PersistentCache::LoadFile(*cache_directory_, file_name);
   }
-  auto result = PersistentCache::LoadFile(*cache_directory_, file_name);
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    RecordUse(key);
   }
   return result;
 }
@@ -301,15 +720,28 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
     }
   });
 
-  if (!worker) {
-    FML_LOG(WARNING)
-        << "The persistent cache has no available workers. Performing the task "
-           "on the current thread. This slow operation is going to occur on a "
-           "frame workload.";
-    task();
-  } else {
-    worker->PostTask(std::move(task));
-  }
+  RunOnWorker(std::move(worker), task);
+}
+
+static void PersistentCacheArchiveStore(
+    fml::RefPtr<fml::TaskRunner> worker,
+    std::shared_ptr<PersistentCacheArchive> archive,
+    sk_sp<SkData> key,
+    sk_sp<SkData> value) {
+  auto task = [archive, key = std::move(key), value = std::move(value)]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStore");
+    if (!archive->Store(*key, *value)) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+      return;
+    }
+    // Compacting here keeps the archive from growing without bound as
+    // entries are replaced, while only ever writing it from the worker.
+    if (archive->NeedsCompaction()) {
+      archive->Compact();
+    }
+  };
+
+  RunOnWorker(std::move(worker), task);
 }
 
 // |GrContextOptions::PersistentCache|
@@ -324,6 +756,21 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
+  RecordUse(key);
+
+  if (archive_) {
+    // The SkSL archive is missing if its directory could not be opened.
+    const auto& archive = cache_sksl_ ? sksl_archive_ : archive_;
+    if (!archive || key.size() == 0 || data.size() == 0) {
+      return;
+    }
+    PersistentCacheArchiveStore(GetWorkerTaskRunner(), archive,
+                                SkData::MakeWithCopy(key.data(), key.size()),
+                                SkData::MakeWithCopy(data.data(), data.size()));
+    PruneIfGrown(data.size());
+    return;
+  }
+
   auto file_name = SkKeyToFilePath(key);
 
   if (file_name.size() == 0) {
@@ -340,6 +787,18 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
   PersistentCacheStore(GetWorkerTaskRunner(),
                        cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
                        std::move(file_name), std::move(mapping));
+  PruneIfGrown(data.size());
+}
+
+void PersistentCache::PruneIfGrown(size_t stored_bytes) {
+  const size_t max_bytes = max_bytes_;
+  if (max_bytes == 0 || (stored_bytes_since_prune_ += stored_bytes) <
+                            max_bytes / kPruneGrowthDivisor) {
+    return;
+  }
+  stored_bytes_since_prune_ = 0;
+  // The worker prunes the cache after storing the new entry.
+  Prune(max_bytes);
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
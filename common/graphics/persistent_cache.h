@@ -5,15 +5,22 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_archive.h"
+#include "flutter/common/graphics/persistent_cache_usage.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace testing {
 class ShellTest;
@@ -41,6 +48,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // affect the cache directory returned by |GetCacheForProcess|.
   static void SetCacheDirectoryPath(std::string path);
 
+  // Whether entries are stored in a single archive file per cache directory
+  // (see |PersistentCacheArchive|) instead of one file each. Like
+  // |SetCacheDirectoryPath|, this only affects caches created after it is
+  // called. Entries stored as separate files are still loaded.
+  static void SetUseArchive(bool value);
+
   // Convert a binary SkData key into a Base32 encoded string.
   //
   // This is used to specify persistent cache filenames and service protocol
@@ -66,6 +79,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // Return whether the purge is successful.
   bool Purge();
 
+  // Remove the least recently used entries until the values stored in the
+  // persistent cache directory take up at most |max_bytes|. The entries are
+  // removed on the worker task runner.
+  void Prune(size_t max_bytes);
+
+  // Keep the values stored in the persistent cache directory within
+  // |max_bytes| from now on, pruning it whenever enough new entries were
+  // stored. 0 means no limit.
+  void SetMaxBytes(size_t max_bytes);
+
+  // How often and how recently the entry stored for |key| was used. An entry
+  // is used when Skia loads it or stores it. Skia does not load the SkSLs
+  // it precompiled, so their usage only counts the shaders it compiled while
+  // drawing.
+  PersistentCacheUsage::Entry GetUsage(const SkData& key) const;
+
   // |GrContextOptions::PersistentCache|
   sk_sp<SkData> load(const SkData& key) override;
 
@@ -74,6 +103,28 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   /// Load all the SkSL shader caches in the right directory.
   std::vector<SkSLCache> LoadSkSLs();
 
+  /// Start reading the SkSL shader caches on |task_runner|, spread across its
+  /// workers, so that the next call to |LoadSkSLs| only waits for them instead
+  /// of reading them itself.
+  void PrefetchSkSLs(std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  /// Called with the number of SkSLs compiled so far and the total while
+  /// |PrecompileSkSLs| runs.
+  using PrecompileProgressCallback =
+      std::function<void(size_t /* compiled */, size_t /* total */)>;
+
+  /// Load at most |max_count| SkSLs, preferring those that were used most
+  /// often. This is the set of shaders worth bundling with an application.
+  std::vector<SkSLCache> LoadHotSkSLs(size_t max_count);
+
+  /// Compile the SkSLs returned by |LoadSkSLs| into |context| ahead of their
+  /// first use, in the order of |LoadHotSkSLs|, reporting the progress to
+  /// |progress_callback| if it is set. Returns the number of shaders that were
+  /// compiled.
+  size_t PrecompileSkSLs(
+      GrDirectContext* context,
+      const PrecompileProgressCallback& progress_callback = nullptr);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -82,15 +133,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static void SetAssetManager(std::shared_ptr<AssetManager> value);
 
   static bool cache_sksl() { return cache_sksl_; }
+  static bool use_archive() { return use_archive_; }
   static void SetCacheSkSL(bool value);
   static void MarkStrategySet() { strategy_set_ = true; }
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kArchiveFileName[] = "io.flutter.cache.archive";
+  static constexpr char kUsageFileName[] = "io.flutter.cache.usage";
 
  private:
+  struct SkSLPrefetch;
+
   static std::string cache_base_path_;
 
+  static bool use_archive_;
+
   static std::shared_ptr<AssetManager> asset_manager_;
 
   static std::mutex instance_mutex_;
@@ -109,8 +167,16 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  // Only set if the cache uses archives.
+  const std::shared_ptr<PersistentCacheArchive> archive_;
+  const std::shared_ptr<PersistentCacheArchive> sksl_archive_;
+  const std::shared_ptr<PersistentCacheUsage> usage_;
+  std::atomic_size_t max_bytes_ = 0;
+  std::atomic_size_t stored_bytes_since_prune_ = 0;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
+  std::mutex sksl_prefetch_mutex_;
+  std::shared_ptr<SkSLPrefetch> sksl_prefetch_;
 
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
@@ -118,8 +184,23 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static sk_sp<SkData> LoadFile(const fml::UniqueFD& dir,
                                 const std::string& filen_ame);
 
+  // Appends the SkSL stored in |filename| to |result|.
+  static void LoadSkSLFile(const fml::UniqueFD& directory,
+                           const std::string& filename,
+                           std::vector<SkSLCache>& result);
+
   bool IsValid() const;
 
+  void RecordUse(const SkData& key);
+
+  // Prunes the cache once the entries stored since it was last pruned take up
+  // a fraction of |max_bytes_|.
+  void PruneIfGrown(size_t stored_bytes);
+
+  /// Load the SkSLs stored in the cache directory, but not those of the
+  /// asset manager.
+  std::vector<SkSLCache> LoadCachedSkSLs() const;
+
   PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
@@ -0,0 +1,376 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_archive.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// "FLPC" in little endian.
+constexpr uint32_t kArchiveMagic = 0x43504c46;
+
+// Compacting rewrites the whole archive, so it is only done once the stale
+// records are both a large part of the file and worth the write.
+constexpr size_t kMinCompactionBytes = 64 * 1024;
+
+struct ArchiveHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+// Followed by |key_size| bytes of key and |data_size| bytes of value.
+struct RecordHeader {
+  uint32_t key_size;
+  uint32_t data_size;
+  uint32_t checksum;
+};
+
+// 32-bit FNV-1a of the key followed by the value.
+uint32_t Checksum(const uint8_t* key,
+                  size_t key_size,
+                  const uint8_t* data,
+                  size_t data_size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < key_size; i++) {
+    hash = (hash ^ key[i]) * 16777619u;
+  }
+  for (size_t i = 0; i < data_size; i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+PersistentCacheArchive::PersistentCacheArchive(
+    std::shared_ptr<fml::UniqueFD> directory,
+    std::string file_name,
+    bool read_only)
+    : directory_(std::move(directory)),
+      file_name_(std::move(file_name)),
+      read_only_(read_only) {
+  std::scoped_lock lock(mutex_);
+  Open();
+}
+
+PersistentCacheArchive::~PersistentCacheArchive() = default;
+
+bool PersistentCacheArchive::IsValid() const {
+  std::scoped_lock lock(mutex_);
+  return file_.is_valid();
+}
+
+bool PersistentCacheArchive::Open() {
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Open");
+  mapping_.reset();
+  index_.clear();
+  file_size_ = 0;
+  stale_bytes_ = 0;
+
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  file_ = fml::OpenFile(*directory_, file_name_.c_str(), !read_only_,
+                        read_only_ ? fml::FilePermission::kRead
+                                   : fml::FilePermission::kReadWrite);
+  if (!file_.is_valid()) {
+    return false;
+  }
+  mapping_ = std::make_unique<fml::FileMapping>(file_);
+  Index();
+
+  if (file_size_ == 0 && !read_only_) {
+    const ArchiveHeader header = {kArchiveMagic, kVersion};
+    if (!WriteAt(0, {{&header, sizeof(header)}})) {
+      FML_LOG(WARNING) << "Could not initialize the persistent cache archive.";
+      file_.reset();
+      return false;
+    }
+    file_size_ = sizeof(header);
+  }
+  return true;
+}
+
+void PersistentCacheArchive::Index() {
+  if (!mapping_ || !mapping_->IsValid() ||
+      mapping_->GetSize() < sizeof(ArchiveHeader)) {
+    return;
+  }
+  const uint8_t* bytes = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+
+  ArchiveHeader header;
+  memcpy(&header, bytes, sizeof(header));
+  if (header.magic != kArchiveMagic || header.version != kVersion) {
+    FML_LOG(INFO) << "Ignoring persistent cache archive with an unknown "
+                     "format version.";
+    return;
+  }
+
+  size_t offset = sizeof(header);
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader record_header;
+    memcpy(&record_header, bytes + offset, sizeof(record_header));
+    const size_t available = size - offset - sizeof(record_header);
+    if (record_header.key_size == 0 || record_header.key_size > available ||
+        record_header.data_size > available - record_header.key_size) {
+      break;
+    }
+    const uint8_t* key = bytes + offset + sizeof(record_header);
+    const uint8_t* data = key + record_header.key_size;
+    if (Checksum(key, record_header.key_size, data, record_header.data_size) !=
+        record_header.checksum) {
+      FML_LOG(WARNING) << "Persistent cache archive has a corrupt record. "
+                          "Ignoring it and the records that follow.";
+      break;
+    }
+
+    const Record record = {offset + sizeof(record_header),
+                           record_header.key_size, record_header.data_size};
+    Insert(std::string(reinterpret_cast<const char*>(key), record.key_size),
+           record);
+    offset = record.offset + record.key_size + record.data_size;
+  }
+  file_size_ = offset;
+}
+
+bool PersistentCacheArchive::WriteAt(
+    size_t offset,
+    std::initializer_list<std::pair<const void*, size_t>> chunks) {
+  size_t size = offset;
+  for (const auto& chunk : chunks) {
+    size += chunk.second;
+  }
+
+  // Not all platforms can resize a file that is mapped.
+  mapping_.reset();
+  bool written = false;
+  if (fml::TruncateFile(file_, size)) {
+    fml::FileMapping writable(file_, {fml::FileMapping::Protection::kRead,
+                                      fml::FileMapping::Protection::kWrite});
+    uint8_t* destination = writable.GetMutableMapping();
+    if (destination != nullptr && writable.GetSize() == size) {
+      for (const auto& chunk : chunks) {
+        memcpy(destination + offset, chunk.first, chunk.second);
+        offset += chunk.second;
+      }
+      written = true;
+    }
+  }
+  mapping_ = std::make_unique<fml::FileMapping>(file_);
+  return written;
+}
+
+const uint8_t* PersistentCacheArchive::RecordData(const Record& record) const {
+  if (!mapping_ || mapping_->GetMapping() == nullptr ||
+      record.offset + record.key_size + record.data_size >
+          mapping_->GetSize()) {
+    return nullptr;
+  }
+  return mapping_->GetMapping() + record.offset + record.key_size;
+}
+
+sk_sp<SkData> PersistentCacheArchive::Load(const SkData& key) const {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(
+      std::string(reinterpret_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end() || found->second.data_size == 0) {
+    return nullptr;
+  }
+  const uint8_t* data = RecordData(found->second);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return SkData::MakeWithCopy(data, found->second.data_size);
+}
+
+std::vector<PersistentCacheArchive::Entry> PersistentCacheArchive::LoadAll()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(index_.size());
+  for (const auto& [key, record] : index_) {
+    const uint8_t* data = RecordData(record);
+    if (data == nullptr || record.data_size == 0) {
+      continue;
+    }
+    entries.emplace_back(SkData::MakeWithCopy(key.data(), key.size()),
+                         SkData::MakeWithCopy(data, record.data_size));
+  }
+  return entries;
+}
+
+static size_t RecordBytes(uint32_t key_size, uint32_t data_size) {
+  return sizeof(RecordHeader) + key_size + data_size;
+}
+
+void PersistentCacheArchive::Insert(std::string key, const Record& record) {
+  auto [found, inserted] = index_.try_emplace(std::move(key), record);
+  if (!inserted) {
+    // A removal record is already counted as stale.
+    if (found->second.data_size > 0) {
+      stale_bytes_ +=
+          RecordBytes(found->second.key_size, found->second.data_size);
+    }
+    found->second = record;
+  }
+  if (record.data_size == 0) {
+    stale_bytes_ += RecordBytes(record.key_size, 0);
+  }
+}
+
+bool PersistentCacheArchive::Append(const std::string& key,
+                                    const SkData& data) {
+  const RecordHeader header = {
+      static_cast<uint32_t>(key.size()), static_cast<uint32_t>(data.size()),
+      Checksum(reinterpret_cast<const uint8_t*>(key.data()), key.size(),
+               data.bytes(), data.size())};
+  const size_t offset = file_size_;
+  if (!WriteAt(offset, {{&header, sizeof(header)},
+                        {key.data(), key.size()},
+                        {data.data(), data.size()}})) {
+    // Anything written past |file_size_| is overwritten by the next append.
+    return false;
+  }
+
+  const Record record = {offset + sizeof(header), header.key_size,
+                         header.data_size};
+  file_size_ = record.offset + record.key_size + record.data_size;
+  Insert(key, record);
+  return true;
+}
+
+bool PersistentCacheArchive::Store(const SkData& key, const SkData& data) {
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid() || key.size() == 0 || data.size() == 0) {
+    return false;
+  }
+
+  std::string key_string(reinterpret_cast<const char*>(key.data()),
+                         key.size());
+  auto found = index_.find(key_string);
+  if (found != index_.end() && found->second.data_size == data.size()) {
+    const uint8_t* existing = RecordData(found->second);
+    if (existing != nullptr &&
+        memcmp(existing, data.data(), data.size()) == 0) {
+      return true;
+    }
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Store");
+  return Append(key_string, data);
+}
+
+bool PersistentCacheArchive::Remove(const SkData& key) {
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid()) {
+    return false;
+  }
+  std::string key_string(reinterpret_cast<const char*>(key.data()),
+                         key.size());
+  auto found = index_.find(key_string);
+  if (found == index_.end() || found->second.data_size == 0) {
+    return true;
+  }
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Remove");
+  sk_sp<SkData> empty = SkData::MakeEmpty();
+  return Append(key_string, *empty);
+}
+
+std::vector<std::pair<std::string, size_t>>
+PersistentCacheArchive::ListEntries() const {
+  std::scoped_lock lock(mutex_);
+  std::vector<std::pair<std::string, size_t>> entries;
+  entries.reserve(index_.size());
+  for (const auto& [key, record] : index_) {
+    if (record.data_size > 0) {
+      entries.emplace_back(key, record.data_size);
+    }
+  }
+  return entries;
+}
+
+bool PersistentCacheArchive::NeedsCompaction() const {
+  std::scoped_lock lock(mutex_);
+  return stale_bytes_ >= kMinCompactionBytes && stale_bytes_ * 2 >= file_size_;
+}
+
+bool PersistentCacheArchive::Compact() {
+  TRACE_EVENT0("flutter", "PersistentCacheArchive::Compact");
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid() || !mapping_) {
+    return false;
+  }
+
+  std::vector<uint8_t> contents;
+  contents.reserve(file_size_ - stale_bytes_);
+  const ArchiveHeader header = {kArchiveMagic, kVersion};
+  const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(&header);
+  contents.insert(contents.end(), header_bytes, header_bytes + sizeof(header));
+  for (const auto& [key, record] : index_) {
+    // Records are copied whole, along with their header. Removed entries are
+    // dropped.
+    const uint8_t* data = RecordData(record);
+    if (data == nullptr || record.data_size == 0) {
+      continue;
+    }
+    const uint8_t* begin =
+        mapping_->GetMapping() + record.offset - sizeof(RecordHeader);
+    contents.insert(contents.end(), begin, data + record.data_size);
+  }
+
+  // The file is replaced rather than rewritten in place so that a failure
+  // leaves the previous archive intact.
+  mapping_.reset();
+  file_.reset();
+  const bool written = fml::WriteAtomically(
+      *directory_, file_name_.c_str(), fml::DataMapping(std::move(contents)));
+  if (!written) {
+    FML_LOG(WARNING) << "Could not compact the persistent cache archive.";
+  }
+  return Open() && written;
+}
+
+bool PersistentCacheArchive::Clear() {
+  std::scoped_lock lock(mutex_);
+  if (read_only_) {
+    return false;
+  }
+  // The file may already have been removed along with the rest of the cache,
+  // in which case the descriptor refers to an unlinked file.
+  mapping_.reset();
+  file_.reset();
+  if (directory_ && directory_->is_valid()) {
+    fml::UnlinkFile(*directory_, file_name_.c_str());
+  }
+  return Open();
+}
+
+size_t PersistentCacheArchive::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& [key, record] : index_) {
+    count += record.data_size > 0;
+  }
+  return count;
+}
+
+size_t PersistentCacheArchive::GetFileSize() const {
+  std::scoped_lock lock(mutex_);
+  return file_size_;
+}
+
+size_t PersistentCacheArchive::GetStaleBytes() const {
+  std::scoped_lock lock(mutex_);
+  return stale_bytes_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
+
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+/// A set of key/value pairs stored in a single file, used by the
+/// |PersistentCache| in place of one file per entry.
+///
+/// The file starts with a versioned header followed by records, each holding
+/// a key, its value and a checksum of both. New values are appended to the
+/// end of the file; a value stored for an existing key makes the record
+/// holding the old value stale. The file is mapped into memory when it is
+/// opened and indexed by walking the records, so loading all of its entries
+/// costs a single open and mmap. A record whose checksum does not match
+/// (e.g. because the process died while appending it) ends the archive, and
+/// is overwritten by the next append.
+///
+/// Removing an entry appends a record with an empty value.
+///
+/// All methods are thread-safe. Writes are expected to happen on a single
+/// worker thread.
+class PersistentCacheArchive {
+ public:
+  using Entry = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
+
+  static constexpr uint32_t kVersion = 1;
+
+  /// Opens the archive named |file_name| in |directory|, creating it unless
+  /// |read_only| is set. An archive written with another version of the
+  /// format is treated as empty, and replaced on the first write.
+  PersistentCacheArchive(std::shared_ptr<fml::UniqueFD> directory,
+                         std::string file_name,
+                         bool read_only);
+
+  ~PersistentCacheArchive();
+
+  bool IsValid() const;
+
+  const std::string& GetFileName() const { return file_name_; }
+
+  /// Returns a copy of the value stored for |key|, or nullptr.
+  sk_sp<SkData> Load(const SkData& key) const;
+
+  /// Returns copies of all the entries of the archive.
+  std::vector<Entry> LoadAll() const;
+
+  /// Appends |data| as the value of |key|. Does nothing if |key| already
+  /// holds the same value.
+  bool Store(const SkData& key, const SkData& data);
+
+  /// Removes the value stored for |key|, if any.
+  bool Remove(const SkData& key);
+
+  /// The key bytes and value size of every entry of the archive.
+  std::vector<std::pair<std::string, size_t>> ListEntries() const;
+
+  /// Whether stale records take up enough of the file for |Compact| to be
+  /// worth its cost.
+  bool NeedsCompaction() const;
+
+  /// Rewrites the archive with only the latest value of every key.
+  bool Compact();
+
+  /// Removes all the entries of the archive.
+  bool Clear();
+
+  size_t GetEntryCount() const;
+
+  /// The size of the valid part of the file, including stale records.
+  size_t GetFileSize() const;
+
+  /// The size of the records holding values that were replaced or removed
+  /// since the archive was last compacted.
+  size_t GetStaleBytes() const;
+
+ private:
+  struct Record {
+    size_t offset;
+    uint32_t key_size;
+    uint32_t data_size;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const std::string file_name_;
+  const bool read_only_;
+  mutable std::mutex mutex_;
+  fml::UniqueFD file_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // Maps the key bytes to the latest record holding a value for them.
+  std::unordered_map<std::string, Record> index_;
+  size_t file_size_ = 0;
+  size_t stale_bytes_ = 0;
+
+  bool Open();
+
+  // Appends a record holding |data| as the value of |key|. An empty |data|
+  // removes the entry.
+  bool Append(const std::string& key, const SkData& data);
+
+  // Updates the index after |record| was read or appended for |key|.
+  void Insert(std::string key, const Record& record);
+
+  void Index();
+
+  // Writes |chunks| one after the other at |offset|, and resizes the file to
+  // end with them.
+  bool WriteAt(size_t offset,
+               std::initializer_list<std::pair<const void*, size_t>> chunks);
+
+  const uint8_t* RecordData(const Record& record) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCacheArchive);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_ARCHIVE_H_
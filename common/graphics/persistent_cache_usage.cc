@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_usage.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// "FLPU" in little endian.
+constexpr uint32_t kUsageMagic = 0x55504c46;
+
+struct UsageHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+// Followed by |key_size| bytes of key.
+struct UsageRecord {
+  uint32_t key_size;
+  uint32_t hits;
+  int64_t last_used;
+};
+
+}  // namespace
+
+PersistentCacheUsage::PersistentCacheUsage(
+    std::shared_ptr<fml::UniqueFD> directory,
+    std::string file_name,
+    bool read_only)
+    : directory_(std::move(directory)),
+      file_name_(std::move(file_name)),
+      read_only_(read_only) {
+  std::scoped_lock lock(mutex_);
+  Read();
+}
+
+PersistentCacheUsage::~PersistentCacheUsage() = default;
+
+void PersistentCacheUsage::Read() {
+  TRACE_EVENT0("flutter", "PersistentCacheUsage::Read");
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  auto file = fml::OpenFileReadOnly(*directory_, file_name_.c_str());
+  if (!file.is_valid()) {
+    return;
+  }
+  fml::FileMapping mapping(file);
+  const uint8_t* bytes = mapping.GetMapping();
+  const size_t size = mapping.GetSize();
+  if (bytes == nullptr || size < sizeof(UsageHeader)) {
+    return;
+  }
+
+  UsageHeader header;
+  memcpy(&header, bytes, sizeof(header));
+  if (header.magic != kUsageMagic || header.version != kVersion) {
+    FML_LOG(INFO) << "Ignoring persistent cache usage with an unknown format "
+                     "version.";
+    return;
+  }
+
+  size_t offset = sizeof(header);
+  while (size - offset >= sizeof(UsageRecord)) {
+    UsageRecord record;
+    memcpy(&record, bytes + offset, sizeof(record));
+    offset += sizeof(record);
+    if (record.key_size == 0 || record.key_size > size - offset) {
+      break;
+    }
+    entries_[std::string(reinterpret_cast<const char*>(bytes + offset),
+                         record.key_size)] = {record.hits, record.last_used};
+    offset += record.key_size;
+  }
+}
+
+void PersistentCacheUsage::RecordUse(const std::string& key, int64_t now) {
+  if (key.empty()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  Entry& entry = entries_[key];
+  entry.hits++;
+  entry.last_used = std::max(entry.last_used, now);
+  dirty_ = true;
+}
+
+void PersistentCacheUsage::Remove(const std::string& key) {
+  std::scoped_lock lock(mutex_);
+  if (entries_.erase(key) > 0) {
+    dirty_ = true;
+  }
+}
+
+void PersistentCacheUsage::Clear() {
+  std::scoped_lock lock(mutex_);
+  dirty_ = dirty_ || !entries_.empty();
+  entries_.clear();
+}
+
+PersistentCacheUsage::Entry PersistentCacheUsage::Get(
+    const std::string& key) const {
+  std::scoped_lock lock(mutex_);
+  auto found = entries_.find(key);
+  return found != entries_.end() ? found->second : Entry{};
+}
+
+PersistentCacheUsage::Entries PersistentCacheUsage::GetAll() const {
+  std::scoped_lock lock(mutex_);
+  return entries_;
+}
+
+bool PersistentCacheUsage::ScheduleSave() {
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || save_scheduled_) {
+    return false;
+  }
+  save_scheduled_ = true;
+  return true;
+}
+
+bool PersistentCacheUsage::Save() {
+  std::vector<uint8_t> contents;
+  {
+    std::scoped_lock lock(mutex_);
+    save_scheduled_ = false;
+    if (read_only_ || !dirty_) {
+      return !read_only_;
+    }
+    if (!directory_ || !directory_->is_valid()) {
+      return false;
+    }
+    const UsageHeader header = {kUsageMagic, kVersion};
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(&header);
+    contents.insert(contents.end(), header_bytes,
+                    header_bytes + sizeof(header));
+    for (const auto& [key, entry] : entries_) {
+      const UsageRecord record = {static_cast<uint32_t>(key.size()),
+                                  entry.hits, entry.last_used};
+      const uint8_t* record_bytes = reinterpret_cast<const uint8_t*>(&record);
+      contents.insert(contents.end(), record_bytes,
+                      record_bytes + sizeof(record));
+      contents.insert(contents.end(), key.begin(), key.end());
+    }
+    dirty_ = false;
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCacheUsage::Save");
+  if (!fml::WriteAtomically(*directory_, file_name_.c_str(),
+                            fml::DataMapping(std::move(contents)))) {
+    FML_LOG(WARNING) << "Could not write the persistent cache usage.";
+    std::scoped_lock lock(mutex_);
+    dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
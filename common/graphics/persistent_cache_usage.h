@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_USAGE_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_USAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+/// How often and how recently the entries of a |PersistentCache| were used.
+///
+/// The usage of all the entries is kept in memory and written to a single file
+/// next to them by |Save|, so recording a use does not touch the disk. Entries
+/// are identified by their key bytes.
+///
+/// All methods are thread-safe.
+class PersistentCacheUsage {
+ public:
+  struct Entry {
+    uint32_t hits = 0;
+    /// Seconds since the epoch.
+    int64_t last_used = 0;
+  };
+
+  using Entries = std::unordered_map<std::string, Entry>;
+
+  static constexpr uint32_t kVersion = 1;
+
+  /// Reads the usage stored in the file named |file_name| in |directory|, if
+  /// any. A file written with another version of the format is ignored.
+  PersistentCacheUsage(std::shared_ptr<fml::UniqueFD> directory,
+                       std::string file_name,
+                       bool read_only);
+
+  ~PersistentCacheUsage();
+
+  /// Records a use of the entry stored for |key| at |now|, in seconds since
+  /// the epoch.
+  void RecordUse(const std::string& key, int64_t now);
+
+  /// Forgets the usage of the entry stored for |key|.
+  void Remove(const std::string& key);
+
+  /// Forgets the usage of all entries.
+  void Clear();
+
+  Entry Get(const std::string& key) const;
+
+  Entries GetAll() const;
+
+  /// Returns true unless a save is already scheduled, in which case the caller
+  /// does not need to schedule another one.
+  bool ScheduleSave();
+
+  /// Writes the usage to the file if it changed since it was last written.
+  bool Save();
+
+ private:
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const std::string file_name_;
+  const bool read_only_;
+  mutable std::mutex mutex_;
+  Entries entries_;
+  bool dirty_ = false;
+  bool save_scheduled_ = false;
+
+  void Read();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCacheUsage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_USAGE_H_
@@ -62,6 +62,40 @@ std::string Settings::ToString() const {
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
+  stream << "raster_cache_max_bytes: " << raster_cache_max_bytes << std::endl;
+  stream << "raster_cache_max_unused_frames: "
+         << raster_cache_max_unused_frames << std::endl;
+  stream << "enable_async_raster_cache: " << enable_async_raster_cache
+         << std::endl;
+  stream << "enable_work_stealing_workers: " << enable_work_stealing_workers
+         << std::endl;
+  stream << "pin_worker_threads: " << pin_worker_threads << std::endl;
+  stream << "text_layout_cache_max_bytes: " << text_layout_cache_max_bytes
+         << std::endl;
+  stream << "frame_pacing_mode: " << static_cast<int>(frame_pacing_mode)
+         << std::endl;
+  stream << "frame_pipeline_depth: " << frame_pipeline_depth << std::endl;
+  stream << "use_persistent_cache_archive: " << use_persistent_cache_archive
+         << std::endl;
+  stream << "parallel_sksl_precompile: " << parallel_sksl_precompile
+         << std::endl;
+  stream << "persistent_cache_max_bytes: " << persistent_cache_max_bytes
+         << std::endl;
+  stream << "max_concurrent_image_decodes: " << max_concurrent_image_decodes
+         << std::endl;
+  stream << "animated_image_lookahead_frames: "
+         << animated_image_lookahead_frames << std::endl;
+  stream << "animated_image_cache_max_bytes: " << animated_image_cache_max_bytes
+         << std::endl;
+  stream << "batch_platform_messages: " << batch_platform_messages << std::endl;
+  stream << "pointer_data_coalescing_mode: "
+         << static_cast<int>(pointer_data_coalescing_mode) << std::endl;
+  stream << "pointer_resampling_delay_us: " << pointer_resampling_delay_us
+         << std::endl;
+  stream << "compact_pointer_data_packets: " << compact_pointer_data_packets
+         << std::endl;
+  stream << "font_fallback_cache_path: " << font_fallback_cache_path
+         << std::endl;
   return stream.str();
 }
 
@@ -21,6 +21,40 @@
 
 namespace flutter {
 
+/// How frames produced on the UI thread are handed to the raster thread.
+enum class FramePacingMode {
+  /// Every frame is rasterized, in the order it was produced. The UI thread
+  /// skips vsyncs once the pipeline holds as many frames as its depth,
+  /// counting the frame being rasterized.
+  kFifo,
+
+  /// At most one frame waits to be rasterized. A newer frame replaces it
+  /// instead of waiting behind it, so the UI thread never waits for the
+  /// raster thread and the latest frame is always the one rasterized next.
+  kMailbox,
+
+  /// At most one frame waits to be rasterized, but the frame being rasterized
+  /// does not count towards it: the UI thread can build frame N+1 as soon as
+  /// the raster thread starts on frame N, even when the pipeline depth would
+  /// otherwise be one.
+  kLowLatency,
+};
+
+/// How the pointer data packets received from the platform are dispatched to
+/// the framework.
+enum class PointerDataCoalescingMode {
+  /// With the dispatcher chosen by the platform view.
+  kNone,
+
+  /// The consecutive move and hover events of each device are merged into a
+  /// single event per frame. See |CoalescingPointerDataDispatcher|.
+  kCoalesce,
+
+  /// Like |kCoalesce|, but the events are dispatched at vsync, with the
+  /// pointer positions resampled at a fixed delay behind it.
+  kResample,
+};
+
 class FrameTiming {
  public:
   enum Phase {
@@ -235,6 +269,100 @@ struct Settings {
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t old_gen_heap_size = -1;
 
+  /// Max size in bytes of the images held by the raster cache, or 0 for no
+  /// limit. Once a frame leaves the cache above this size, the entries that
+  /// were used least recently are evicted first.
+  size_t raster_cache_max_bytes = 0;
+
+  /// The number of frames an entry of the raster cache is kept for after the
+  /// last frame that used it. Keeping entries around for a few frames lets
+  /// content that scrolls back into view reuse its cached image. 0 evicts
+  /// entries after the first frame that does not use them, which was the
+  /// behavior before this setting existed.
+  size_t raster_cache_max_unused_frames = 3;
+
+  /// Whether pictures are rasterized into the raster cache on the concurrent
+  /// worker threads instead of the raster thread. Pictures become available
+  /// in the cache a frame or more later and are drawn directly until then.
+  bool enable_async_raster_cache = false;
+
+  /// Whether each concurrent worker thread has a task queue of its own and
+  /// steals tasks from the other workers when it runs out of work, instead of
+  /// all workers sharing a single queue.
+  bool enable_work_stealing_workers = false;
+
+  /// Whether each concurrent worker thread is bound to a single CPU. Only
+  /// supported on Linux and Android.
+  bool pin_worker_threads = false;
+
+  /// Max size in bytes of the cache of shaped words shared by all paragraph
+  /// layouts, or 0 for the default size.
+  size_t text_layout_cache_max_bytes = 0;
+
+  /// How frames are handed from the UI thread to the raster thread.
+  FramePacingMode frame_pacing_mode = FramePacingMode::kFifo;
+
+  /// The number of frames the pipeline holds in the |FramePacingMode::kFifo|
+  /// mode, or 0 for the default of 2 (1 when the platform and raster task
+  /// runners are the same).
+  uint32_t frame_pipeline_depth = 0;
+
+  /// Whether the persistent cache stores its entries in a single archive file
+  /// per cache directory instead of one file per entry.
+  bool use_persistent_cache_archive = false;
+
+  /// Whether the SkSLs of the persistent cache are read and decoded on the
+  /// concurrent workers during startup instead of on the raster thread when
+  /// the surface is created.
+  bool parallel_sksl_precompile = false;
+
+  /// Max size in bytes of the values stored in the persistent cache
+  /// directory. The least recently used entries are removed when it grows
+  /// past this size. 0 means no limit.
+  size_t persistent_cache_max_bytes = 0;
+
+  /// Called on the raster thread with the number of SkSLs compiled so far and
+  /// the total number of SkSLs while they are precompiled.
+  std::function<void(size_t /* compiled */, size_t /* total */)>
+      sksl_precompile_progress_callback;
+
+  /// The max number of images an engine decodes at the same time on the
+  /// concurrent workers, or 0 for the default of 4. Further decodes wait in a
+  /// queue where they can be cancelled before they start.
+  uint32_t max_concurrent_image_decodes = 0;
+
+  /// The number of frames of an animated image decoded on the concurrent
+  /// workers ahead of being shown.
+  uint32_t animated_image_lookahead_frames = 0;
+
+  /// Max size in bytes of the decoded frames an animated image keeps to play
+  /// its loop again without decoding it. 0 disables the cache.
+  size_t animated_image_cache_max_bytes = 0;
+
+  /// Whether the platform messages that arrive while the UI task runner is
+  /// busy are queued and delivered to the root isolate in a single call. The
+  /// messages keep the order in which they were sent, but may be delivered
+  /// ahead of other platform events that were sent after the first of them.
+  bool batch_platform_messages = false;
+
+  PointerDataCoalescingMode pointer_data_coalescing_mode =
+      PointerDataCoalescingMode::kNone;
+
+  /// How far behind the vsync the pointer positions are sampled in the
+  /// |PointerDataCoalescingMode::kResample| mode, in microseconds.
+  int64_t pointer_resampling_delay_us = 16000;
+
+  /// Whether pointer data packets are sent to the framework in the compact
+  /// |PointerDataPacket::Encoding::kCompact| encoding instead of as an array
+  /// of |PointerData|.
+  bool compact_pointer_data_packets = false;
+
+  /// Directory holding a snapshot of the fallback fonts matched for code
+  /// points, which is shared by all the engines of the process. When set, the
+  /// snapshot is loaded when an engine starts and updated while the engine is
+  /// idle.
+  std::string font_fallback_cache_path;
+
   /// A timestamp representing when the engine started. The value is based
   /// on the clock used by the Dart timeline APIs. This timestamp is used
   /// to log a timeline event that tracks the latency of engine startup.
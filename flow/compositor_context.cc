@@ -5,6 +5,7 @@
 #include "flutter/flow/compositor_context.h"
 
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
@@ -85,6 +86,19 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (post_preroll_result == PostPrerollResult::kSkipAndRetryFrame) {
     return RasterStatus::kSkipAndRetry;
   }
+
+  std::optional<SkIRect> clip_rect = ComputeClipRect();
+  if (canvas() && clip_rect) {
+    // The clip is specified in surface coordinates, which is what the damage
+    // was computed in, so it is applied without the root surface
+    // transformation.
+    canvas()->save();
+    const SkMatrix matrix = canvas()->getTotalMatrix();
+    canvas()->resetMatrix();
+    canvas()->clipRect(SkRect::Make(*clip_rect));
+    canvas()->setMatrix(matrix);
+  }
+
   // Clearing canvas after preroll reduces one render target switch when preroll
   // paints some raster cache.
   if (canvas()) {
@@ -101,9 +115,45 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (canvas() && needs_save_layer) {
     canvas()->restore();
   }
+  if (canvas() && clip_rect) {
+    canvas()->restore();
+  }
   return RasterStatus::kSuccess;
 }
 
+std::optional<SkIRect> CompositorContext::ScopedFrame::ComputeClipRect() {
+  if (!frame_damage_ || !frame_damage_->current_frame) {
+    return std::nullopt;
+  }
+
+  DamageContext* current_frame = frame_damage_->current_frame;
+  const SkIRect frame_damage =
+      current_frame->ComputeDamage(frame_damage_->previous_frame);
+  frame_damage_->frame_damage = frame_damage;
+
+  // Without knowledge of the buffer content everything has to be repainted.
+  if (!frame_damage_->existing_damage) {
+    frame_damage_->buffer_damage = current_frame->surface_bounds();
+    return std::nullopt;
+  }
+
+  SkIRect buffer_damage = frame_damage;
+  buffer_damage.join(*frame_damage_->existing_damage);
+  if (!buffer_damage.intersect(current_frame->surface_bounds())) {
+    buffer_damage.setEmpty();
+  }
+  frame_damage_->buffer_damage = buffer_damage;
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "PartialRepaint",
+                    reinterpret_cast<int64_t>(&context_), "RepaintedPixels",
+                    buffer_damage.width() * buffer_damage.height(),
+                    "SurfacePixels",
+                    current_frame->surface_bounds().width() *
+                        current_frame->surface_bounds().height());
+#endif  // !FLUTTER_RELEASE
+  return buffer_damage;
+}
+
 void CompositorContext::OnGrContextCreated() {
   texture_registry_.OnGrContextCreated();
   raster_cache_.Clear();
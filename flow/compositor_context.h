@@ -6,9 +6,11 @@
 #define FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/flow/damage_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
@@ -79,6 +81,18 @@ class CompositorContext {
 
     GrDirectContext* gr_context() const { return gr_context_; }
 
+    // Enables partial repaint for this frame. The layer tree records its
+    // paint regions into |frame_damage->current_frame| during Preroll and
+    // only the area that differs from |frame_damage->previous_frame| (plus
+    // the existing damage of the target buffer) is repainted. The computed
+    // damage is written back to |frame_damage|, which must outlive the call
+    // to Raster().
+    void set_frame_damage(FrameDamage* frame_damage) {
+      frame_damage_ = frame_damage;
+    }
+
+    FrameDamage* frame_damage() const { return frame_damage_; }
+
     virtual RasterStatus Raster(LayerTree& layer_tree,
                                 bool ignore_raster_cache);
 
@@ -91,6 +105,11 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    FrameDamage* frame_damage_ = nullptr;
+
+    // Computes the damage of the frame and returns the area of the canvas
+    // that has to be repainted, or std::nullopt to repaint everything.
+    std::optional<SkIRect> ComputeClipRect();
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
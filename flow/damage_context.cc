@@ -0,0 +1,228 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_context.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// A region painted in both frames.
+struct MatchedRegion {
+  size_t current_index;
+  size_t previous_index;
+  SkRect bounds;
+};
+
+// Returns whether each of the |regions|, which are sorted by their index in
+// the current frame, is part of a longest run that was painted in the same
+// order in the previous frame. Any two regions whose order changed cannot both
+// be part of that run.
+std::vector<bool> FindRegionsInOrder(
+    const std::vector<MatchedRegion>& regions) {
+  constexpr size_t kNone = static_cast<size_t>(-1);
+  // |tails[k]| is the region ending the best increasing run of length k + 1.
+  std::vector<size_t> tails;
+  std::vector<size_t> predecessors(regions.size(), kNone);
+  for (size_t i = 0; i < regions.size(); i++) {
+    auto tail = std::lower_bound(
+        tails.begin(), tails.end(), regions[i].previous_index,
+        [&regions](size_t region, size_t previous_index) {
+          return regions[region].previous_index < previous_index;
+        });
+    if (tail != tails.begin()) {
+      predecessors[i] = *(tail - 1);
+    }
+    if (tail == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *tail = i;
+    }
+  }
+  std::vector<bool> in_order(regions.size(), false);
+  for (size_t i = tails.empty() ? kNone : tails.back(); i != kNone;
+       i = predecessors[i]) {
+    in_order[i] = true;
+  }
+  return in_order;
+}
+
+}  // namespace
+
+static bool PaintRegionLess(const DamageContext::PaintRegion& a,
+                            const DamageContext::PaintRegion& b) {
+  return std::tie(a.fingerprint, a.bounds.fLeft, a.bounds.fTop,
+                  a.bounds.fRight, a.bounds.fBottom) <
+         std::tie(b.fingerprint, b.bounds.fLeft, b.bounds.fTop,
+                  b.bounds.fRight, b.bounds.fBottom);
+}
+
+DamageContext::AutoState::AutoState(DamageContext* context,
+                                    uint64_t fingerprint)
+    : context_(context) {
+  if (context_) {
+    previous_state_ = context_->state_;
+    context_->state_ = fml::HashCombine(previous_state_, fingerprint);
+  }
+}
+
+DamageContext::AutoState::~AutoState() {
+  if (context_) {
+    context_->state_ = previous_state_;
+  }
+}
+
+DamageContext::DamageContext(const SkIRect& surface_bounds)
+    : surface_bounds_(surface_bounds) {}
+
+DamageContext::~DamageContext() = default;
+
+void DamageContext::AddPaintRegion(uint64_t fingerprint,
+                                   const SkMatrix& matrix,
+                                   const SkRect& bounds) {
+  FML_DCHECK(!finalized_);
+  if (bounds.isEmpty()) {
+    return;
+  }
+  // The transform is part of the fingerprint since the same content drawn
+  // under a different transform (e.g. a sub-pixel translation) produces
+  // different pixels even if the device bounds happen to be equal.
+  const uint64_t region_fingerprint = fml::HashCombine(
+      state_, fingerprint, matrix[0], matrix[1], matrix[2], matrix[3],
+      matrix[4], matrix[5], matrix[6], matrix[7], matrix[8]);
+  paint_regions_.push_back({region_fingerprint, matrix.mapRect(bounds)});
+}
+
+void DamageContext::AddDamage(const SkMatrix& matrix, const SkRect& bounds) {
+  FML_DCHECK(!finalized_);
+  if (bounds.isEmpty()) {
+    return;
+  }
+  damage_.push_back(matrix.mapRect(bounds));
+}
+
+DamageContext::Position DamageContext::position() const {
+  return {state_, paint_regions_.size(), damage_.size(), full_repaint_count_};
+}
+
+DamageContext::Recording DamageContext::RecordSince(
+    const Position& start) const {
+  FML_DCHECK(!finalized_);
+  FML_DCHECK(start.state == state_);
+  Recording recording;
+  recording.state = start.state;
+  recording.paint_regions.assign(
+      paint_regions_.begin() + start.paint_region_count, paint_regions_.end());
+  recording.damage.assign(damage_.begin() + start.damage_count, damage_.end());
+  recording.needs_full_repaint = full_repaint_count_ > start.full_repaint_count;
+  return recording;
+}
+
+void DamageContext::Replay(const Recording& recording) {
+  FML_DCHECK(!finalized_);
+  FML_DCHECK(recording.state == state_);
+  paint_regions_.insert(paint_regions_.end(), recording.paint_regions.begin(),
+                        recording.paint_regions.end());
+  damage_.insert(damage_.end(), recording.damage.begin(),
+                 recording.damage.end());
+  if (recording.needs_full_repaint) {
+    MarkFullRepaint();
+  }
+}
+
+void DamageContext::Finalize() {
+  if (finalized_) {
+    return;
+  }
+  for (size_t i = 0; i < paint_regions_.size(); i++) {
+    paint_regions_[i].paint_index = i;
+  }
+  std::sort(paint_regions_.begin(), paint_regions_.end(), PaintRegionLess);
+  finalized_ = true;
+}
+
+SkIRect DamageContext::ComputeDamage(const DamageContext* previous) {
+  TRACE_EVENT0("flutter", "DamageContext::ComputeDamage");
+  Finalize();
+
+  if (previous == nullptr || !previous->finalized_ || needs_full_repaint() ||
+      previous->needs_full_repaint() ||
+      previous->surface_bounds_ != surface_bounds_) {
+    return surface_bounds_;
+  }
+
+  // Both region lists are sorted, so the regions present in only one of the
+  // frames can be found in a single merge pass.
+  std::vector<MatchedRegion> matched;
+  SkRect damage = SkRect::MakeEmpty();
+  for (const SkRect& rect : damage_) {
+    damage.join(rect);
+  }
+  for (const SkRect& rect : previous->damage_) {
+    damage.join(rect);
+  }
+  auto current = paint_regions_.begin();
+  auto old = previous->paint_regions_.begin();
+  while (current != paint_regions_.end() &&
+         old != previous->paint_regions_.end()) {
+    if (PaintRegionLess(*current, *old)) {
+      damage.join(current->bounds);
+      ++current;
+    } else if (PaintRegionLess(*old, *current)) {
+      damage.join(old->bounds);
+      ++old;
+    } else {
+      matched.push_back(
+          {current->paint_index, old->paint_index, current->bounds});
+      ++current;
+      ++old;
+    }
+  }
+  for (; current != paint_regions_.end(); ++current) {
+    damage.join(current->bounds);
+  }
+  for (; old != previous->paint_regions_.end(); ++old) {
+    damage.join(old->bounds);
+  }
+
+  // A region painted in both frames still changes pixels if it is now painted
+  // in a different order relative to a region it overlaps, e.g. when two
+  // overlapping siblings swap. One region of every such pair is outside the
+  // longest run painted in the same order, and repainting its bounds repaints
+  // the overlap.
+  std::sort(matched.begin(), matched.end(),
+            [](const MatchedRegion& a, const MatchedRegion& b) {
+              return a.current_index < b.current_index;
+            });
+  const std::vector<bool> in_order = FindRegionsInOrder(matched);
+  for (size_t i = 0; i < matched.size(); i++) {
+    if (in_order[i]) {
+      continue;
+    }
+    for (size_t j = 0; j < matched.size(); j++) {
+      const bool reordered = (i < j) != (matched[i].previous_index <
+                                         matched[j].previous_index);
+      if (j != i && reordered &&
+          SkRect::Intersects(matched[i].bounds, matched[j].bounds)) {
+        damage.join(matched[i].bounds);
+        break;
+      }
+    }
+  }
+
+  SkIRect device_damage = damage.roundOut();
+  if (!device_damage.intersect(surface_bounds_)) {
+    return SkIRect::MakeEmpty();
+  }
+  return device_damage;
+}
+
+}  // namespace flutter
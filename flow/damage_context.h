@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DAMAGE_CONTEXT_H_
+#define FLUTTER_FLOW_DAMAGE_CONTEXT_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+/// Records the regions of the surface painted by the layers of a frame.
+///
+/// During Preroll every layer that produces pixels of its own adds a paint
+/// region to the context: its paint bounds mapped to surface coordinates,
+/// tagged with a fingerprint of everything that influences those pixels (the
+/// layer's own fingerprint combined with the fingerprints of all of its
+/// ancestors and the transform it is drawn with). A region that appears in
+/// both the previous and the current frame with the same fingerprint and
+/// bounds paints identical pixels, so only the symmetric difference of the two
+/// sets of regions needs to be repainted, along with the regions whose paint
+/// order changed relative to a region they overlap.
+class DamageContext {
+ public:
+  /// A region of the surface painted by a single layer.
+  struct PaintRegion {
+    uint64_t fingerprint;
+    SkRect bounds;
+    // The position of the region in paint order, set when the frame is
+    // finalized.
+    size_t paint_index = 0;
+  };
+
+  /// A point in the sequence of paint regions and damage added to a context.
+  struct Position {
+    uint64_t state;
+    size_t paint_region_count;
+    size_t damage_count;
+    size_t full_repaint_count;
+  };
+
+  /// The paint regions and damage added by a subtree of layers, captured so
+  /// that they can be added again in a later frame without prerolling the
+  /// subtree. The fingerprints of the regions include the state the subtree
+  /// was prerolled under, so a recording may only be replayed under that same
+  /// state.
+  struct Recording {
+    uint64_t state = 0;
+    std::vector<PaintRegion> paint_regions;
+    std::vector<SkRect> damage;
+    bool needs_full_repaint = false;
+  };
+
+  /// Combines a layer's fingerprint into the fingerprint of all the paint
+  /// regions added for its descendants while this object is alive. Does
+  /// nothing if |context| is null.
+  class AutoState {
+   public:
+    AutoState(DamageContext* context, uint64_t fingerprint);
+
+    ~AutoState();
+
+   private:
+    DamageContext* context_;
+    uint64_t previous_state_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(AutoState);
+  };
+
+  /// Creates a context for a frame covering |surface_bounds|, in surface
+  /// coordinates.
+  explicit DamageContext(const SkIRect& surface_bounds);
+
+  ~DamageContext();
+
+  /// Adds the region painted by a layer with the given fingerprint. |bounds|
+  /// are in the coordinate system established by |matrix|.
+  void AddPaintRegion(uint64_t fingerprint,
+                      const SkMatrix& matrix,
+                      const SkRect& bounds);
+
+  /// Adds a region whose content may change without any change to the layer
+  /// tree (e.g. external textures). It is repainted in this frame and in the
+  /// frame that follows it.
+  void AddDamage(const SkMatrix& matrix, const SkRect& bounds);
+
+  /// Requests that the whole frame be repainted. This is used by layers whose
+  /// output cannot be described by their own paint bounds, such as backdrop
+  /// filters that read back the content painted beneath them.
+  void MarkFullRepaint() { full_repaint_count_++; }
+
+  bool needs_full_repaint() const { return full_repaint_count_ > 0; }
+
+  /// The fingerprint combined into the paint regions added at this point.
+  uint64_t state() const { return state_; }
+
+  Position position() const;
+
+  /// Returns everything that was added to the context since |start|.
+  Recording RecordSince(const Position& start) const;
+
+  /// Adds the paint regions and damage of |recording| again. The current state
+  /// must be the state the recording was made under.
+  void Replay(const Recording& recording);
+
+  const SkIRect& surface_bounds() const { return surface_bounds_; }
+
+  /// Returns the area of the surface that differs between the frame recorded
+  /// in |previous| and the frame recorded in this context, clipped to the
+  /// surface bounds. If |previous| is null or not comparable with this frame,
+  /// the whole surface is returned.
+  ///
+  /// This call finalizes the recorded paint regions; no regions may be added
+  /// after it.
+  SkIRect ComputeDamage(const DamageContext* previous);
+
+ private:
+  const SkIRect surface_bounds_;
+  uint64_t state_ = 0;
+  std::vector<PaintRegion> paint_regions_;
+  std::vector<SkRect> damage_;
+  size_t full_repaint_count_ = 0;
+  bool finalized_ = false;
+
+  void Finalize();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DamageContext);
+};
+
+/// The damage tracking state of a single frame. The rasterizer provides the
+/// inputs and CompositorContext::ScopedFrame::Raster fills in the outputs.
+struct FrameDamage {
+  /// The context the layers of the frame record their paint regions into.
+  DamageContext* current_frame = nullptr;
+
+  /// The paint regions recorded for the last frame presented to the surface,
+  /// or null if that frame is unknown.
+  DamageContext* previous_frame = nullptr;
+
+  /// The area of the target buffer whose content is older than the last frame
+  /// presented to the surface. std::nullopt means that the content of the
+  /// buffer is undefined and it has to be repainted entirely.
+  std::optional<SkIRect> existing_damage;
+
+  /// The area of the surface that changed since the last frame.
+  std::optional<SkIRect> frame_damage;
+
+  /// The area of the target buffer that was repainted. This is the frame
+  /// damage joined with the existing damage of the buffer.
+  std::optional<SkIRect> buffer_damage;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DAMAGE_CONTEXT_H_
@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_context.h"
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+const SkIRect kSurfaceBounds = SkIRect::MakeWH(100, 100);
+
+}  // namespace
+
+TEST(DamageContextTest, FirstFrameIsFullyDamaged) {
+  DamageContext context(kSurfaceBounds);
+  context.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  EXPECT_EQ(context.ComputeDamage(nullptr), kSurfaceBounds);
+}
+
+TEST(DamageContextTest, IdenticalFramesHaveNoDamage) {
+  DamageContext previous(kSurfaceBounds);
+  previous.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  previous.AddPaintRegion(2, SkMatrix::I(), SkRect::MakeXYWH(50, 50, 5, 5));
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddPaintRegion(2, SkMatrix::I(), SkRect::MakeXYWH(50, 50, 5, 5));
+  current.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  EXPECT_TRUE(current.ComputeDamage(&previous).isEmpty());
+}
+
+TEST(DamageContextTest, ChangedRegionIsDamaged) {
+  DamageContext previous(kSurfaceBounds);
+  previous.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  previous.AddPaintRegion(2, SkMatrix::I(), SkRect::MakeXYWH(50, 50, 5, 5));
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  current.AddPaintRegion(3, SkMatrix::I(), SkRect::MakeXYWH(50, 50, 5, 5));
+  EXPECT_EQ(current.ComputeDamage(&previous), SkIRect::MakeXYWH(50, 50, 5, 5));
+}
+
+TEST(DamageContextTest, MovedRegionDamagesOldAndNewBounds) {
+  DamageContext previous(kSurfaceBounds);
+  previous.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddPaintRegion(1, SkMatrix::Translate(20, 0),
+                         SkRect::MakeXYWH(10, 10, 5, 5));
+  EXPECT_EQ(current.ComputeDamage(&previous),
+            SkIRect::MakeLTRB(10, 10, 35, 15));
+}
+
+TEST(DamageContextTest, ReorderedOverlappingRegionsAreDamaged) {
+  DamageContext previous(kSurfaceBounds);
+  previous.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 20, 20));
+  previous.AddPaintRegion(2, SkMatrix::I(), SkRect::MakeXYWH(20, 20, 20, 20));
+  previous.AddPaintRegion(3, SkMatrix::I(), SkRect::MakeXYWH(70, 70, 5, 5));
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddPaintRegion(3, SkMatrix::I(), SkRect::MakeXYWH(70, 70, 5, 5));
+  current.AddPaintRegion(2, SkMatrix::I(), SkRect::MakeXYWH(20, 20, 20, 20));
+  current.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 20, 20));
+  SkIRect damage = current.ComputeDamage(&previous);
+  // The overlap of the swapped regions is repainted, while the region that
+  // only moved in paint order without overlapping anything is not.
+  EXPECT_TRUE(damage.contains(SkIRect::MakeLTRB(20, 20, 30, 30)));
+  EXPECT_FALSE(damage.contains(SkIRect::MakeXYWH(70, 70, 5, 5)));
+}
+
+TEST(DamageContextTest, StateChangesFingerprintOfDescendants) {
+  DamageContext previous(kSurfaceBounds);
+  {
+    DamageContext::AutoState state(&previous, 7);
+    previous.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  }
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  {
+    DamageContext::AutoState state(&current, 8);
+    current.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  }
+  EXPECT_EQ(current.ComputeDamage(&previous), SkIRect::MakeXYWH(10, 10, 5, 5));
+}
+
+TEST(DamageContextTest, DamageIsRepaintedInTheFollowingFrame) {
+  DamageContext previous(kSurfaceBounds);
+  previous.AddDamage(SkMatrix::I(), SkRect::MakeXYWH(10, 10, 5, 5));
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddDamage(SkMatrix::I(), SkRect::MakeXYWH(30, 10, 5, 5));
+  EXPECT_EQ(current.ComputeDamage(&previous),
+            SkIRect::MakeLTRB(10, 10, 35, 15));
+}
+
+TEST(DamageContextTest, DamageIsClippedToSurface) {
+  DamageContext previous(kSurfaceBounds);
+  previous.ComputeDamage(nullptr);
+
+  DamageContext current(kSurfaceBounds);
+  current.AddPaintRegion(1, SkMatrix::I(), SkRect::MakeXYWH(90, 90, 50, 50));
+  EXPECT_EQ(current.ComputeDamage(&previous),
+            SkIRect::MakeLTRB(90, 90, 100, 100));
+}
+
+TEST(DamageContextTest, FullRepaintOrResizeDamagesWholeSurface) {
+  DamageContext previous(kSurfaceBounds);
+  previous.ComputeDamage(nullptr);
+
+  DamageContext full_repaint(kSurfaceBounds);
+  full_repaint.MarkFullRepaint();
+  EXPECT_EQ(full_repaint.ComputeDamage(&previous), kSurfaceBounds);
+
+  DamageContext resized(SkIRect::MakeWH(200, 100));
+  EXPECT_EQ(resized.ComputeDamage(&previous), SkIRect::MakeWH(200, 100));
+}
+
+using DamageContextLayerTest = LayerTest;
+
+TEST_F(DamageContextLayerTest, RetainedSubtreeIsNotDamaged) {
+  auto retained = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(10, 10, 5, 5)));
+  auto first_changing = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(50, 50, 5, 5)));
+  auto second_changing = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(50, 50, 5, 5)));
+
+  auto first_root = std::make_shared<ContainerLayer>();
+  first_root->Add(retained);
+  first_root->Add(first_changing);
+  DamageContext previous(kSurfaceBounds);
+  preroll_context()->damage_context = &previous;
+  first_root->Preroll(preroll_context(), SkMatrix::I());
+  previous.ComputeDamage(nullptr);
+
+  // A new container holding the same retained layer.
+  auto second_root = std::make_shared<ContainerLayer>();
+  second_root->Add(retained);
+  second_root->Add(second_changing);
+  DamageContext current(kSurfaceBounds);
+  preroll_context()->damage_context = &current;
+  second_root->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(current.ComputeDamage(&previous), SkIRect::MakeXYWH(50, 50, 5, 5));
+}
+
+TEST_F(DamageContextLayerTest, SwappedOverlappingSiblingsAreDamaged) {
+  auto first = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(10, 10, 20, 20)));
+  auto second = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(20, 20, 20, 20)));
+
+  auto first_root = std::make_shared<ContainerLayer>();
+  first_root->Add(first);
+  first_root->Add(second);
+  DamageContext previous(kSurfaceBounds);
+  preroll_context()->damage_context = &previous;
+  first_root->Preroll(preroll_context(), SkMatrix::I());
+  previous.ComputeDamage(nullptr);
+
+  auto second_root = std::make_shared<ContainerLayer>();
+  second_root->Add(second);
+  second_root->Add(first);
+  DamageContext current(kSurfaceBounds);
+  preroll_context()->damage_context = &current;
+  second_root->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_TRUE(current.ComputeDamage(&previous).contains(
+      SkIRect::MakeLTRB(20, 20, 30, 30)));
+}
+
+TEST_F(DamageContextLayerTest, OpacityChangeDamagesChildren) {
+  auto child = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeXYWH(10, 10, 5, 5)));
+
+  auto first_opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  first_opacity->Add(child);
+  DamageContext previous(kSurfaceBounds);
+  preroll_context()->damage_context = &previous;
+  first_opacity->Preroll(preroll_context(), SkMatrix::I());
+  previous.ComputeDamage(nullptr);
+
+  auto same_opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  same_opacity->Add(child);
+  DamageContext unchanged(kSurfaceBounds);
+  preroll_context()->damage_context = &unchanged;
+  same_opacity->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_TRUE(unchanged.ComputeDamage(&previous).isEmpty());
+
+  auto other_opacity = std::make_shared<OpacityLayer>(64, SkPoint::Make(0, 0));
+  other_opacity->Add(child);
+  DamageContext changed(kSurfaceBounds);
+  preroll_context()->damage_context = &changed;
+  other_opacity->Preroll(preroll_context(), SkMatrix::I());
+  EXPECT_EQ(changed.ComputeDamage(&unchanged),
+            SkIRect::MakeXYWH(10, 10, 5, 5));
+}
+
+}  // namespace testing
+}  // namespace flutter
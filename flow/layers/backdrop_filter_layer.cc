@@ -13,6 +13,10 @@ void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
+  // The filtered backdrop depends on everything painted beneath this layer.
+  if (context->damage_context) {
+    context->damage_context->MarkFullRepaint();
+  }
   ContainerLayer::Preroll(context, matrix);
 }
 
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/clip_path_layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 #include "lib/ui/scenic/cpp/commands.h"
@@ -36,6 +37,13 @@ void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->cull_rect = previous_cull_rect;
 }
 
+uint64_t ClipPathLayer::paint_fingerprint() const {
+  // Copies of an SkPath share the generation ID of the original path, so a
+  // path that is passed unchanged from frame to frame keeps its fingerprint.
+  return fml::HashCombine(clip_path_.getGenerationID(),
+                          static_cast<int>(clip_behavior_));
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void ClipPathLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
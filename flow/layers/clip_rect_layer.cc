@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -31,6 +32,11 @@ void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->cull_rect = previous_cull_rect;
 }
 
+uint64_t ClipRectLayer::paint_fingerprint() const {
+  return fml::HashCombine(clip_rect_.fLeft, clip_rect_.fTop, clip_rect_.fRight,
+                          clip_rect_.fBottom, static_cast<int>(clip_behavior_));
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void ClipRectLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/clip_rrect_layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -32,6 +33,21 @@ void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->cull_rect = previous_cull_rect;
 }
 
+uint64_t ClipRRectLayer::paint_fingerprint() const {
+  const SkRect& rect = clip_rrect_.rect();
+  return fml::HashCombine(
+      rect.fLeft, rect.fTop, rect.fRight, rect.fBottom,
+      clip_rrect_.radii(SkRRect::kUpperLeft_Corner).fX,
+      clip_rrect_.radii(SkRRect::kUpperLeft_Corner).fY,
+      clip_rrect_.radii(SkRRect::kUpperRight_Corner).fX,
+      clip_rrect_.radii(SkRRect::kUpperRight_Corner).fY,
+      clip_rrect_.radii(SkRRect::kLowerRight_Corner).fX,
+      clip_rrect_.radii(SkRRect::kLowerRight_Corner).fY,
+      clip_rrect_.radii(SkRRect::kLowerLeft_Corner).fX,
+      clip_rrect_.radii(SkRRect::kLowerLeft_Corner).fY,
+      static_cast<int>(clip_behavior_));
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void ClipRRectLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
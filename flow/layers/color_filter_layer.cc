@@ -14,6 +14,13 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+
+  // The filter is applied to the whole save layer, which may produce pixels
+  // in areas that none of the children paint.
+  if (context->damage_context) {
+    context->damage_context->AddPaintRegion(paint_fingerprint(), matrix,
+                                            paint_bounds());
+  }
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
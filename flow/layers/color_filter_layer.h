@@ -18,6 +18,8 @@ class ColorFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  uint64_t paint_fingerprint() const override { return unique_id(); }
+
  private:
   sk_sp<SkColorFilter> filter_;
 
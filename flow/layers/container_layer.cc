@@ -12,6 +12,7 @@ ContainerLayer::ContainerLayer() {}
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  preroll_snapshot_.reset();
 }
 
 void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
@@ -43,13 +44,20 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // always be false.
   FML_DCHECK(!context->has_platform_view);
   bool child_has_platform_view = false;
+  DamageContext::AutoState damage_state(context->damage_context,
+                                        paint_fingerprint());
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
     context->has_platform_view = false;
 
-    layer->Preroll(context, child_matrix);
+    ContainerLayer* container = layer->as_container_layer();
+    if (container) {
+      container->PrerollRetained(context, child_matrix);
+    } else {
+      layer->Preroll(context, child_matrix);
+    }
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
@@ -71,6 +79,99 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 #endif
 }
 
+void ContainerLayer::PrerollRetained(PrerollContext* context,
+                                     const SkMatrix& matrix) {
+#if defined(LEGACY_FUCHSIA_EMBEDDER)
+  // The scene update pass relies on the child scene layer state that is only
+  // collected by a full Preroll.
+  Preroll(context, matrix);
+#else
+  RasterCache* raster_cache = context->raster_cache;
+  DamageContext* damage_context = context->damage_context;
+
+  if (preroll_snapshot_ && preroll_snapshot_->CanReplay(context, matrix)) {
+    TRACE_EVENT0("flutter", "ContainerLayer::ReplayPreroll");
+    if (raster_cache) {
+      raster_cache->Replay(context, preroll_snapshot_->raster_cache_requests);
+    }
+    if (damage_context) {
+      damage_context->Replay(preroll_snapshot_->damage);
+    }
+    context->surface_needs_readback = context->surface_needs_readback ||
+                                      preroll_snapshot_->surface_needs_readback;
+    return;
+  }
+  preroll_snapshot_.reset();
+
+  // Layers that are built anew for every frame are never prerolled twice, so
+  // only start recording once a layer has been retained.
+  if (!prerolled_) {
+    prerolled_ = true;
+    Preroll(context, matrix);
+    return;
+  }
+
+  auto snapshot = std::make_unique<PrerollSnapshot>();
+  snapshot->matrix = matrix;
+  snapshot->cull_rect = context->cull_rect;
+  snapshot->raster_cache = raster_cache;
+  snapshot->has_damage_context = damage_context != nullptr;
+  snapshot->checkerboard_offscreen_layers =
+      context->checkerboard_offscreen_layers;
+  snapshot->frame_device_pixel_ratio = context->frame_device_pixel_ratio;
+
+  const size_t request_start =
+      raster_cache ? raster_cache->prepare_requests().size() : 0;
+  std::optional<DamageContext::Position> damage_start;
+  if (damage_context) {
+    damage_start = damage_context->position();
+  }
+  // Collect the flags for this subtree alone and merge them back afterwards.
+  const bool surface_needs_readback = context->surface_needs_readback;
+  const bool has_volatile_preroll = context->has_volatile_preroll;
+  context->surface_needs_readback = false;
+  context->has_volatile_preroll = false;
+
+  Preroll(context, matrix);
+
+  snapshot->surface_needs_readback = context->surface_needs_readback;
+  const bool subtree_is_volatile = context->has_volatile_preroll;
+  context->surface_needs_readback =
+      surface_needs_readback || snapshot->surface_needs_readback;
+  context->has_volatile_preroll = has_volatile_preroll || subtree_is_volatile;
+
+  if (context->has_platform_view || subtree_is_volatile) {
+    return;
+  }
+  if (raster_cache) {
+    const auto& requests = raster_cache->prepare_requests();
+    snapshot->raster_cache_requests.assign(requests.begin() + request_start,
+                                           requests.end());
+  }
+  if (damage_context) {
+    snapshot->damage = damage_context->RecordSince(*damage_start);
+  }
+  preroll_snapshot_ = std::move(snapshot);
+#endif
+}
+
+bool ContainerLayer::PrerollSnapshot::CanReplay(const PrerollContext* context,
+                                                const SkMatrix& matrix) const {
+  if (this->matrix != matrix || cull_rect != context->cull_rect ||
+      raster_cache != context->raster_cache ||
+      checkerboard_offscreen_layers != context->checkerboard_offscreen_layers ||
+      frame_device_pixel_ratio != context->frame_device_pixel_ratio) {
+    return false;
+  }
+  if (has_damage_context != (context->damage_context != nullptr)) {
+    return false;
+  }
+  // The fingerprints of the recorded paint regions include the state of the
+  // ancestors the subtree was prerolled under.
+  return !context->damage_context ||
+         context->damage_context->state() == damage.state;
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
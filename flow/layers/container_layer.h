@@ -5,9 +5,12 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <memory>
 #include <vector>
 
+#include "flutter/flow/damage_context.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/raster_cache.h"
 
 namespace flutter {
 
@@ -19,6 +22,24 @@ class ContainerLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+
+  // A plain ContainerLayer only groups its children and does not affect their
+  // pixels, so its fingerprint does not depend on the layer's identity.
+  uint64_t paint_fingerprint() const override { return 0; }
+
+  ContainerLayer* as_container_layer() override { return this; }
+
+  // Prerolls this layer, or repeats the results of its last Preroll without
+  // visiting its children if nothing the Preroll depends on has changed.
+  //
+  // Layers are immutable once they have been added to a layer tree, so a layer
+  // that is retained into a later frame (see |SceneBuilder.addRetained| and
+  // |EngineLayer|) and prerolled again with the same transform, cull rect and
+  // context settings arrives at the same paint bounds, raster cache requests
+  // and paint regions. Subtrees that contain platform views are always
+  // prerolled since they also update the state of the view embedder.
+  void PrerollRetained(PrerollContext* context, const SkMatrix& matrix);
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void CheckForChildLayerBelow(PrerollContext* context) override;
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
@@ -51,7 +72,27 @@ class ContainerLayer : public Layer {
                                       const SkMatrix& matrix);
 
  private:
+  // The inputs and side effects of the last Preroll of a layer that can be
+  // repeated by PrerollRetained. The paint bounds are kept by the layer
+  // itself.
+  struct PrerollSnapshot {
+    SkMatrix matrix;
+    SkRect cull_rect;
+    const RasterCache* raster_cache;
+    bool has_damage_context;
+    bool checkerboard_offscreen_layers;
+    float frame_device_pixel_ratio;
+
+    bool surface_needs_readback;
+    std::vector<RasterCache::PrepareRequest> raster_cache_requests;
+    DamageContext::Recording damage;
+
+    bool CanReplay(const PrerollContext* context, const SkMatrix& matrix) const;
+  };
+
   std::vector<std::shared_ptr<Layer>> layers_;
+  bool prerolled_ = false;
+  std::unique_ptr<PrerollSnapshot> preroll_snapshot_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/opacity_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -268,5 +269,112 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, RetainedLayerSkipsUnchangedPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  for (int frame = 0; frame < 3; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    root->Preroll(preroll_context(), SkMatrix());
+    EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  }
+  // The first two frames record the results of the Preroll, the third one
+  // replays them.
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+  EXPECT_EQ(retained->paint_bounds(), child_path.getBounds());
+
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+  root->Preroll(preroll_context(), SkMatrix::Translate(1.0f, 0.0f));
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(1.0f, 0.0f));
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerReplaysReadback) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(
+      child_path, SkPaint(), false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */, true /* fake_reads_surface */);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  for (int frame = 0; frame < 3; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    preroll_context()->surface_needs_readback = false;
+    root->Preroll(preroll_context(), SkMatrix());
+    EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerWithPlatformViewIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(
+      child_path, SkPaint(), true /* fake_has_platform_view */);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  for (int frame = 0; frame < 3; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    root->Preroll(preroll_context(), SkMatrix());
+    EXPECT_TRUE(preroll_context()->has_platform_view);
+    preroll_context()->has_platform_view = false;
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerKeepsRasterCacheEntries) {
+  use_mock_raster_cache();
+
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  retained->Add(mock_layer);
+
+  for (int frame = 0; frame < 3; frame++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    root->Preroll(preroll_context(), SkMatrix());
+    EXPECT_EQ(raster_cache()->prepare_requests().size(), 1u);
+    raster_cache()->SweepAfterFrame();
+    EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 1u);
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerReplaysPaintRegions) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  const SkIRect surface_bounds = SkIRect::MakeWH(100, 100);
+  std::unique_ptr<DamageContext> previous;
+  for (int frame = 0; frame < 3; frame++) {
+    auto current = std::make_unique<DamageContext>(surface_bounds);
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    preroll_context()->damage_context = current.get();
+    root->Preroll(preroll_context(), SkMatrix());
+    SkIRect damage = current->ComputeDamage(previous.get());
+    if (previous) {
+      EXPECT_TRUE(damage.isEmpty());
+    }
+    previous = std::move(current);
+  }
+  preroll_context()->damage_context = nullptr;
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
 }  // namespace testing
 }  // namespace flutter
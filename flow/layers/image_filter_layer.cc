@@ -18,6 +18,13 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
 
+  // The filter may move pixels of the children outside of their own paint
+  // bounds, so a change to any child can affect an area that the recorded
+  // paint regions do not describe.
+  if (context->damage_context) {
+    context->damage_context->MarkFullRepaint();
+  }
+
   SkRect child_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_bounds);
   if (filter_) {
@@ -41,6 +48,7 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
     // increment the count to measure how many times it has been
     // seen from frame to frame.
     render_count_++;
+    context->has_volatile_preroll = true;
 
     // Now we will try to pre-render the children into the cache.
     // To apply the filter to pre-rendered children, we must first
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/flow/damage_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
@@ -59,6 +60,16 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a platform view during Preroll.
   bool has_platform_view = false;
+
+  // Records the regions painted by the layers of this frame so that only the
+  // parts of the surface that changed since the previous frame are repainted.
+  // Null if damage tracking is disabled for this frame.
+  DamageContext* damage_context = nullptr;
+
+  // Set by layers whose Preroll results depend on more than the inputs of the
+  // Preroll, so that they are not reused by a retained ancestor in a later
+  // frame. See ContainerLayer::PrerollRetained.
+  bool has_volatile_preroll = false;
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   // True if, during the traversal so far, we have seen a child_scene_layer.
   // Informs whether a layer needs to be system composited.
@@ -66,6 +77,8 @@ struct PrerollContext {
 #endif
 };
 
+class ContainerLayer;
+
 // Represents a single composited layer. Created on the UI thread but then
 // subquently used on the Rasterizer thread.
 class Layer {
@@ -200,6 +213,21 @@ class Layer {
 
   uint64_t unique_id() const { return unique_id_; }
 
+  // Returns a value identifying the pixels that this layer paints or applies
+  // to its children, excluding the content of the children themselves. Two
+  // layers with the same fingerprint that are prerolled with the same
+  // transform and under ancestors with the same fingerprints paint identical
+  // pixels, which is what allows the DamageContext to skip repainting them.
+  //
+  // Layers are immutable once they have been added to a layer tree, so by
+  // default the fingerprint is the unique_id(). Layers that are commonly
+  // rebuilt with the same properties from frame to frame override this to
+  // derive the fingerprint from those properties instead.
+  virtual uint64_t paint_fingerprint() const { return unique_id_; }
+
+  // Returns this layer if it is a ContainerLayer, or null for leaf layers.
+  virtual ContainerLayer* as_container_layer() { return nullptr; }
+
  protected:
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   bool child_layer_exists_below_ = false;
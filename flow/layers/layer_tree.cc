@@ -56,6 +56,9 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  if (frame.frame_damage()) {
+    context.damage_context = frame.frame_damage()->current_frame;
+  }
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
   return context.surface_needs_readback;
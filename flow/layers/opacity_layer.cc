@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPaint.h"
 
@@ -83,6 +84,10 @@ void OpacityLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+uint64_t OpacityLayer::paint_fingerprint() const {
+  return fml::HashCombine(alpha_, offset_.fX, offset_.fY);
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void OpacityLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
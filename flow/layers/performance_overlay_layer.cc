@@ -74,6 +74,14 @@ PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
   }
 }
 
+void PerformanceOverlayLayer::Preroll(PrerollContext* context,
+                                      const SkMatrix& matrix) {
+  // The statistics change every frame, so the overlay is always repainted.
+  if (context->damage_context) {
+    context->damage_context->AddDamage(matrix, paint_bounds());
+  }
+}
+
 void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   const int padding = 8;
 
@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/physical_shape_layer.h"
 
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
 namespace flutter {
@@ -41,6 +42,17 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     set_paint_bounds(ComputeShadowBounds(path_.getBounds(), elevation_,
                                          context->frame_device_pixel_ratio));
   }
+
+  if (context->damage_context) {
+    context->damage_context->AddPaintRegion(paint_fingerprint(), matrix,
+                                            paint_bounds());
+  }
+}
+
+uint64_t PhysicalShapeLayer::paint_fingerprint() const {
+  return fml::HashCombine(color_, shadow_color_, elevation_,
+                          path_.getGenerationID(),
+                          static_cast<int>(clip_behavior_));
 }
 
 void PhysicalShapeLayer::Paint(PaintContext& context) const {
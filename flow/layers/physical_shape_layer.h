@@ -37,6 +37,8 @@ class PhysicalShapeLayer : public ContainerLayer {
 
   float elevation() const { return elevation_; }
 
+  uint64_t paint_fingerprint() const override;
+
  private:
   SkColor color_;
   SkColor shadow_color_;
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -11,11 +12,13 @@ namespace flutter {
 PictureLayer::PictureLayer(const SkPoint& offset,
                            SkiaGPUObject<SkPicture> picture,
                            bool is_complex,
-                           bool will_change)
+                           bool will_change,
+                           uint64_t content_hash)
     : offset_(offset),
       picture_(std::move(picture)),
       is_complex_(is_complex),
-      will_change_(will_change) {}
+      will_change_(will_change),
+      content_hash_(content_hash) {}
 
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "PictureLayer::Preroll");
@@ -35,11 +38,27 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
     cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+                   context->dst_color_space, is_complex_, will_change_,
+                   content_hash_);
   }
 
   SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
+
+  if (context->damage_context) {
+    context->damage_context->AddPaintRegion(paint_fingerprint(), matrix,
+                                            bounds);
+  }
+}
+
+uint64_t PictureLayer::paint_fingerprint() const {
+  // The framework hands the same SkPicture to a new PictureLayer every frame
+  // for content that has not been repainted. Content that was repainted
+  // identically is recognized by its hash.
+  if (content_hash_ != 0) {
+    return fml::HashCombine64(content_hash_, offset_.x(), offset_.y());
+  }
+  return fml::HashCombine64(picture()->uniqueID(), offset_.x(), offset_.y());
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
@@ -55,7 +74,8 @@ void PictureLayer::Paint(PaintContext& context) const {
 #endif
 
   if (context.raster_cache &&
-      context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas)) {
+      context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas,
+                                 content_hash_)) {
     TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
     return;
   }
@@ -18,7 +18,8 @@ class PictureLayer : public Layer {
   PictureLayer(const SkPoint& offset,
                SkiaGPUObject<SkPicture> picture,
                bool is_complex,
-               bool will_change);
+               bool will_change,
+               uint64_t content_hash = 0);
 
   SkPicture* picture() const { return picture_.get().get(); }
 
@@ -26,6 +27,8 @@ class PictureLayer : public Layer {
 
   void Paint(PaintContext& context) const override;
 
+  uint64_t paint_fingerprint() const override;
+
  private:
   SkPoint offset_;
   // Even though pictures themselves are not GPU resources, they may reference
@@ -33,6 +36,9 @@ class PictureLayer : public Layer {
   SkiaGPUObject<SkPicture> picture_;
   bool is_complex_ = false;
   bool will_change_ = false;
+  // A hash of the content of the picture, or 0 if it is unknown. Pictures with
+  // equal hashes share their raster cache entries.
+  uint64_t content_hash_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PictureLayer);
 };
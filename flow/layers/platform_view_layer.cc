@@ -21,6 +21,11 @@ void PlatformViewLayer::Preroll(PrerollContext* context,
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
 
+  // Platform views are composited by the embedder on their own.
+  if (context->damage_context) {
+    context->damage_context->MarkFullRepaint();
+  }
+
   if (context->view_embedder == nullptr) {
     FML_LOG(ERROR) << "Trying to embed a platform view but the PrerollContext "
                       "does not support embedding";
@@ -20,6 +20,8 @@ class ShaderMaskLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  uint64_t paint_fingerprint() const override { return unique_id(); }
+
  private:
   sk_sp<SkShader> shader_;
   SkRect mask_rect_;
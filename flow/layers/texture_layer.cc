@@ -28,6 +28,11 @@ void TextureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
+
+  // New texture frames arrive without any change to the layer tree.
+  if (context->damage_context) {
+    context->damage_context->AddDamage(matrix, paint_bounds());
+  }
 }
 
 void TextureLayer::Paint(PaintContext& context) const {
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -16,6 +17,7 @@
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
 
 namespace flutter {
 
@@ -61,6 +63,20 @@ static bool CanRasterizePicture(SkPicture* picture) {
   return true;
 }
 
+// The ID |picture| is cached under. Content hashes have the top bit set so that
+// they never match the unique ID of another picture.
+static uint64_t GetPictureId(const SkPicture& picture, uint64_t content_hash) {
+  return content_hash != 0 ? content_hash | (uint64_t{1} << 63)
+                           : picture.uniqueID();
+}
+
+bool RasterCache::EntryMatchesPicture(const Entry& entry,
+                                      const SkPicture& picture) {
+  return entry.picture_id == picture.uniqueID() ||
+         (entry.cull_rect == picture.cullRect() &&
+          entry.op_count == picture.approximateOpCount());
+}
+
 static bool IsPictureWorthRasterizing(SkPicture* picture,
                                       bool will_change,
                                       bool is_complex) {
@@ -88,7 +104,7 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
 }
 
 /// @note Procedure doesn't copy all closures.
-static std::unique_ptr<RasterCacheResult> Rasterize(
+static sk_sp<SkImage> RasterizeImage(
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
@@ -120,8 +136,163 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
     DrawCheckerboard(canvas, logical_rect);
   }
 
-  return std::make_unique<RasterCacheResult>(surface->makeImageSnapshot(),
-                                             logical_rect);
+  return surface->makeImageSnapshot();
+}
+
+/// @note Procedure doesn't copy all closures.
+static std::unique_ptr<RasterCacheResult> Rasterize(
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  sk_sp<SkImage> image = RasterizeImage(context, ctm, dst_color_space,
+                                        checkerboard, logical_rect,
+                                        draw_function);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect);
+}
+
+/// Plays back a picture to find out whether it can be rasterized on a thread
+/// other than the raster thread. Images, drawables and the shaders, filters
+/// and mask filters of paints may all reference textures of a GPU context
+/// that is bound to another thread.
+class WorkerRasterizabilityCanvas : public SkNoDrawCanvas {
+ public:
+  explicit WorkerRasterizabilityCanvas(const SkRect& bounds)
+      : SkNoDrawCanvas(bounds.roundOut()) {}
+
+  bool can_rasterize_on_worker() const { return can_rasterize_on_worker_; }
+
+ protected:
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    CheckPaint(rec.fPaint);
+    if (rec.fBackdrop) {
+      can_rasterize_on_worker_ = false;
+    }
+    return SkNoDrawCanvas::getSaveLayerStrategy(rec);
+  }
+
+  void onDrawPaint(const SkPaint& paint) override { CheckPaint(&paint); }
+  void onDrawBehind(const SkPaint& paint) override { CheckPaint(&paint); }
+  void onDrawPoints(PointMode,
+                    size_t,
+                    const SkPoint[],
+                    const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawRect(const SkRect&, const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawRegion(const SkRegion&, const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawOval(const SkRect&, const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawArc(const SkRect&,
+                 SkScalar,
+                 SkScalar,
+                 bool,
+                 const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawRRect(const SkRRect&, const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawDRRect(const SkRRect&,
+                    const SkRRect&,
+                    const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawPath(const SkPath&, const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawTextBlob(const SkTextBlob*,
+                      SkScalar,
+                      SkScalar,
+                      const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawPatch(const SkPoint[12],
+                   const SkColor[4],
+                   const SkPoint[4],
+                   SkBlendMode,
+                   const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+  void onDrawVerticesObject(const SkVertices*,
+                            SkBlendMode,
+                            const SkPaint& paint) override {
+    CheckPaint(&paint);
+  }
+
+  void onDrawImage(const SkImage*,
+                   SkScalar,
+                   SkScalar,
+                   const SkPaint*) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawImageRect(const SkImage*,
+                       const SkRect*,
+                       const SkRect&,
+                       const SkPaint*,
+                       SrcRectConstraint) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawImageNine(const SkImage*,
+                       const SkIRect&,
+                       const SkRect&,
+                       const SkPaint*) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawImageLattice(const SkImage*,
+                          const Lattice&,
+                          const SkRect&,
+                          const SkPaint*) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawAtlas(const SkImage*,
+                   const SkRSXform[],
+                   const SkRect[],
+                   const SkColor[],
+                   int,
+                   SkBlendMode,
+                   const SkRect*,
+                   const SkPaint*) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawEdgeAAImageSet(const ImageSetEntry[],
+                            int,
+                            const SkPoint[],
+                            const SkMatrix[],
+                            const SkPaint*,
+                            SrcRectConstraint) override {
+    can_rasterize_on_worker_ = false;
+  }
+  void onDrawDrawable(SkDrawable*, const SkMatrix*) override {
+    can_rasterize_on_worker_ = false;
+  }
+
+ private:
+  bool can_rasterize_on_worker_ = true;
+
+  void CheckPaint(const SkPaint* paint) {
+    if (paint && (paint->getShader() || paint->getImageFilter() ||
+                  paint->getMaskFilter())) {
+      can_rasterize_on_worker_ = false;
+    }
+  }
+};
+
+static bool CanRasterizeOnWorker(SkPicture* picture) {
+  TRACE_EVENT0("flutter", "RasterCache::CanRasterizeOnWorker");
+  WorkerRasterizabilityCanvas canvas(picture->cullRect());
+  picture->playback(&canvas);
+  return canvas.can_rasterize_on_worker();
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
@@ -138,6 +309,11 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
+  PrepareRequest request;
+  request.layer = layer;
+  request.matrix = ctm;
+  prepare_requests_.push_back(request);
+
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
@@ -183,12 +359,24 @@ bool RasterCache::Prepare(GrDirectContext* context,
                           const SkMatrix& transformation_matrix,
                           SkColorSpace* dst_color_space,
                           bool is_complex,
-                          bool will_change) {
+                          bool will_change,
+                          uint64_t content_hash) {
+  PrepareRequest request;
+  request.picture = picture;
+  request.matrix = transformation_matrix;
+  request.is_complex = is_complex;
+  request.will_change = will_change;
+  request.content_hash = content_hash;
+  prepare_requests_.push_back(request);
+
   // Disabling caching when access_threshold is zero is historic behavior.
   if (access_threshold_ == 0) {
     return false;
   }
-  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+  // Asynchronous rasterization applies the limit to the pictures it starts
+  // rasterizing, not to the ones that are ready.
+  if (!worker_task_runner_ &&
+      picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
     return false;
   }
   if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
@@ -205,16 +393,29 @@ bool RasterCache::Prepare(GrDirectContext* context,
     return false;
   }
 
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
+  PictureRasterCacheKey cache_key(GetPictureId(*picture, content_hash),
+                                  transformation_matrix);
 
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
+  if (!EntryMatchesPicture(entry, *picture)) {
+    // Another picture has the same content hash. Rasterize this one instead.
+    entry.image.reset();
+    entry.async_result.reset();
+  }
+  entry.picture_id = picture->uniqueID();
+  entry.cull_rect = picture->cullRect();
+  entry.op_count = picture->approximateOpCount();
   if (entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
     return false;
   }
 
   if (!entry.image) {
+    if (worker_task_runner_) {
+      return PrepareAsync(entry, context, picture, transformation_matrix,
+                          dst_color_space);
+    }
     entry.image = RasterizePicture(picture, context, transformation_matrix,
                                    dst_color_space, checkerboard_images_);
     picture_cached_this_frame_++;
@@ -222,14 +423,94 @@ bool RasterCache::Prepare(GrDirectContext* context,
   return true;
 }
 
-bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
-  PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
+bool RasterCache::PrepareAsync(Entry& entry,
+                               GrDirectContext* context,
+                               SkPicture* picture,
+                               const SkMatrix& transformation_matrix,
+                               SkColorSpace* dst_color_space) {
+  if (entry.async_result) {
+    sk_sp<SkImage> image;
+    {
+      std::scoped_lock lock(entry.async_result->mutex);
+      if (!entry.async_result->done) {
+        // Keep drawing the picture directly until the image is ready.
+        return false;
+      }
+      image = std::move(entry.async_result->image);
+    }
+    entry.async_result.reset();
+    if (!image) {
+      return false;
+    }
+    if (context) {
+      TRACE_EVENT0("flutter", "RasterCacheUpload");
+      image = image->makeTextureImage(context);
+      if (!image) {
+        return false;
+      }
+    }
+    entry.image = std::make_unique<RasterCacheResult>(std::move(image),
+                                                      picture->cullRect());
+    return true;
+  }
+
+  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    return false;
+  }
+  picture_cached_this_frame_++;
+
+  if (!CanRasterizeOnWorker(picture)) {
+    entry.image = RasterizePicture(picture, context, transformation_matrix,
+                                   dst_color_space, checkerboard_images_);
+    return true;
+  }
+
+  // The worker only holds on to the result, so an entry that is evicted
+  // before the task runs simply drops the image.
+  entry.async_result = std::make_shared<AsyncResult>();
+  worker_task_runner_->PostTask(
+      [result = entry.async_result, picture = sk_ref_sp(picture),
+       matrix = transformation_matrix,
+       color_space = sk_ref_sp(dst_color_space),
+       checkerboard = checkerboard_images_]() {
+        sk_sp<SkImage> image = RasterizeImage(
+            nullptr, matrix, color_space.get(), checkerboard,
+            picture->cullRect(),
+            [&picture](SkCanvas* canvas) { canvas->drawPicture(picture); });
+        std::scoped_lock lock(result->mutex);
+        result->image = std::move(image);
+        result->done = true;
+      });
+  return false;
+}
+
+void RasterCache::Replay(PrerollContext* context,
+                         const std::vector<PrepareRequest>& requests) {
+  for (const PrepareRequest& request : requests) {
+    if (request.picture) {
+      Prepare(context->gr_context, request.picture, request.matrix,
+              context->dst_color_space, request.is_complex,
+              request.will_change, request.content_hash);
+    } else {
+      Prepare(context, request.layer, request.matrix);
+    }
+  }
+}
+
+bool RasterCache::Draw(const SkPicture& picture,
+                       SkCanvas& canvas,
+                       uint64_t content_hash) const {
+  PictureRasterCacheKey cache_key(GetPictureId(picture, content_hash),
+                                  canvas.getTotalMatrix());
   auto it = picture_cache_.find(cache_key);
   if (it == picture_cache_.end()) {
     return false;
   }
 
   Entry& entry = it->second;
+  if (!EntryMatchesPicture(entry, picture)) {
+    return false;
+  }
   entry.access_count++;
   entry.used_this_frame = true;
 
@@ -263,12 +544,47 @@ bool RasterCache::Draw(const Layer* layer,
 }
 
 void RasterCache::SweepAfterFrame() {
-  SweepOneCacheAfterFrame(picture_cache_);
-  SweepOneCacheAfterFrame(layer_cache_);
+  size_t cache_bytes = 0;
+  SweepOneCacheAfterFrame(picture_cache_, &cache_bytes);
+  SweepOneCacheAfterFrame(layer_cache_, &cache_bytes);
+  if (max_bytes_ != 0 && cache_bytes > max_bytes_) {
+    EvictLeastRecentlyUsed(cache_bytes);
+  }
   picture_cached_this_frame_ = 0;
+  prepare_requests_.clear();
   TraceStatsToTimeline();
 }
 
+void RasterCache::EvictLeastRecentlyUsed(size_t cache_bytes) {
+  TRACE_EVENT0("flutter", "RasterCache::EvictLeastRecentlyUsed");
+  std::vector<Entry*> candidates;
+  for (auto& item : picture_cache_) {
+    if (item.second.image && item.second.unused_frames > 0) {
+      candidates.push_back(&item.second);
+    }
+  }
+  for (auto& item : layer_cache_) {
+    if (item.second.image && item.second.unused_frames > 0) {
+      candidates.push_back(&item.second);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->unused_frames > b->unused_frames;
+            });
+
+  for (Entry* entry : candidates) {
+    if (cache_bytes <= max_bytes_) {
+      break;
+    }
+    cache_bytes -= entry->image->image_bytes();
+    // Keep the entry itself so that it ages out normally, but make it earn
+    // its place in the cache again before it is rasterized.
+    entry->image.reset();
+    entry->access_count = 0;
+  }
+}
+
 void RasterCache::Clear() {
   picture_cache_.clear();
   layer_cache_.clear();
@@ -298,6 +614,19 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetWorkerTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> worker_task_runner) {
+  worker_task_runner_ = std::move(worker_task_runner);
+}
+
+void RasterCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+}
+
+void RasterCache::SetMaxUnusedFrames(size_t max_unused_frames) {
+  max_unused_frames_ = max_unused_frames;
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "RasterCache", reinterpret_cast<int64_t>(this),
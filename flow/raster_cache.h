@@ -6,12 +6,16 @@
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -41,6 +45,17 @@ struct PrerollContext;
 
 class RasterCache {
  public:
+  // A call to one of the Prepare() methods. Exactly one of |picture| and
+  // |layer| is set.
+  struct PrepareRequest {
+    SkPicture* picture = nullptr;
+    Layer* layer = nullptr;
+    SkMatrix matrix;
+    bool is_complex = false;
+    bool will_change = false;
+    uint64_t content_hash = 0;
+  };
+
   // The default max number of picture raster caches to be generated per frame.
   // Generating too many caches in one frame may cause jank on that frame. This
   // limit allows us to throttle the cache and distribute the work across
@@ -132,19 +147,39 @@ class RasterCache {
   // 3. The picture is accessed too few times
   // 4. There are too many pictures to be cached in the current frame.
   //    (See also kDefaultPictureCacheLimitPerFrame.)
+  //
+  // A non-zero |content_hash| identifies the content of the picture, so that
+  // a different picture with the same content uses the same cache entry.
   bool Prepare(GrDirectContext* context,
                SkPicture* picture,
                const SkMatrix& transformation_matrix,
                SkColorSpace* dst_color_space,
                bool is_complex,
-               bool will_change);
+               bool will_change,
+               uint64_t content_hash = 0);
 
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
+  // The Prepare() calls made since the last call to SweepAfterFrame(), in the
+  // order they were made.
+  const std::vector<PrepareRequest>& prepare_requests() const {
+    return prepare_requests_;
+  }
+
+  // Repeats Prepare() calls recorded in an earlier frame. This lets a layer
+  // whose subtree has not changed skip its Preroll while still keeping the
+  // cache entries of the subtree alive. The pictures and layers referenced by
+  // |requests| must still be alive.
+  void Replay(PrerollContext* context,
+              const std::vector<PrepareRequest>& requests);
+
   // Find the raster cache for the picture and draw it to the canvas.
+  // |content_hash| must be the hash the picture was prepared with.
   //
   // Return true if it's found and drawn.
-  bool Draw(const SkPicture& picture, SkCanvas& canvas) const;
+  bool Draw(const SkPicture& picture,
+            SkCanvas& canvas,
+            uint64_t content_hash = 0) const;
 
   // Find the raster cache for the layer and draw it to the canvas.
   //
@@ -162,6 +197,37 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // Limits the total size of the cached images to |max_bytes|, or removes the
+  // limit if it is 0. Whenever a frame leaves the cache above the limit, the
+  // entries that were used least recently are evicted first. Entries used by
+  // the last frame are never evicted to stay within the limit, since they are
+  // likely to be needed by the next frame as well.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  // Keeps entries in the cache for |max_unused_frames| frames after the last
+  // frame that used them, so that content that briefly goes out of view (e.g.
+  // when scrolling back and forth) does not need to be rasterized again. With
+  // the default of 0, entries are evicted after the first frame that does not
+  // use them.
+  void SetMaxUnusedFrames(size_t max_unused_frames);
+
+  size_t max_unused_frames() const { return max_unused_frames_; }
+
+  // Rasterizes pictures on |worker_task_runner| instead of the raster thread,
+  // or synchronously again if it is null.
+  //
+  // A picture that is ready to be cached is then drawn directly until its
+  // image is available, which is usually the next frame. Pictures are
+  // rasterized with the CPU on the workers and their images are uploaded on
+  // the raster thread. Pictures that draw images or use paints that may
+  // reference images (e.g. through shaders or filters) are still rasterized
+  // synchronously since their images may be backed by textures of a GPU
+  // context that cannot be used from the workers.
+  void SetWorkerTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> worker_task_runner);
+
   size_t GetCachedEntriesCount() const;
 
   size_t GetLayerCachedEntriesCount() const;
@@ -189,22 +255,48 @@ class RasterCache {
   size_t EstimateLayerCacheByteSize() const;
 
  private:
+  // A picture being rasterized on a worker thread.
+  struct AsyncResult {
+    std::mutex mutex;
+    bool done = false;
+    sk_sp<SkImage> image;
+  };
+
   struct Entry {
     bool used_this_frame = false;
     size_t access_count = 0;
+    // The number of frames swept since the entry was last used.
+    size_t unused_frames = 0;
     std::unique_ptr<RasterCacheResult> image;
+    std::shared_ptr<AsyncResult> async_result;
+    // The picture a picture entry was created for. Pictures cached under a
+    // content hash only reuse the entry of another picture if its cull rect
+    // and op count also match, so that a hash collision is not drawn.
+    uint32_t picture_id = 0;
+    SkRect cull_rect = SkRect::MakeEmpty();
+    int op_count = 0;
   };
 
+  // Whether |entry| can be used to draw |picture|.
+  static bool EntryMatchesPicture(const Entry& entry, const SkPicture& picture);
+
   template <class Cache>
-  static void SweepOneCacheAfterFrame(Cache& cache) {
+  void SweepOneCacheAfterFrame(Cache& cache, size_t* cache_bytes) {
     std::vector<typename Cache::iterator> dead;
 
     for (auto it = cache.begin(); it != cache.end(); ++it) {
       Entry& entry = it->second;
-      if (!entry.used_this_frame) {
-        dead.push_back(it);
+      if (entry.used_this_frame) {
+        entry.unused_frames = 0;
+      } else {
+        entry.unused_frames++;
       }
       entry.used_this_frame = false;
+      if (entry.unused_frames > max_unused_frames_) {
+        dead.push_back(it);
+      } else if (entry.image) {
+        *cache_bytes += entry.image->image_bytes();
+      }
     }
 
     for (auto it : dead) {
@@ -212,9 +304,21 @@ class RasterCache {
     }
   }
 
+  void EvictLeastRecentlyUsed(size_t cache_bytes);
+
+  bool PrepareAsync(Entry& entry,
+                    GrDirectContext* context,
+                    SkPicture* picture,
+                    const SkMatrix& transformation_matrix,
+                    SkColorSpace* dst_color_space);
+
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
+  size_t max_bytes_ = 0;
+  size_t max_unused_frames_ = 0;
   size_t picture_cached_this_frame_ = 0;
+  std::vector<PrepareRequest> prepare_requests_;
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
   bool checkerboard_images_;
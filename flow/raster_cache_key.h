@@ -49,8 +49,9 @@ class RasterCacheKey {
   SkMatrix matrix_;
 };
 
-// The ID is the uint32_t picture uniqueID
-using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is the uint32_t picture uniqueID, or a hash of the content of the
+// picture with the top bit set.
+using PictureRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
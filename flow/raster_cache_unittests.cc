@@ -4,8 +4,12 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -24,6 +28,25 @@ sk_sp<SkPicture> GetSamplePicture() {
   return recorder.finishRecordingAsPicture();
 }
 
+// Runs the posted tasks only when asked to.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t pending_task_count() const { return tasks_.size(); }
+
+  void RunPendingTasks() {
+    auto tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -65,6 +88,69 @@ TEST(RasterCache, ThresholdIsRespected) {
   ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, PicturesWithTheSameContentHashShareAnEntry) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  const uint64_t content_hash = 42;
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  // Every frame records a new picture with the same content.
+  for (int frame = 0; frame < 2; frame++) {
+    auto picture = GetSamplePicture();
+    ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                               false, content_hash));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas, content_hash));
+    cache.SweepAfterFrame();
+  }
+
+  auto picture = GetSamplePicture();
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false, content_hash));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas, content_hash));
+  ASSERT_TRUE(cache.Draw(*GetSamplePicture(), dummy_canvas, content_hash));
+  // Without the hash the picture is looked up by its unique ID.
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, PicturesWithACollidingContentHashDoNotShareAnEntry) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  const uint64_t content_hash = 42;
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  auto picture = GetSamplePicture();
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false, content_hash));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas, content_hash));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false, content_hash));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas, content_hash));
+
+  // A different picture with the same hash is not drawn from the entry.
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  recorder.getRecordingCanvas()->drawCircle(50, 50, 40, paint);
+  recorder.getRecordingCanvas()->drawCircle(50, 50, 20, paint);
+  auto other_picture = recorder.finishRecordingAsPicture();
+  ASSERT_FALSE(cache.Draw(*other_picture, dummy_canvas, content_hash));
+
+  // Preparing it rasterizes it in place of the first picture.
+  ASSERT_TRUE(cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(),
+                            true, false, content_hash));
+  ASSERT_TRUE(cache.Draw(*other_picture, dummy_canvas, content_hash));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas, content_hash));
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCaching) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -132,6 +218,177 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
   ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, SweepsKeepEntriesForMaxUnusedFrames) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxUnusedFrames(2);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // Two frames without an access keep the entry.
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // After the access, two frames without one still keep the entry, and the
+  // third evicts it.
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, MaxBytesEvictsLeastRecentlyUsedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxUnusedFrames(10);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto old_picture = GetSamplePicture();
+  auto recent_picture = GetSamplePicture();
+  auto current_picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (auto& picture : {old_picture, recent_picture, current_picture}) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+    ASSERT_TRUE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 3u);
+
+  // Room for two of the three images.
+  const size_t picture_bytes = cache.EstimatePictureCacheByteSize() / 3;
+  cache.SetMaxBytes(2 * picture_bytes);
+  ASSERT_TRUE(cache.Draw(*current_picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 2 * picture_bytes);
+  ASSERT_FALSE(cache.Draw(*old_picture, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*recent_picture, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*current_picture, dummy_canvas));
+}
+
+TEST(RasterCache, MaxBytesDoesNotEvictEntriesUsedByLastFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(1);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, AsyncRasterizationIsAvailableInALaterFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  cache.SetWorkerTaskRunner(task_runner);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // The picture is handed to the workers and drawn directly for now.
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(task_runner->pending_task_count(), 1u);
+  cache.SweepAfterFrame();
+
+  // Still not done.
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(task_runner->pending_task_count(), 1u);
+  cache.SweepAfterFrame();
+
+  task_runner->RunPendingTasks();
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(task_runner->pending_task_count(), 0u);
+}
+
+TEST(RasterCache, AsyncRasterizationKeepsPicturesWithImagesOnRasterThread) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  cache.SetWorkerTaskRunner(task_runner);
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(10, 10);
+  bitmap.eraseColor(SK_ColorBLUE);
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  recorder.getRecordingCanvas()->drawImage(SkImage::MakeFromBitmap(bitmap), 10,
+                                           10);
+  recorder.getRecordingCanvas()->drawRect(SkRect::MakeXYWH(30, 30, 80, 60),
+                                          SkPaint());
+  auto picture = recorder.finishRecordingAsPicture();
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(task_runner->pending_task_count(), 0u);
+}
+
 // Construct a cache result whose device target rectangle rounds out to be one
 // pixel wider than the cached image.  Verify that it can be drawn without
 // triggering any assertions.
@@ -4,7 +4,7 @@
 
 #include "rtree.h"
 
-#include <list>
+#include <algorithm>
 
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkBBHFactory.h"
@@ -18,9 +18,11 @@ void RTree::insert(const SkRect boundsArray[],
                    int N) {
   FML_DCHECK(0 == all_ops_count_);
   bbh_->insert(boundsArray, metadata, N);
-  for (int i = 0; i < N; i++) {
-    if (metadata != nullptr && metadata[i].isDraw) {
-      draw_op_[i] = boundsArray[i];
+  op_bounds_.assign(boundsArray, boundsArray + N);
+  op_is_draw_.assign(N, false);
+  if (metadata != nullptr) {
+    for (int i = 0; i < N; i++) {
+      op_is_draw_[i] = metadata[i].isDraw;
     }
   }
   all_ops_count_ = N;
@@ -34,51 +36,73 @@ void RTree::search(const SkRect& query, std::vector<int>* results) const {
   bbh_->search(query, results);
 }
 
-std::list<SkRect> RTree::searchNonOverlappingDrawnRects(
+std::vector<SkRect> RTree::searchNonOverlappingDrawnRects(
     const SkRect& query) const {
-  // Get the indexes for the operations that intersect with the query rect.
-  std::vector<int> intermediary_results;
-  search(query, &intermediary_results);
+  std::vector<SkRect> results;
+  searchNonOverlappingDrawnRects(query, &results);
+  return results;
+}
 
-  std::list<SkRect> final_results;
-  for (int index : intermediary_results) {
-    auto draw_op = draw_op_.find(index);
+void RTree::searchNonOverlappingDrawnRects(
+    const SkRect& query,
+    std::vector<SkRect>* results,
+    std::vector<int>* search_scratch) const {
+  results->clear();
+
+  // Get the indexes for the operations that intersect with the query rect.
+  std::vector<int> local_search_results;
+  std::vector<int>& search_results =
+      search_scratch ? *search_scratch : local_search_results;
+  search_results.clear();
+  search(query, &search_results);
+  for (int index : search_results) {
     // Ignore records that don't draw anything.
-    if (draw_op == draw_op_.end()) {
-      continue;
+    if (op_is_draw_[index] && !op_bounds_[index].isEmpty()) {
+      results->push_back(op_bounds_[index]);
     }
-    auto current_record_rect = draw_op->second;
-    auto replaced_existing_rect = false;
-    // // If the current record rect intersects with any of the rects in the
-    // // result list, then join them, and update the rect in final_results.
-    std::list<SkRect>::iterator curr_rect_itr = final_results.begin();
-    std::list<SkRect>::iterator first_intersecting_rect_itr;
-    while (!replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, current_record_rect)) {
-        replaced_existing_rect = true;
-        first_intersecting_rect_itr = curr_rect_itr;
-        curr_rect_itr->join(current_record_rect);
+  }
+
+  // Join the intersecting rects with a sweep from left to right. A rect only
+  // needs to be compared with the rects that start before its right edge.
+  // Joining may grow a rect vertically so that it intersects a rect it was
+  // already compared with, so repeat until a sweep joins nothing. Joined rects
+  // are emptied and compacted away after each sweep.
+  auto by_left = [](const SkRect& a, const SkRect& b) {
+    return a.fLeft < b.fLeft;
+  };
+  std::vector<SkRect>& rects = *results;
+  bool joined = true;
+  while (joined) {
+    joined = false;
+    std::sort(rects.begin(), rects.end(), by_left);
+    for (size_t i = 0; i < rects.size(); i++) {
+      SkRect& current = rects[i];
+      if (current.isEmpty()) {
+        continue;
       }
-      curr_rect_itr++;
-    }
-    // It's possible that the result contains duplicated rects at this point.
-    // For example, consider a result list that contains rects A, B. If a
-    // new rect C is a superset of A and B, then A and B are the same set after
-    // the merge. As a result, find such cases and remove them from the result
-    // list.
-    while (replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, *first_intersecting_rect_itr)) {
-        first_intersecting_rect_itr->join(*curr_rect_itr);
-        curr_rect_itr = final_results.erase(curr_rect_itr);
-      } else {
-        curr_rect_itr++;
+      for (size_t j = i + 1; j < rects.size(); j++) {
+        SkRect& other = rects[j];
+        if (other.isEmpty()) {
+          continue;
+        }
+        if (other.fLeft >= current.fRight) {
+          break;
+        }
+        if (SkRect::Intersects(current, other)) {
+          current.join(other);
+          other.setEmpty();
+          joined = true;
+        }
       }
     }
-    if (!replaced_existing_rect) {
-      final_results.push_back(current_record_rect);
+    if (joined) {
+      rects.erase(std::remove_if(rects.begin(), rects.end(),
+                                 [](const SkRect& rect) {
+                                   return rect.isEmpty();
+                                 }),
+                  rects.end());
     }
   }
-  return final_results;
 }
 
 size_t RTree::bytesUsed() const {
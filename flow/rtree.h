@@ -5,8 +5,7 @@
 #ifndef FLUTTER_FLOW_RTREE_H_
 #define FLUTTER_FLOW_RTREE_H_
 
-#include <list>
-#include <map>
+#include <vector>
 
 #include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkTypes.h"
@@ -34,16 +33,26 @@ class RTree : public SkBBoxHierarchy {
   //
   // When two rects intersect with each other, they are joined into a single
   // rect which also intersects with the query rect. In other words, the bounds
-  // of each rect in the result list are mutually exclusive.
-  std::list<SkRect> searchNonOverlappingDrawnRects(const SkRect& query) const;
+  // of each rect in the result list are mutually exclusive. Empty rects are
+  // not included. The results are sorted by their left edge.
+  std::vector<SkRect> searchNonOverlappingDrawnRects(const SkRect& query) const;
+
+  // Same as above, but reuses the storage of |results|, which is cleared
+  // first. If |search_scratch| is not null, its storage is used for the
+  // intermediate r-tree search instead of a new vector.
+  void searchNonOverlappingDrawnRects(
+      const SkRect& query,
+      std::vector<SkRect>* results,
+      std::vector<int>* search_scratch = nullptr) const;
 
   // Insertion count (not overall node count, which may be greater).
   int getCount() const { return all_ops_count_; }
 
  private:
-  // A map containing the draw operation rects keyed off the operation index
-  // in the insert call.
-  std::map<int, SkRect> draw_op_;
+  // The bounds of the operations, indexed by the operation index in the
+  // insert call, and whether each of them draws anything.
+  std::vector<SkRect> op_bounds_;
+  std::vector<bool> op_is_draw_;
   sk_sp<SkBBoxHierarchy> bbh_;
   int all_ops_count_;
 };
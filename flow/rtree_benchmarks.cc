@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/rtree.h"
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+
+// Records a picture that resembles a page of text: |state.range(0)| rows of
+// small, mostly disjoint rects covering a 1000x1000 canvas.
+static sk_sp<RTree> RecordTextLikePicture(benchmark::State& state) {
+  RTreeFactory rtree_factory;
+  SkPictureRecorder recorder;
+  SkCanvas* canvas =
+      recorder.beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  const int rows = state.range(0);
+  const int glyphs_per_row = 50;
+  const SkScalar row_height = 1000.0f / rows;
+  SkPaint paint;
+  for (int row = 0; row < rows; row++) {
+    for (int glyph = 0; glyph < glyphs_per_row; glyph++) {
+      // Every fifth glyph touches its neighbour to exercise the joins.
+      const SkScalar width = glyph % 5 == 0 ? 21.0f : 16.0f;
+      canvas->drawRect(SkRect::MakeXYWH(glyph * 20.0f, row * row_height, width,
+                                        row_height * 0.8f),
+                       paint);
+    }
+  }
+  recorder.finishRecordingAsPicture();
+  return rtree_factory.getInstance();
+}
+
+static void BM_SearchNonOverlappingDrawnRects(benchmark::State& state) {
+  sk_sp<RTree> rtree = RecordTextLikePicture(state);
+  // A platform view covering the middle of the page.
+  const SkRect query = SkRect::MakeLTRB(200, 200, 800, 800);
+  while (state.KeepRunning()) {
+    std::vector<SkRect> results = rtree->searchNonOverlappingDrawnRects(query);
+    benchmark::DoNotOptimize(results);
+  }
+}
+
+static void BM_SearchNonOverlappingDrawnRectsReusingResults(
+    benchmark::State& state) {
+  sk_sp<RTree> rtree = RecordTextLikePicture(state);
+  const SkRect query = SkRect::MakeLTRB(200, 200, 800, 800);
+  std::vector<SkRect> results;
+  while (state.KeepRunning()) {
+    rtree->searchNonOverlappingDrawnRects(query, &results);
+    benchmark::DoNotOptimize(results);
+  }
+}
+
+BENCHMARK(BM_SearchNonOverlappingDrawnRects)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_SearchNonOverlappingDrawnRectsReusingResults)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -231,5 +231,80 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase3) {
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(50, 50, 620, 300));
 }
 
+TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase4) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  // Given the A, B and C rects that intersect with the query rect, where B
+  // only intersects with the union of A and C, the result list contains a
+  // single rect, which is the union of these three rects.
+  //
+  // +-----+
+  // |  A  |
+  // |  +--|-----+
+  // +--|--+     |
+  //    |  C     |
+  //    |     +--|--+
+  //    +-----|--+  |
+  //          |  B  |
+  //          +-----+
+
+  // A
+  recording_canvas->drawRect(SkRect::MakeLTRB(100, 100, 200, 200), rect_paint);
+  // B
+  recording_canvas->drawRect(SkRect::MakeLTRB(250, 350, 350, 450), rect_paint);
+  // C
+  recording_canvas->drawRect(SkRect::MakeLTRB(150, 150, 300, 400), rect_paint);
+
+  recorder->finishRecordingAsPicture();
+
+  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000));
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 350, 450));
+}
+
+TEST(RTree, searchNonOverlappingDrawnRectsReusesResults) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  recording_canvas->drawRect(SkRect::MakeLTRB(100, 100, 200, 200), rect_paint);
+  recording_canvas->drawRect(SkRect::MakeLTRB(300, 100, 400, 200), rect_paint);
+
+  recorder->finishRecordingAsPicture();
+
+  // Any previous content of the results is discarded.
+  std::vector<SkRect> hits = {SkRect::MakeLTRB(0, 0, 10, 10)};
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000), &hits);
+  ASSERT_EQ(2UL, hits.size());
+  ASSERT_EQ(hits[0], SkRect::MakeLTRB(100, 100, 200, 200));
+  ASSERT_EQ(hits[1], SkRect::MakeLTRB(300, 100, 400, 200));
+
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(250, 0, 1000, 1000), &hits);
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(hits[0], SkRect::MakeLTRB(300, 100, 400, 200));
+
+  // Stale indexes left in the scratch vector don't leak into the results.
+  std::vector<int> search_scratch = {0, 1};
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 250, 1000), &hits, &search_scratch);
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(hits[0], SkRect::MakeLTRB(100, 100, 200, 200));
+}
+
 }  // namespace testing
 }  // namespace flutter
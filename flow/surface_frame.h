@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_SURFACE_FRAME_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/fml/macros.h"
@@ -21,6 +22,30 @@ class SurfaceFrame {
   using SubmitCallback =
       std::function<bool(const SurfaceFrame& surface_frame, SkCanvas* canvas)>;
 
+  // Information about the buffer backing the frame.
+  struct FramebufferInfo {
+    // Whether the buffer keeps its content from the last time it was
+    // presented, so that it is enough to repaint only the part of the frame
+    // that changed.
+    bool supports_partial_repaint = false;
+
+    // The area of the buffer whose content is older than the last frame
+    // presented to the surface, e.g. because the buffer was last presented
+    // several frames ago. Only meaningful if |supports_partial_repaint| is
+    // true. std::nullopt means the buffer content is undefined.
+    std::optional<SkIRect> existing_damage;
+  };
+
+  // Information about the frame content that is passed to the submit
+  // callback.
+  struct SubmitInfo {
+    // The area of the frame that changed since the last frame, if known.
+    std::optional<SkIRect> frame_damage;
+
+    // The area of the buffer that was repainted, if known.
+    std::optional<SkIRect> buffer_damage;
+  };
+
   SurfaceFrame(sk_sp<SkSurface> surface,
                bool supports_readback,
                const SubmitCallback& submit_callback);
@@ -42,12 +67,26 @@ class SurfaceFrame {
 
   bool supports_readback() { return supports_readback_; }
 
+  void set_framebuffer_info(const FramebufferInfo& framebuffer_info) {
+    framebuffer_info_ = framebuffer_info;
+  }
+
+  const FramebufferInfo& framebuffer_info() const { return framebuffer_info_; }
+
+  void set_submit_info(const SubmitInfo& submit_info) {
+    submit_info_ = submit_info;
+  }
+
+  const SubmitInfo& submit_info() const { return submit_info_; }
+
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
   bool supports_readback_;
   SubmitCallback submit_callback_;
   std::unique_ptr<GLContextResult> context_result_;
+  FramebufferInfo framebuffer_info_;
+  SubmitInfo submit_info_;
 
   bool PerformSubmit();
 
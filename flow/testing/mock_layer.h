@@ -29,6 +29,7 @@ class MockLayer : public Layer {
   const SkMatrix& parent_matrix() { return parent_matrix_; }
   const SkRect& parent_cull_rect() { return parent_cull_rect_; }
   bool parent_has_platform_view() { return parent_has_platform_view_; }
+  int preroll_count() { return preroll_count_; }
 
  private:
   MutatorsStack parent_mutators_;
@@ -40,6 +41,7 @@ class MockLayer : public Layer {
   bool fake_has_platform_view_ = false;
   bool fake_needs_system_composite_ = false;
   bool fake_reads_surface_ = false;
+  int preroll_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MockLayer);
 };
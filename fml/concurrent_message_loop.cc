@@ -6,24 +6,64 @@
 
 #include <algorithm>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 
+#if OS_LINUX || OS_ANDROID
+#include <sched.h>
+#endif  // OS_LINUX || OS_ANDROID
+
 namespace fml {
 
+static void PinCurrentThreadToCPU(size_t cpu) {
+#if OS_LINUX || OS_ANDROID
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    FML_DLOG(WARNING) << "Could not pin worker thread to CPU " << cpu;
+  }
+#endif  // OS_LINUX || OS_ANDROID
+}
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
     size_t worker_count) {
+  Options options;
+  options.worker_count = worker_count;
+  return Create(options);
+}
+
+std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
+    const Options& options) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(options)};
 }
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+ConcurrentMessageLoop::ConcurrentMessageLoop(const Options& options)
+    : worker_count_(std::max<size_t>(options.worker_count, 1ul)),
+      scheduling_(options.scheduling) {
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
+  const size_t cpu_count =
+      std::max<size_t>(std::thread::hardware_concurrency(), 1ul);
+  const bool pin_workers_to_cpus = options.pin_workers_to_cpus;
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
+    workers_.emplace_back([i, cpu_count, pin_workers_to_cpus, this]() {
       fml::Thread::SetCurrentThreadName(
           std::string{"io.flutter.worker." + std::to_string(i + 1)});
-      WorkerMain();
+      if (pin_workers_to_cpus) {
+        PinCurrentThreadToCPU(i % cpu_count);
+      }
+      if (scheduling_ == Scheduling::kWorkStealing) {
+        WorkStealingWorkerMain(i);
+      } else {
+        WorkerMain();
+      }
     });
   }
 
@@ -43,6 +83,29 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
+ConcurrentMessageLoop::Scheduling ConcurrentMessageLoop::GetScheduling() const {
+  return scheduling_;
+}
+
+ConcurrentMessageLoop::Metrics ConcurrentMessageLoop::GetMetrics() const {
+  Metrics metrics;
+  metrics.tasks_executed = tasks_executed_.load(std::memory_order_relaxed);
+  metrics.tasks_stolen = tasks_stolen_.load(std::memory_order_relaxed);
+  metrics.contended_lock_acquisitions =
+      contended_lock_acquisitions_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+std::unique_lock<std::mutex> ConcurrentMessageLoop::LockAndCountContention(
+    std::mutex& mutex) {
+  std::unique_lock lock(mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    contended_lock_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
+}
+
 std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
@@ -52,7 +115,12 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
+  if (scheduling_ == Scheduling::kWorkStealing) {
+    PostWorkStealingTask(task);
+    return;
+  }
+
+  auto lock = LockAndCountContention(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
@@ -76,7 +144,7 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
 
 void ConcurrentMessageLoop::WorkerMain() {
   while (true) {
-    std::unique_lock lock(tasks_mutex_);
+    auto lock = LockAndCountContention(tasks_mutex_);
     tasks_condition_.wait(lock, [&]() {
       return tasks_.size() > 0 || shutdown_ || HasThreadTasksLocked();
     });
@@ -104,6 +172,7 @@ void ConcurrentMessageLoop::WorkerMain() {
     // Execute the primary task we woke up for.
     if (task) {
       task();
+      tasks_executed_.fetch_add(1, std::memory_order_relaxed);
     }
 
     // Execute any thread tasks.
@@ -117,8 +186,172 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
+void ConcurrentMessageLoop::PostWorkStealingTask(const fml::closure& task) {
+  // Tasks posted by a worker are most likely related to the task it is
+  // running, so they are queued on that worker. Idle workers that are woken
+  // below steal them if the poster is still busy. Tasks from other threads
+  // are spread over the workers round-robin.
+  const auto current_thread_id = std::this_thread::get_id();
+  size_t index = worker_count_;
+  for (size_t i = 0; i < worker_count_; ++i) {
+    if (worker_thread_ids_[i] == current_thread_id) {
+      index = i;
+      break;
+    }
+  }
+  if (index == worker_count_) {
+    index = next_worker_queue_.fetch_add(1, std::memory_order_relaxed) %
+            worker_count_;
+  }
+
+  // The count is raised before the task is queued so that it never drops
+  // below the number of queued tasks.
+  queued_task_count_++;
+  bool queued = false;
+  {
+    WorkerQueue& queue = *worker_queues_[index];
+    auto lock = LockAndCountContention(queue.mutex);
+    // Termination cannot be read with the queue mutex unlocked. See
+    // |Terminate|.
+    if (!terminated_) {
+      queue.tasks.push_back(task);
+      queued = true;
+    }
+  }
+
+  // Don't just drop tasks on the floor in case of shutdown.
+  if (!queued) {
+    queued_task_count_--;
+    FML_DLOG(WARNING)
+        << "Tried to post a task to shutdown concurrent message "
+           "loop. The task will be executed on the callers thread.";
+    task();
+    return;
+  }
+
+  // The global mutex is only acquired if a worker is asleep. Acquiring it
+  // before notifying ensures that the worker is either waiting on the
+  // condition variable already or will see the task before it starts waiting.
+  if (sleeping_worker_count_ > 0) {
+    { std::scoped_lock lock(tasks_mutex_); }
+    tasks_condition_.notify_one();
+  }
+}
+
+bool ConcurrentMessageLoop::PopWorkStealingTask(size_t index,
+                                                fml::closure* task) {
+  if (queued_task_count_ == 0) {
+    return false;
+  }
+
+  {
+    WorkerQueue& queue = *worker_queues_[index];
+    auto lock = LockAndCountContention(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      queued_task_count_--;
+      return true;
+    }
+  }
+
+  // Steal from the back of the other queues, away from the tasks their owners
+  // are about to run. Queues whose lock is held are skipped on the first pass
+  // so that idle workers don't convoy on a busy one.
+  for (size_t pass = 0; pass < 2; ++pass) {
+    for (size_t offset = 1; offset < worker_count_; ++offset) {
+      WorkerQueue& victim = *worker_queues_[(index + offset) % worker_count_];
+      std::unique_lock<std::mutex> lock;
+      if (pass == 0) {
+        lock = std::unique_lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+          contended_lock_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+      } else {
+        lock = std::unique_lock(victim.mutex);
+      }
+      if (!victim.tasks.empty()) {
+        *task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        queued_task_count_--;
+        tasks_stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ConcurrentMessageLoop::WorkStealingWorkerMain(size_t index) {
+  WorkerQueue& queue = *worker_queues_[index];
+  while (true) {
+    // Thread tasks are checked between tasks so that a busy worker doesn't
+    // delay them until its queue runs dry.
+    if (queue.has_thread_tasks) {
+      RunWorkStealingThreadTasks(index);
+    }
+
+    fml::closure task;
+    if (PopWorkStealingTask(index, &task)) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerTask");
+      task();
+      tasks_executed_.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    sleeping_worker_count_++;
+    tasks_condition_.wait(lock, [&]() {
+      return queued_task_count_ > 0 || shutdown_ || HasThreadTasksLocked();
+    });
+    sleeping_worker_count_--;
+
+    // Shutdown cannot be read with the task mutex unlocked.
+    bool shutdown_now = shutdown_;
+    lock.unlock();
+
+    if (shutdown_now) {
+      // No task can be queued after shutdown, so the tasks queued before it
+      // are run before exiting, taking them from the queues of the workers
+      // that have already exited too.
+      TRACE_EVENT0("flutter", "ConcurrentWorkerDrain");
+      while (PopWorkStealingTask(index, &task)) {
+        task();
+        tasks_executed_.fetch_add(1, std::memory_order_relaxed);
+      }
+      RunWorkStealingThreadTasks(index);
+      break;
+    }
+  }
+}
+
+void ConcurrentMessageLoop::RunWorkStealingThreadTasks(size_t index) {
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    worker_queues_[index]->has_thread_tasks = false;
+    if (HasThreadTasksLocked()) {
+      thread_tasks = GetThreadTasksLocked();
+    }
+  }
+
+  TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+  for (const auto& thread_task : thread_tasks) {
+    thread_task();
+  }
+}
+
 void ConcurrentMessageLoop::Terminate() {
   std::scoped_lock lock(tasks_mutex_);
+  terminated_ = true;
+  // Tasks are only queued with their queue locked and the loop not yet
+  // terminated. Once every queue has been locked, all the tasks posted before
+  // termination are queued, and the workers seeing the shutdown can drain the
+  // queues.
+  for (const auto& queue : worker_queues_) {
+    std::scoped_lock queue_lock(queue->mutex);
+  }
   shutdown_ = true;
   tasks_condition_.notify_all();
 }
@@ -132,6 +365,9 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
   for (const auto& worker_thread_id : worker_thread_ids_) {
     thread_tasks_[worker_thread_id].emplace_back(task);
   }
+  for (const auto& queue : worker_queues_) {
+    queue->has_thread_tasks = true;
+  }
   tasks_condition_.notify_all();
 }
 
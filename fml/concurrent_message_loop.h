@@ -5,8 +5,12 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <thread>
 
@@ -21,13 +25,51 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  /// How the tasks posted to the loop are distributed among its workers.
+  enum class Scheduling {
+    /// All workers take tasks from a single queue.
+    kSharedQueue,
+    /// Each worker has a queue of its own. Tasks posted from a worker are
+    /// added to the queue of that worker and all other tasks are distributed
+    /// among the queues round robin. Workers whose queue is empty steal tasks
+    /// from the queues of the other workers before going to sleep.
+    kWorkStealing,
+  };
+
+  struct Options {
+    size_t worker_count = std::thread::hardware_concurrency();
+    Scheduling scheduling = Scheduling::kSharedQueue;
+    /// Whether each worker is bound to a single CPU. This is only supported
+    /// on Linux and Android and ignored elsewhere.
+    bool pin_workers_to_cpus = false;
+  };
+
+  /// Counters describing how the workers of the loop interact. They are
+  /// updated with relaxed atomics, so a snapshot is only approximately
+  /// consistent while tasks are running.
+  struct Metrics {
+    /// The number of tasks run by the workers.
+    size_t tasks_executed = 0;
+    /// The number of tasks a worker took from the queue of another worker.
+    size_t tasks_stolen = 0;
+    /// The number of times a queue lock was already held by another thread
+    /// when it was acquired.
+    size_t contended_lock_acquisitions = 0;
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
       size_t worker_count = std::thread::hardware_concurrency());
 
+  static std::shared_ptr<ConcurrentMessageLoop> Create(const Options& options);
+
   ~ConcurrentMessageLoop();
 
   size_t GetWorkerCount() const;
 
+  Scheduling GetScheduling() const;
+
+  Metrics GetMetrics() const;
+
   std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
 
   void Terminate();
@@ -37,7 +79,16 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
-  size_t worker_count_ = 0;
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+    // Set with |tasks_mutex_| held when tasks are posted to all workers, so
+    // that a busy worker can check for them without taking that mutex.
+    std::atomic_bool has_thread_tasks = false;
+  };
+
+  const size_t worker_count_ = 0;
+  const Scheduling scheduling_;
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
@@ -46,12 +97,38 @@ class ConcurrentMessageLoop
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
 
-  ConcurrentMessageLoop(size_t worker_count);
+  // Only used with |Scheduling::kWorkStealing|. The queues are never resized
+  // after construction. |queued_task_count_| and |sleeping_worker_count_| are
+  // sequentially consistent so that a worker going to sleep either sees a
+  // task posted concurrently or is woken up by the thread posting it.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::atomic_size_t next_worker_queue_ = 0;
+  std::atomic_size_t queued_task_count_ = 0;
+  std::atomic_size_t sleeping_worker_count_ = 0;
+  // Set before |shutdown_|. Tasks are only queued while it is unset, and it is
+  // read with the queue mutex held.
+  std::atomic_bool terminated_ = false;
+
+  std::atomic_size_t tasks_executed_ = 0;
+  std::atomic_size_t tasks_stolen_ = 0;
+  std::atomic_size_t contended_lock_acquisitions_ = 0;
+
+  ConcurrentMessageLoop(const Options& options);
 
   void WorkerMain();
 
+  void WorkStealingWorkerMain(size_t index);
+
   void PostTask(const fml::closure& task);
 
+  void PostWorkStealingTask(const fml::closure& task);
+
+  bool PopWorkStealingTask(size_t index, fml::closure* task);
+
+  void RunWorkStealingThreadTasks(size_t index);
+
+  std::unique_lock<std::mutex> LockAndCountContention(std::mutex& mutex);
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FML_HASH_COMBINE_H_
 #define FLUTTER_FML_HASH_COMBINE_H_
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <type_traits>
 
 namespace fml {
 
@@ -33,6 +36,45 @@ constexpr std::size_t HashCombine(Type... args) {
   return seed;
 }
 
+// The HashCombine64 variants produce a 64-bit hash on every platform, unlike
+// the ones above whose size follows |std::size_t|. They hash the bits of
+// arguments of up to 8 bytes, such as integers, floats and enums, and are meant
+// for hashes that are trusted to identify content.
+
+template <class Type>
+inline void HashCombineSeed64(uint64_t& seed, Type arg) {
+  static_assert(std::is_trivially_copyable_v<Type> && sizeof(Type) <= 8,
+                "HashCombineSeed64 only hashes the bits of small values.");
+  uint64_t bits = 0;
+  std::memcpy(&bits, &arg, sizeof(Type));
+  uint64_t x =
+      seed ^ (bits + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+  // The splitmix64 finalizer, so that every bit of |arg| affects every bit of
+  // the result.
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  seed = x ^ (x >> 31);
+}
+
+template <class Type, class... Rest>
+inline void HashCombineSeed64(uint64_t& seed,
+                              Type arg,
+                              Rest... other_args) {
+  HashCombineSeed64(seed, arg);
+  HashCombineSeed64(seed, other_args...);
+}
+
+constexpr uint64_t HashCombine64() {
+  return 0xdabbad00dabbad00ull;
+}
+
+template <class... Type>
+inline uint64_t HashCombine64(Type... args) {
+  uint64_t seed = HashCombine64();
+  HashCombineSeed64(seed, args...);
+  return seed;
+}
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_HASH_COMBINE_H_
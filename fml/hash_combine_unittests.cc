@@ -20,5 +20,18 @@ TEST(HashCombineTest, CanHash) {
   ASSERT_EQ(HashCombine('a'), HashCombine('a'));
 }
 
+TEST(HashCombineTest, CanHash64) {
+  static_assert(
+      std::is_same_v<decltype(HashCombine64(1, 2.0f, true)), uint64_t>);
+  ASSERT_EQ(HashCombine64(), HashCombine64());
+  ASSERT_EQ(HashCombine64(12u), HashCombine64(12u));
+  ASSERT_NE(HashCombine64(12u), HashCombine64(13u));
+  ASSERT_NE(HashCombine64(1, 2), HashCombine64(2, 1));
+  ASSERT_NE(HashCombine64(1.0f), HashCombine64(1.0));
+  // Values that differ in their high bits alone hash differently.
+  ASSERT_NE(HashCombine64(uint64_t{1} << 40), HashCombine64(uint64_t{1} << 41));
+  ASSERT_NE(HashCombine64(12u) >> 32, 0u);
+}
+
 }  // namespace testing
 }  // namespace fml
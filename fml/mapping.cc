@@ -9,6 +9,12 @@
 
 namespace fml {
 
+// Mapping
+
+uint8_t* Mapping::GetMutableMapping() {
+  return nullptr;
+}
+
 // FileMapping
 
 uint8_t* FileMapping::GetMutableMapping() {
@@ -81,6 +87,10 @@ const uint8_t* DataMapping::GetMapping() const {
   return data_.data();
 }
 
+uint8_t* DataMapping::GetMutableMapping() {
+  return data_.data();
+}
+
 // NonOwnedMapping
 
 NonOwnedMapping::NonOwnedMapping(const uint8_t* data,
@@ -28,6 +28,11 @@ class Mapping {
 
   virtual const uint8_t* GetMapping() const = 0;
 
+  // The bytes of the mapping if they may be written to, or nullptr. The owner
+  // of a mutable mapping can lend its bytes out for as long as it keeps the
+  // mapping alive instead of copying them.
+  virtual uint8_t* GetMutableMapping();
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -65,7 +70,8 @@ class FileMapping final : public Mapping {
   // |Mapping|
   const uint8_t* GetMapping() const override;
 
-  uint8_t* GetMutableMapping();
+  // |Mapping|
+  uint8_t* GetMutableMapping() override;
 
   bool IsValid() const;
 
@@ -96,6 +102,9 @@ class DataMapping final : public Mapping {
   // |Mapping|
   const uint8_t* GetMapping() const override;
 
+  // |Mapping|
+  uint8_t* GetMutableMapping() override;
+
  private:
   std::vector<uint8_t> data_;
 
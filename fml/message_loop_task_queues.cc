@@ -35,7 +35,7 @@ fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>();
@@ -43,12 +43,14 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {}
+    : queue_meta_mutex_(fml::SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {}
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
@@ -59,7 +61,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
@@ -72,7 +75,8 @@ void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
 void MessageLoopTaskQueues::RegisterTask(TaskQueueId queue_id,
                                          const fml::closure& task,
                                          fml::TimePoint target_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
   queue_entry->delayed_tasks.push({order, task, target_time});
@@ -84,13 +88,15 @@ void MessageLoopTaskQueues::RegisterTask(TaskQueueId queue_id,
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -111,6 +117,34 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   return invocation;
 }
 
+static TaskQueueId MergedQueueOf(const TaskQueueEntry& entry) {
+  return entry.owner_of != _kUnmerged ? entry.owner_of : entry.subsumed_by;
+}
+
+MessageLoopTaskQueues::MergedQueuesLock MessageLoopTaskQueues::LockMergedQueues(
+    TaskQueueId queue_id) const {
+  TaskQueueEntry& entry = *queue_entries_.at(queue_id);
+  std::unique_lock lock(entry.mutex);
+  while (true) {
+    const TaskQueueId merged = MergedQueueOf(entry);
+    if (merged == _kUnmerged) {
+      return {std::move(lock), std::unique_lock<std::mutex>()};
+    }
+    TaskQueueEntry& merged_entry = *queue_entries_.at(merged);
+    if (static_cast<int>(queue_id) < static_cast<int>(merged)) {
+      return {std::move(lock), std::unique_lock(merged_entry.mutex)};
+    }
+    // The queue with the lower id has to be locked first. The queues may be
+    // unmerged while neither is locked, in which case this starts over.
+    lock.unlock();
+    std::unique_lock merged_lock(merged_entry.mutex);
+    lock.lock();
+    if (MergedQueueOf(entry) == merged) {
+      return {std::move(merged_lock), std::move(lock)};
+    }
+  }
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
   if (queue_entries_.at(queue_id)->wakeable) {
@@ -119,7 +153,8 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -139,20 +174,23 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  std::scoped_lock lock(queue_entries_.at(queue_id)->mutex);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  std::scoped_lock lock(queue_entries_.at(queue_id)->mutex);
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(queue_id);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -175,7 +213,8 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  std::scoped_lock lock(queue_entries_.at(queue_id)->mutex);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -185,9 +224,18 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
+  // Lock in id order so that concurrent merges can't deadlock.
+  std::mutex& first_mutex = static_cast<int>(owner) < static_cast<int>(subsumed)
+                                ? owner_entry->mutex
+                                : subsumed_entry->mutex;
+  std::mutex& second_mutex = &first_mutex == &owner_entry->mutex
+                                 ? subsumed_entry->mutex
+                                 : owner_entry->mutex;
+  std::scoped_lock first_lock(first_mutex);
+  std::scoped_lock second_lock(second_mutex);
 
   if (owner_entry->owner_of == subsumed) {
     return true;
@@ -214,7 +262,8 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  auto locks = LockMergedQueues(owner);
   const auto& owner_entry = queue_entries_.at(owner);
   const TaskQueueId subsumed = owner_entry->owner_of;
   if (subsumed == _kUnmerged) {
@@ -237,7 +286,8 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock meta_lock(*queue_meta_mutex_);
+  std::scoped_lock lock(queue_entries_.at(owner)->mutex);
   return subsumed == queue_entries_.at(owner)->owner_of;
 }
 
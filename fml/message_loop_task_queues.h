@@ -6,7 +6,9 @@
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
 #include <map>
+#include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -48,6 +50,12 @@ class TaskQueueEntry {
   TaskQueueId owner_of;
   TaskQueueId subsumed_by;
 
+  // Guards the fields above. |owner_of| and |subsumed_by| are only modified
+  // while holding the mutexes of both the owner and the subsumed queue, so
+  // holding the mutex of one queue is enough to find the queue it is merged
+  // with.
+  std::mutex mutex;
+
   TaskQueueEntry();
 
  private:
@@ -111,6 +119,12 @@ class MessageLoopTaskQueues
   //
   //  Methods currently aware of the merged state of the queues:
   //  HasPendingTasks, GetNextTaskToRun, GetNumPendingTasks
+  //
+  // Locking: the set of queues is guarded by a reader/writer lock that is only
+  // acquired exclusively to create and dispose queues. All other operations
+  // acquire it shared and then lock the entries of the queues they touch, so
+  // operations on unrelated queues don't contend with each other. A queue and
+  // the queue it is merged with are always locked together, lower id first.
 
   // This method returns false if either the owner or subsumed has already been
   // merged with something else.
@@ -125,10 +139,17 @@ class MessageLoopTaskQueues
  private:
   class MergedQueuesRunner;
 
+  using MergedQueuesLock =
+      std::pair<std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>;
+
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
+  // Locks the entry of |queue_id| and the entry of the queue it is merged
+  // with, if any. The caller must hold |queue_meta_mutex_|.
+  MergedQueuesLock LockMergedQueues(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
@@ -141,7 +162,7 @@ class MessageLoopTaskQueues
   static std::mutex creation_mutex_;
   static fml::RefPtr<MessageLoopTaskQueues> instance_;
 
-  mutable std::mutex queue_mutex_;
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
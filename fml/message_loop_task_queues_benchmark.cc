@@ -66,5 +66,59 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Every engine has a platform, UI, raster and IO task queue, each serviced by
+// its own thread. The threads of different engines only share the task queues
+// singleton, so the time per iteration should stay flat as engines are added.
+static void BM_RegisterAndGetTasksAcrossEngines(
+    benchmark::State& state) {  // NOLINT
+  const int num_engines = state.range(0);
+  const int num_task_queues = num_engines * 4;
+  const int num_tasks_per_queue = 100;
+
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < num_task_queues; i++) {
+    queue_ids.push_back(task_queues->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    CountDownLatch tasks_done(num_task_queues);
+    for (int i = 0; i < num_task_queues; i++) {
+      threads.emplace_back([queue_id = queue_ids[i], &task_queues,
+                            &tasks_done]() {
+        const fml::TimePoint now = fml::TimePoint::Now();
+        // Alternate between posting and running tasks, like a loop that
+        // posts follow up work.
+        for (int j = 0; j < num_tasks_per_queue; j++) {
+          task_queues->RegisterTask(
+              queue_id, [] {}, now);
+          task_queues->RegisterTask(
+              queue_id, [] {}, now);
+          task_queues->GetNextTaskToRun(queue_id, now);
+        }
+        while (task_queues->GetNextTaskToRun(queue_id, now)) {
+        }
+        tasks_done.CountDown();
+      });
+    }
+    tasks_done.Wait();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (auto queue_id : queue_ids) {
+    task_queues->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_task_queues *
+                          num_tasks_per_queue * 2);
+}
+
+BENCHMARK(BM_RegisterAndGetTasksAcrossEngines)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
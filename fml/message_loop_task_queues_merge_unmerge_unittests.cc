@@ -257,5 +257,40 @@ TEST(MessageLoopTaskQueueMergeUnmerge,
   latch.Wait();
 }
 
+TEST(MessageLoopTaskQueueMergeUnmerge,
+     MergeAndUnmergeWhileRegisteringTasksFromOtherThreads) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+
+  auto queue_id_1 = task_queue->CreateTaskQueue();
+  auto queue_id_2 = task_queue->CreateTaskQueue();
+
+  // The owner has the higher id, so merged queues are locked in the opposite
+  // order of the arguments.
+  const int kTaskCount = 1000;
+  fml::CountDownLatch latch(2);
+  auto register_tasks = [&](TaskQueueId queue_id) {
+    for (int i = 0; i < kTaskCount; i++) {
+      task_queue->RegisterTask(
+          queue_id, []() {}, fml::TimePoint::Now());
+    }
+    latch.CountDown();
+  };
+  std::thread thread_1(register_tasks, queue_id_1);
+  std::thread thread_2(register_tasks, queue_id_2);
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(task_queue->Merge(queue_id_2, queue_id_1));
+    task_queue->GetNumPendingTasks(queue_id_2);
+    ASSERT_TRUE(task_queue->Unmerge(queue_id_2));
+  }
+
+  latch.Wait();
+  thread_1.join();
+  thread_2.join();
+
+  ASSERT_EQ(CountRemainingTasks(task_queue, queue_id_1), kTaskCount);
+  ASSERT_EQ(CountRemainingTasks(task_queue, queue_id_2), kTaskCount);
+}
+
 }  // namespace testing
 }  // namespace fml
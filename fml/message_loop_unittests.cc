@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
 #include <thread>
 
@@ -316,3 +317,126 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+static fml::ConcurrentMessageLoop::Options WorkStealingOptions(
+    size_t worker_count) {
+  fml::ConcurrentMessageLoop::Options options;
+  options.worker_count = worker_count;
+  options.scheduling = fml::ConcurrentMessageLoop::Scheduling::kWorkStealing;
+  return options;
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsAllTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(WorkStealingOptions(4));
+  ASSERT_EQ(loop->GetScheduling(),
+            fml::ConcurrentMessageLoop::Scheduling::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  fml::CountDownLatch latch(kCount * 2);
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      // Tasks posted from a worker go to the queue of that worker.
+      task_runner->PostTask([&]() { latch.CountDown(); });
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  // The counter is updated after the task returns.
+  while (loop->GetMetrics().tasks_executed < kCount * 2) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(loop->GetMetrics().tasks_executed, kCount * 2);
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopStealsFromBusyWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(WorkStealingOptions(2));
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent stolen_task_ran;
+  fml::AutoResetWaitableEvent done;
+  task_runner->PostTask([&]() {
+    const auto busy_thread = std::this_thread::get_id();
+    bool ran_on_other_worker = false;
+    // This task is queued on the current worker, which stays busy until the
+    // task has run. Only the other worker can run it.
+    task_runner->PostTask([&, busy_thread]() {
+      ran_on_other_worker = std::this_thread::get_id() != busy_thread;
+      stolen_task_ran.Signal();
+    });
+    stolen_task_ran.Wait();
+    EXPECT_TRUE(ran_on_other_worker);
+    done.Signal();
+  });
+  done.Wait();
+  ASSERT_GE(loop->GetMetrics().tasks_stolen, 1u);
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsTasksOnAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(WorkStealingOptions(4));
+  fml::CountDownLatch latch(4);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    std::scoped_lock lock(thread_ids_mutex);
+    thread_ids.insert(std::this_thread::get_id());
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), 4u);
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsThreadTasksWhenBusy) {
+  auto loop = fml::ConcurrentMessageLoop::Create(WorkStealingOptions(1));
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic_bool thread_task_ran = false;
+  fml::AutoResetWaitableEvent done;
+  // Keeps the only worker busy until the thread task has run.
+  fml::closure keep_busy = [&]() {
+    if (thread_task_ran) {
+      done.Signal();
+      return;
+    }
+    task_runner->PostTask(keep_busy);
+  };
+  task_runner->PostTask([&]() {
+    loop->PostTaskToAllWorkers([&]() { thread_task_ran = true; });
+    keep_busy();
+  });
+  done.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopDrainsOnTerminate) {
+  auto loop = fml::ConcurrentMessageLoop::Create(WorkStealingOptions(2));
+  auto task_runner = loop->GetTaskRunner();
+  fml::CountDownLatch workers_busy(2);
+  fml::ManualResetWaitableEvent release_workers;
+  for (size_t i = 0; i < 2; ++i) {
+    task_runner->PostTask([&]() {
+      workers_busy.CountDown();
+      release_workers.Wait();
+    });
+  }
+  workers_busy.Wait();
+
+  const size_t kCount = 100;
+  std::atomic_size_t count = 0;
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() { count++; });
+  }
+  loop->Terminate();
+  release_workers.Signal();
+  // Joins the workers.
+  loop.reset();
+  ASSERT_EQ(count, kCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopWithPinnedWorkersRunsTasks) {
+  auto options = WorkStealingOptions(2);
+  options.pin_workers_to_cpus = true;
+  auto loop = fml::ConcurrentMessageLoop::Create(options);
+  fml::CountDownLatch latch(10);
+  auto task_runner = loop->GetTaskRunner();
+  for (size_t i = 0; i < 10; ++i) {
+    task_runner->PostTask([&]() { latch.CountDown(); });
+  }
+  latch.Wait();
+}
@@ -54,12 +54,34 @@ void frameCallback(FrameInfo info) {
   print('called back');
 }
 
+@pragma('vm:entry-point')
+void nextFrameCallback(Image image, int durationMilliseconds) {
+  _didReceiveNextFrame(image != null);
+}
+void _didReceiveNextFrame(bool hasImage) native 'DidReceiveNextFrame';
+
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+@pragma('vm:entry-point')
+void receivePointerDataPackets() {
+  PlatformDispatcher.instance.onPointerDataPacket = (PointerDataPacket packet) {};
+}
+
 @pragma('vm:entry-point')
 void validateConfiguration() native 'ValidateConfiguration';
 
+@pragma('vm:entry-point')
+void receivePlatformMessage() {
+  window.onPlatformMessage =
+      (String name, ByteData data, PlatformMessageResponseCallback callback) {
+    _validatePlatformMessage(data);
+  };
+  _onPlatformMessageHandlerSet();
+}
+void _onPlatformMessageHandlerSet() native 'OnPlatformMessageHandlerSet';
+void _validatePlatformMessage(ByteData data) native 'ValidatePlatformMessage';
+
 
 // Draw a circle on a Canvas that has a PictureRecorder. Take the image from
 // the PictureRecorder, and encode it as png. Check that the png data is
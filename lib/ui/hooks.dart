@@ -90,12 +90,24 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+// ignore: unused_element
+void _dispatchPlatformMessages(List<String> names, List<Object?> data, List<int> responseIds) {
+  PlatformDispatcher.instance._dispatchPlatformMessages(names, data, responseIds);
+}
+
 @pragma('vm:entry-point')
 // ignore: unused_element
 void _dispatchPointerDataPacket(ByteData packet) {
   PlatformDispatcher.instance._dispatchPointerDataPacket(packet);
 }
 
+@pragma('vm:entry-point')
+// ignore: unused_element
+void _dispatchCompactPointerDataPacket(ByteData packet) {
+  PlatformDispatcher.instance._dispatchCompactPointerDataPacket(packet);
+}
+
 @pragma('vm:entry-point')
 // ignore: unused_element
 void _dispatchSemanticsAction(int id, int action, ByteData? args) {
@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -24,6 +25,10 @@ using tonic::ToDart;
 
 namespace flutter {
 
+// Combined into the content hash when the canvas state is saved or restored.
+static constexpr uint64_t kSaveHashTag = 0x5341564500000000;
+static constexpr uint64_t kRestoreHashTag = 0x5245535400000000;
+
 static void Canvas_constructor(Dart_NativeArguments args) {
   UIDartState::ThrowIfUIOperationsProhibited();
   DartCallConstructor(&Canvas::Create, args);
@@ -83,6 +88,8 @@ fml::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
   }
   fml::RefPtr<Canvas> canvas = fml::MakeRefCounted<Canvas>(
       recorder->BeginRecording(SkRect::MakeLTRB(left, top, right, bottom)));
+  // The bounds of the recording are the bounds of the picture.
+  canvas->content_hash_ = fml::HashCombine64(left, top, right, bottom);
   recorder->set_canvas(canvas);
   return canvas;
 }
@@ -96,6 +103,7 @@ void Canvas::save() {
     return;
   }
   canvas_->save();
+  CombineContentHash(kSaveHashTag);
 }
 
 void Canvas::saveLayerWithoutBounds(const Paint& paint,
@@ -103,6 +111,7 @@ void Canvas::saveLayerWithoutBounds(const Paint& paint,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->saveLayer(nullptr, paint.paint());
 }
 
@@ -115,6 +124,7 @@ void Canvas::saveLayer(double left,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   SkRect bounds = SkRect::MakeLTRB(left, top, right, bottom);
   canvas_->saveLayer(&bounds, paint.paint());
 }
@@ -124,6 +134,7 @@ void Canvas::restore() {
     return;
   }
   canvas_->restore();
+  CombineContentHash(kRestoreHashTag);
 }
 
 int Canvas::getSaveCount() {
@@ -179,12 +190,15 @@ void Canvas::clipRect(double left,
   }
   canvas_->clipRect(SkRect::MakeLTRB(left, top, right, bottom), clipOp,
                     doAntiAlias);
+  CombineContentHash(fml::HashCombine64(left, top, right, bottom,
+                                        static_cast<int>(clipOp), doAntiAlias));
 }
 
 void Canvas::clipRRect(const RRect& rrect, bool doAntiAlias) {
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->clipRRect(rrect.sk_rrect, doAntiAlias);
 }
 
@@ -192,6 +206,7 @@ void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!path) {
     Dart_ThrowException(
         ToDart("Canvas.clipPath called with non-genuine Path."));
@@ -204,6 +219,7 @@ void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawColor(color, blend_mode);
 }
 
@@ -216,6 +232,7 @@ void Canvas::drawLine(double x1,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawLine(x1, y1, x2, y2, *paint.paint());
 }
 
@@ -223,6 +240,7 @@ void Canvas::drawPaint(const Paint& paint, const PaintData& paint_data) {
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawPaint(*paint.paint());
 }
 
@@ -235,6 +253,7 @@ void Canvas::drawRect(double left,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawRect(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
 }
 
@@ -244,6 +263,7 @@ void Canvas::drawRRect(const RRect& rrect,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawRRect(rrect.sk_rrect, *paint.paint());
 }
 
@@ -254,6 +274,7 @@ void Canvas::drawDRRect(const RRect& outer,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawDRRect(outer.sk_rrect, inner.sk_rrect, *paint.paint());
 }
 
@@ -266,6 +287,7 @@ void Canvas::drawOval(double left,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawOval(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
 }
 
@@ -277,6 +299,7 @@ void Canvas::drawCircle(double x,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawCircle(x, y, radius, *paint.paint());
 }
 
@@ -292,6 +315,7 @@ void Canvas::drawArc(double left,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   canvas_->drawArc(SkRect::MakeLTRB(left, top, right, bottom),
                    startAngle * 180.0 / M_PI, sweepAngle * 180.0 / M_PI,
                    useCenter, *paint.paint());
@@ -303,6 +327,7 @@ void Canvas::drawPath(const CanvasPath* path,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!path) {
     Dart_ThrowException(
         ToDart("Canvas.drawPath called with non-genuine Path."));
@@ -319,6 +344,7 @@ void Canvas::drawImage(const CanvasImage* image,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!image) {
     Dart_ThrowException(
         ToDart("Canvas.drawImage called with non-genuine Image."));
@@ -341,6 +367,7 @@ void Canvas::drawImageRect(const CanvasImage* image,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!image) {
     Dart_ThrowException(
         ToDart("Canvas.drawImageRect called with non-genuine Image."));
@@ -366,6 +393,7 @@ void Canvas::drawImageNine(const CanvasImage* image,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!image) {
     Dart_ThrowException(
         ToDart("Canvas.drawImageNine called with non-genuine Image."));
@@ -383,6 +411,7 @@ void Canvas::drawPicture(Picture* picture) {
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!picture) {
     Dart_ThrowException(
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
@@ -398,6 +427,7 @@ void Canvas::drawPoints(const Paint& paint,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
 
   static_assert(sizeof(SkPoint) == sizeof(float) * 2,
                 "SkPoint doesn't use floats.");
@@ -415,6 +445,7 @@ void Canvas::drawVertices(const Vertices* vertices,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!vertices) {
     Dart_ThrowException(
         ToDart("Canvas.drawVertices called with non-genuine Vertices."));
@@ -434,6 +465,7 @@ void Canvas::drawAtlas(const Paint& paint,
   if (!canvas_) {
     return;
   }
+  content_hash_ = 0;
   if (!atlas) {
     Dart_ThrowException(
         ToDart("Canvas.drawAtlas or Canvas.drawRawAtlas called with "
@@ -466,6 +498,7 @@ void Canvas::drawShadow(const CanvasPath* path,
         ToDart("Canvas.drawShader called with non-genuine Path."));
     return;
   }
+  content_hash_ = 0;
   SkScalar dpr = UIDartState::Current()
                      ->platform_configuration()
                      ->get_window(0)
@@ -475,6 +508,30 @@ void Canvas::drawShadow(const CanvasPath* path,
                                           elevation, transparentOccluder, dpr);
 }
 
+void Canvas::AddContentHash(uint64_t hash) {
+  if (hash == 0) {
+    content_hash_ = 0;
+    return;
+  }
+  CombineContentHash(hash);
+}
+
+void Canvas::CombineContentHash(uint64_t hash) {
+  if (!canvas_ || content_hash_ == 0) {
+    return;
+  }
+  // The matrix is combined with every operation rather than every change to
+  // it, so the hash only depends on the matrix the content is drawn with.
+  const SkMatrix& matrix = canvas_->getTotalMatrix();
+  uint64_t combined = content_hash_;
+  fml::HashCombineSeed64(combined, hash);
+  for (int i = 0; i < 9; i++) {
+    fml::HashCombineSeed64(combined, matrix.get(i));
+  }
+  // Keep 0 for canvases whose content is unknown.
+  content_hash_ = combined != 0 ? combined : 1;
+}
+
 void Canvas::Invalidate() {
   canvas_ = nullptr;
   if (dart_wrapper()) {
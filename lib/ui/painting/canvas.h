@@ -167,6 +167,16 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
   SkCanvas* canvas() const { return canvas_; }
   void Invalidate();
 
+  // A hash of everything recorded into the canvas, or 0 if something was
+  // drawn that is not hashed. Pictures recorded with equal hashes draw
+  // identical pixels.
+  uint64_t content_hash() const { return content_hash_; }
+
+  // Combines |hash|, which describes content drawn directly into canvas() by
+  // the caller, into the content hash. A |hash| of 0 means that the content is
+  // not hashed.
+  void AddContentHash(uint64_t hash);
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -176,6 +186,10 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
   // which does not transfer ownership.  For this reason, we hold a raw
   // pointer and manually set to null in Clear.
   SkCanvas* canvas_;
+  uint64_t content_hash_ = 0;
+
+  // Combines |hash| and the current matrix into the content hash.
+  void CombineContentHash(uint64_t hash);
 };
 
 }  // namespace flutter
@@ -32,7 +32,7 @@ class Codec : public RefCountedDartWrappable<Codec> {
 
   virtual Dart_Handle getNextFrame(Dart_Handle callback_handle) = 0;
 
-  void dispose();
+  virtual void dispose();
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 };
@@ -5,19 +5,117 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 
 #include <algorithm>
+#include <mutex>
+#include <vector>
 
 #include "flutter/fml/make_copyable.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 
 namespace flutter {
 
+namespace {
+
+using DecodeResult =
+    std::function<void(SkiaGPUObject<SkImage>, fml::tracing::TraceFlow)>;
+
+struct PendingDecode {
+  ImageDecoder::DecodeId id;
+  fml::RefPtr<ImageDescriptor> descriptor;
+  uint32_t target_width;
+  uint32_t target_height;
+  DecodeResult result;
+  fml::tracing::TraceFlow flow;
+};
+
+}  // namespace
+
+// The decodes waiting for a worker. Workers drain the queue until it is empty,
+// and no more than |max_active| workers drain it at the same time.
+class ImageDecoder::DecodeQueue {
+ public:
+  explicit DecodeQueue(size_t max_active)
+      : max_active_(std::max<size_t>(max_active, 1)) {}
+
+  // Returns true if the caller has to post a task draining the queue.
+  bool Push(std::unique_ptr<PendingDecode> decode, Priority priority) {
+    std::scoped_lock lock(mutex_);
+    (priority == Priority::kVisible ? visible_ : prefetch_)
+        .push_back(std::move(decode));
+    const bool needs_worker = active_ < max_active_;
+    if (needs_worker) {
+      active_++;
+    }
+    TraceCounts();
+    return needs_worker;
+  }
+
+  // Returns the next decode to run, or nullptr once the queue is empty, at
+  // which point the calling worker stops draining it.
+  std::unique_ptr<PendingDecode> Pop() {
+    std::scoped_lock lock(mutex_);
+    std::unique_ptr<PendingDecode> decode;
+    for (auto* pending : {&visible_, &prefetch_}) {
+      if (!pending->empty()) {
+        decode = std::move(pending->back());
+        pending->pop_back();
+        break;
+      }
+    }
+    if (!decode) {
+      active_--;
+    }
+    TraceCounts();
+    return decode;
+  }
+
+  std::unique_ptr<PendingDecode> Remove(DecodeId id) {
+    std::scoped_lock lock(mutex_);
+    for (auto* pending : {&visible_, &prefetch_}) {
+      auto found =
+          std::find_if(pending->begin(), pending->end(),
+                       [id](const auto& decode) { return decode->id == id; });
+      if (found != pending->end()) {
+        auto decode = std::move(*found);
+        pending->erase(found);
+        TraceCounts();
+        return decode;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t GetPendingCount() const {
+    std::scoped_lock lock(mutex_);
+    return visible_.size() + prefetch_.size();
+  }
+
+ private:
+  const size_t max_active_;
+  mutable std::mutex mutex_;
+  // Both are popped from the back.
+  std::vector<std::unique_ptr<PendingDecode>> visible_;
+  std::vector<std::unique_ptr<PendingDecode>> prefetch_;
+  size_t active_ = 0;
+
+  void TraceCounts() const {
+    FML_TRACE_COUNTER("flutter", "ImageDecodeQueue",
+                      reinterpret_cast<int64_t>(this), "Visible",
+                      visible_.size(), "Prefetch", prefetch_.size(), "Active",
+                      active_);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodeQueue);
+};
+
 ImageDecoder::ImageDecoder(
     TaskRunners runners,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-    fml::WeakPtr<IOManager> io_manager)
+    fml::WeakPtr<IOManager> io_manager,
+    size_t max_concurrent_decodes)
     : runners_(std::move(runners)),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      queue_(std::make_shared<DecodeQueue>(max_concurrent_decodes)),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
@@ -152,6 +250,13 @@ sk_sp<SkImage> ImageFromCompressedData(fml::RefPtr<ImageDescriptor> descriptor,
     }
   }
 
+  // Otherwise, if the codec can skip rows and columns while decoding, only
+  // allocate the sampled pixels instead of the full image.
+  if (auto sampled_image = descriptor->sampled_image(resized_dimensions)) {
+    return ResizeRasterImage(std::move(sampled_image), resized_dimensions,
+                             flow);
+  }
+
   auto image = descriptor->image();
   if (!image) {
     return nullptr;
@@ -216,10 +321,71 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
-void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
-                          uint32_t target_width,
-                          uint32_t target_height,
-                          const ImageResult& callback) {
+static void DecodeAndUpload(std::unique_ptr<PendingDecode> decode,
+                            fml::WeakPtr<IOManager> io_manager,
+                            fml::RefPtr<fml::TaskRunner> io_runner) {
+  auto& result = decode->result;
+  auto& flow = decode->flow;
+
+  // Step 1: Decompress the image.
+  // On Worker.
+
+  auto decompressed =
+      decode->descriptor->is_compressed()
+          ? ImageFromCompressedData(std::move(decode->descriptor),  //
+                                    decode->target_width,           //
+                                    decode->target_height,          //
+                                    flow)
+          : ImageFromDecompressedData(std::move(decode->descriptor),  //
+                                      decode->target_width,           //
+                                      decode->target_height,          //
+                                      flow);
+
+  if (!decompressed) {
+    FML_LOG(ERROR) << "Could not decompress image.";
+    result({}, std::move(flow));
+    return;
+  }
+
+  // Step 2: Update the image to the GPU.
+  // On IO Thread.
+
+  io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
+                                         flow = std::move(flow)]() mutable {
+    if (!io_manager) {
+      FML_LOG(ERROR) << "Could not acquire IO manager.";
+      return result({}, std::move(flow));
+    }
+
+    // If the IO manager does not have a resource context, the caller
+    // might not have set one or a software backend could be in use.
+    // Either way, just return the image as-is.
+    if (!io_manager->GetResourceContext()) {
+      result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
+             std::move(flow));
+      return;
+    }
+
+    auto uploaded =
+        UploadRasterImage(std::move(decompressed), io_manager, flow);
+
+    if (!uploaded.get()) {
+      FML_LOG(ERROR) << "Could not upload image to the GPU.";
+      result({}, std::move(flow));
+      return;
+    }
+
+    // Finally, all done.
+    result(std::move(uploaded), std::move(flow));
+  }));
+}
+
+ImageDecoder::DecodeId ImageDecoder::Decode(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    uint32_t target_width,
+    uint32_t target_height,
+    const ImageResult& callback,
+    Priority priority) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   fml::tracing::TraceFlow flow(__FUNCTION__);
 
@@ -227,9 +393,10 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
   // Always service the callback (and cleanup the descriptor) on the UI thread.
-  auto result = [callback, descriptor, ui_runner = runners_.GetUITaskRunner()](
-                    SkiaGPUObject<SkImage> image,
-                    fml::tracing::TraceFlow flow) {
+  DecodeResult result = [callback, descriptor,
+                         ui_runner = runners_.GetUITaskRunner()](
+                            SkiaGPUObject<SkImage> image,
+                            fml::tracing::TraceFlow flow) {
     ui_runner->PostTask(
         fml::MakeCopyable([callback, descriptor, image = std::move(image),
                            flow = std::move(flow)]() mutable {
@@ -243,71 +410,61 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
 
   if (!descriptor->data() || descriptor->data()->size() == 0) {
     result({}, std::move(flow));
-    return;
+    return 0;
   }
 
-  concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([descriptor,                              //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
-  ]() mutable {
-        // Step 1: Decompress the image.
-        // On Worker.
-
-        auto decompressed =
-            descriptor->is_compressed()
-                ? ImageFromCompressedData(std::move(descriptor),  //
-                                          target_width,           //
-                                          target_height,          //
-                                          flow)
-                : ImageFromDecompressedData(std::move(descriptor),  //
-                                            target_width,           //
-                                            target_height,          //
-                                            flow);
-
-        if (!decompressed) {
-          FML_LOG(ERROR) << "Could not decompress image.";
-          result({}, std::move(flow));
-          return;
-        }
-
-        // Step 2: Update the image to the GPU.
-        // On IO Thread.
-
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_LOG(ERROR) << "Could not acquire IO manager.";
-            return result({}, std::move(flow));
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.get()) {
-            FML_LOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
-        }));
-      }));
+  const DecodeId id = next_decode_id_++;
+  auto decode = std::unique_ptr<PendingDecode>(new PendingDecode{
+      id, std::move(descriptor), target_width, target_height,
+      std::move(result), std::move(flow)});
+
+  if (!queue_->Push(std::move(decode), priority)) {
+    // Enough workers are already draining the queue.
+    return id;
+  }
+
+  concurrent_task_runner_->PostTask([queue = queue_, io_manager = io_manager_,
+                                     io_runner = runners_.GetIOTaskRunner()]() {
+    while (auto decode = queue->Pop()) {
+      if (decode->descriptor->is_disposed()) {
+        // The descriptor was disposed while the decode was queued.
+        decode->result({}, std::move(decode->flow));
+        continue;
+      }
+      DecodeAndUpload(std::move(decode), io_manager, io_runner);
+    }
+  });
+
+  return id;
+}
+
+bool ImageDecoder::Cancel(DecodeId id) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  auto decode = queue_->Remove(id);
+  if (!decode) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "ImageDecoder::Cancel");
+  decode->result({}, std::move(decode->flow));
+  return true;
+}
+
+size_t ImageDecoder::GetPendingDecodeCount() const {
+  return queue_->GetPendingCount();
+}
+
+void ImageDecoder::SetFrameDecodeOptions(const FrameDecodeOptions& options) {
+  frame_decode_options_ = options;
+}
+
+const ImageDecoder::FrameDecodeOptions& ImageDecoder::GetFrameDecodeOptions()
+    const {
+  return frame_decode_options_;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ImageDecoder::GetConcurrentTaskRunner() const {
+  return concurrent_task_runner_;
 }
 
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
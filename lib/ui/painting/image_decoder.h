@@ -31,10 +31,37 @@ namespace flutter {
 // occur in a frame pipeline.
 class ImageDecoder {
  public:
+  /// The order in which queued decodes start. Decodes of the same priority
+  /// start from the most recently requested one, so that the images that came
+  /// on screen last are decoded first while scrolling quickly.
+  enum class Priority {
+    // Images that are on screen.
+    kVisible,
+    // Images decoded ahead of being shown, which may never be.
+    kPrefetch,
+  };
+
+  /// Identifies a decode until it starts, or 0 if it was never queued.
+  using DecodeId = uint64_t;
+
+  static constexpr size_t kDefaultMaxConcurrentDecodes = 4;
+
+  /// How the codecs of animated images decode their frames.
+  struct FrameDecodeOptions {
+    /// The number of frames decoded on the concurrent workers ahead of being
+    /// requested.
+    size_t lookahead_frames = 0;
+    /// The max size in bytes of the composited frames a codec keeps to play
+    /// its loop again without decoding it. Loops that do not fit are decoded
+    /// every time. 0 disables the cache.
+    size_t frame_cache_max_bytes = 0;
+  };
+
   ImageDecoder(
       TaskRunners runners,
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-      fml::WeakPtr<IOManager> io_manager);
+      fml::WeakPtr<IOManager> io_manager,
+      size_t max_concurrent_decodes = kDefaultMaxConcurrentDecodes);
 
   ~ImageDecoder();
 
@@ -45,17 +72,42 @@ class ImageDecoder {
   // concurrently. Texture upload is done on the IO thread and the result
   // returned back on the UI thread. On error, the texture is null but the
   // callback is guaranteed to return on the UI thread.
-  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-              uint32_t target_width,
-              uint32_t target_height,
-              const ImageResult& result);
+  //
+  // At most |max_concurrent_decodes| images are decompressed at the same time.
+  // Further decodes wait in a queue ordered by |priority|. A decode whose
+  // descriptor is disposed while it is queued does not start, and returns a
+  // null texture.
+  DecodeId Decode(fml::RefPtr<ImageDescriptor> descriptor,
+                  uint32_t target_width,
+                  uint32_t target_height,
+                  const ImageResult& result,
+                  Priority priority = Priority::kVisible);
+
+  // Removes a decode from the queue if it has not started yet. Its callback
+  // returns a null texture. Returns false if the decode already started.
+  bool Cancel(DecodeId id);
+
+  // The number of decodes waiting for a worker.
+  size_t GetPendingDecodeCount() const;
+
+  void SetFrameDecodeOptions(const FrameDecodeOptions& options);
+
+  const FrameDecodeOptions& GetFrameDecodeOptions() const;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const;
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  private:
+  class DecodeQueue;
+
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  // Shared with the workers draining it, which may outlive the decoder.
+  std::shared_ptr<DecodeQueue> queue_;
+  DecodeId next_decode_id_ = 1;
+  FrameDecodeOptions frame_decode_options_;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
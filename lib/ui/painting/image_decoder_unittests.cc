@@ -17,6 +17,7 @@
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
 #include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/tonic/converter/dart_converter.h"
 
 namespace flutter {
 namespace testing {
@@ -343,6 +344,84 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, QueuedDecodesRunByPriorityAndCanBeCancelled) {
+  // A single worker so that the decodes run one after the other.
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+  fml::AutoResetWaitableEvent worker_latch;
+
+  std::unique_ptr<IOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+  std::vector<std::string> decoded;
+  std::vector<std::string> cancelled;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+
+  auto decode_images = [&]() {
+    image_decoder = std::make_unique<ImageDecoder>(
+        runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager(), 1);
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+
+    // Keep the worker busy until all the decodes are queued.
+    loop->GetTaskRunner()->PostTask([&]() { worker_latch.Wait(); });
+
+    auto decode = [&](const std::string& name,
+                      ImageDecoder::Priority priority) {
+      auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+          data, SkCodec::MakeFromData(data));
+      ImageDecoder::ImageResult callback =
+          [&, name](SkiaGPUObject<SkImage> image) {
+            ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+            (image.get() ? decoded : cancelled).push_back(name);
+            if (decoded.size() + cancelled.size() == 4) {
+              image_decoder.reset();
+              runners.GetIOTaskRunner()->PostTask(release_io_manager);
+            }
+          };
+      return image_decoder->Decode(descriptor, descriptor->width(),
+                                   descriptor->height(), callback, priority);
+    };
+
+    decode("a", ImageDecoder::Priority::kVisible);
+    decode("b", ImageDecoder::Priority::kPrefetch);
+    decode("c", ImageDecoder::Priority::kVisible);
+    auto d = decode("d", ImageDecoder::Priority::kVisible);
+    ASSERT_EQ(image_decoder->GetPendingDecodeCount(), 4u);
+
+    ASSERT_TRUE(image_decoder->Cancel(d));
+    ASSERT_FALSE(image_decoder->Cancel(d));
+    ASSERT_EQ(image_decoder->GetPendingDecodeCount(), 3u);
+
+    worker_latch.Signal();
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager =
+        std::make_unique<TestIOManager>(runners.GetIOTaskRunner(), false);
+    runners.GetUITaskRunner()->PostTask(decode_images);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+
+  latch.Wait();
+
+  // The most recent visible decode runs first, and prefetches run last.
+  EXPECT_EQ(decoded, std::vector<std::string>({"c", "a", "b"}));
+  EXPECT_EQ(cancelled, std::vector<std::string>({"d"}));
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
@@ -591,6 +670,50 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, VerifySampledDecoding) {
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+  ASSERT_EQ(descriptor->image_info().dimensions(), SkISize::Make(300, 100));
+
+  // PNG decoding cannot be scaled, but it can skip rows and columns.
+  ASSERT_EQ(descriptor->get_scaled_dimensions(0.25),
+            descriptor->image_info().dimensions());
+  auto sampled = descriptor->sampled_image(SkISize::Make(70, 20));
+  ASSERT_TRUE(sampled != nullptr);
+  ASSERT_EQ(sampled->dimensions(), SkISize::Make(75, 25));
+
+  // Nothing is gained by sampling an image that is not at least twice the
+  // target size.
+  ASSERT_EQ(descriptor->sampled_image(SkISize::Make(200, 60)), nullptr);
+
+  ASSERT_EQ(
+      ImageFromCompressedData(descriptor, 70, 20, fml::tracing::TraceFlow(""))
+          ->dimensions(),
+      SkISize::Make(70, 20));
+}
+
+TEST(ImageDecoderTest, VerifySampledDecodingPreservesExifOrientation) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+  ASSERT_EQ(descriptor->image_info().dimensions(), SkISize::Make(600, 200));
+
+  auto expected_data = OpenFixtureAsSkData("Horizontal.png");
+  ASSERT_TRUE(expected_data != nullptr);
+  ASSERT_FALSE(expected_data->isEmpty());
+
+  auto sampled = descriptor->sampled_image(SkISize::Make(300, 100));
+  ASSERT_TRUE(sampled != nullptr);
+  ASSERT_EQ(sampled->dimensions(), SkISize::Make(300, 100));
+  ASSERT_TRUE(sampled->encodeToData(SkEncodedImageFormat::kPNG, 100)
+                  ->equals(expected_data.get()));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -684,5 +807,96 @@ TEST_F(ImageDecoderFixtureTest,
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDecodesAheadAndCachesItsLoop) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+
+  ASSERT_TRUE(gif_mapping);
+
+  auto gif_codec = std::shared_ptr<SkCodecImageGenerator>(
+      static_cast<SkCodecImageGenerator*>(
+          SkCodecImageGenerator::MakeFromEncodedCodec(gif_mapping).release()));
+  ASSERT_TRUE(gif_codec);
+  ASSERT_GT(gif_codec->getFrameCount(), 1);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<TestIOManager> io_manager;
+
+  // Setup the IO manager.
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    latch.Signal();
+  });
+  latch.Wait();
+
+  // Play the loop twice, so that the second time is played from the cache.
+  const int loop_frame_count = gif_codec->getFrameCount();
+  const int frame_count = loop_frame_count * 2;
+  int received_frames = 0;
+  fml::RefPtr<MultiFrameCodec> codec;
+  MultiFrameCodec::DecodeStats stats;
+
+  auto request_next_frame = [&]() {
+    Dart_Handle closure = Dart_GetField(
+        Dart_RootLibrary(), Dart_NewStringFromCString("nextFrameCallback"));
+    ASSERT_TRUE(Dart_IsClosure(closure));
+    codec->getNextFrame(closure);
+  };
+
+  AddNativeCallback("DidReceiveNextFrame",
+                    CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                      EXPECT_TRUE(tonic::DartConverter<bool>::FromDart(
+                          Dart_GetNativeArgument(args, 0)));
+                      if (++received_frames < frame_count) {
+                        request_next_frame();
+                      } else {
+                        stats = codec->GetDecodeStats();
+                        codec = nullptr;
+                        latch.Signal();
+                      }
+                    }));
+
+  auto isolate =
+      RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                           GetFixturesPath(), io_manager->GetWeakIOManager());
+
+  runners.GetUITaskRunner()->PostTask([&]() {
+    EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+      ImageDecoder::FrameDecodeOptions options;
+      options.lookahead_frames = 2;
+      options.frame_cache_max_bytes = 64 * 1024 * 1024;
+      codec = fml::MakeRefCounted<MultiFrameCodec>(
+          std::move(gif_codec), options, loop->GetTaskRunner());
+      request_next_frame();
+      return true;
+    }));
+  });
+  latch.Wait();
+
+  EXPECT_EQ(received_frames, frame_count);
+  // Every frame of the loop is decoded once, and some of them ahead of being
+  // requested. The second time through the loop only uses the cache.
+  EXPECT_EQ(stats.decoded_frames, loop_frame_count);
+  EXPECT_GT(stats.decoded_ahead_frames, 0);
+  EXPECT_GE(stats.cached_frames_served, loop_frame_count);
+
+  // Destroy the IO manager
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace testing
 }  // namespace flutter
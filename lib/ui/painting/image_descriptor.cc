@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
+#include <string>
+
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
@@ -12,6 +14,10 @@
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
+#include "third_party/skia/include/codec/SkEncodedOrigin.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 
@@ -163,7 +169,30 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    auto decoder = UIDartState::Current()->GetImageDecoder();
+    if (!decoder) {
+      ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    } else {
+      const auto& options = decoder->GetFrameDecodeOptions();
+      std::shared_ptr<SkCodecImageGenerator> generator = generator_;
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+      if (options.lookahead_frames > 0) {
+        // A codec that decodes ahead on a worker needs an SkCodec of its own,
+        // since another codec of this descriptor may be decoding on the IO
+        // thread at the same time. Otherwise every decode happens on the IO
+        // thread and the generator of the descriptor can be shared.
+        auto own_generator = std::shared_ptr<SkCodecImageGenerator>(
+            static_cast<SkCodecImageGenerator*>(
+                SkCodecImageGenerator::MakeFromEncodedCodec(buffer_)
+                    .release()));
+        if (own_generator) {
+          generator = std::move(own_generator);
+          worker_task_runner = decoder->GetConcurrentTaskRunner();
+        }
+      }
+      ui_codec = fml::MakeRefCounted<MultiFrameCodec>(
+          std::move(generator), options, std::move(worker_task_runner));
+    }
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
@@ -194,4 +223,77 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
   return platform_image_generator_->getPixels(pixmap);
 }
 
+sk_sp<SkImage> ImageDescriptor::sampled_image(
+    const SkISize& target_dimensions) const {
+  if (!generator_ || target_dimensions.isEmpty()) {
+    return nullptr;
+  }
+  std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(buffer_);
+  if (!codec) {
+    return nullptr;
+  }
+
+  // The codec decodes the pixels as they are encoded, before they are
+  // oriented.
+  const SkEncodedOrigin origin = codec->codec()->getOrigin();
+  SkISize sampled_dimensions =
+      SkEncodedOriginSwapsWidthHeight(origin)
+          ? SkISize::Make(target_dimensions.height(), target_dimensions.width())
+          : target_dimensions;
+  const int sample_size = codec->computeSampleSize(&sampled_dimensions);
+  if (sample_size <= 1) {
+    return nullptr;
+  }
+
+  TRACE_EVENT1("flutter", "ImageDescriptor::sampled_image", "sample_size",
+               std::to_string(sample_size).c_str());
+  const SkImageInfo sampled_info =
+      image_info_.makeDimensions(sampled_dimensions);
+  SkBitmap sampled_bitmap;
+  if (!sampled_bitmap.tryAllocPixels(sampled_info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << sampled_info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+  SkAndroidCodec::AndroidOptions options;
+  options.fSampleSize = sample_size;
+  const SkCodec::Result result = codec->getAndroidPixels(
+      sampled_info, sampled_bitmap.getPixels(), sampled_bitmap.rowBytes(),
+      &options);
+  if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+    FML_LOG(ERROR) << "Failed to decode sampled image: "
+                   << SkCodec::ResultToString(result);
+    return nullptr;
+  }
+
+  if (origin != kTopLeft_SkEncodedOrigin) {
+    const SkImageInfo oriented_info =
+        SkEncodedOriginSwapsWidthHeight(origin)
+            ? sampled_info.makeDimensions(SkISize::Make(
+                  sampled_info.height(), sampled_info.width()))
+            : sampled_info;
+    SkBitmap oriented_bitmap;
+    if (!oriented_bitmap.tryAllocPixels(oriented_info)) {
+      FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                     << oriented_info.computeMinByteSize() << "B";
+      return nullptr;
+    }
+    // The matrix maps the decoded pixels to the oriented bitmap, whose
+    // dimensions it takes.
+    SkCanvas canvas(oriented_bitmap);
+    canvas.concat(SkEncodedOriginToMatrix(origin, oriented_info.width(),
+                                          oriented_info.height()));
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    sampled_bitmap.setImmutable();
+    canvas.drawImage(SkImage::MakeFromBitmap(sampled_bitmap), 0, 0, &paint);
+    sampled_bitmap = std::move(oriented_bitmap);
+  }
+
+  // Marking this as immutable makes the MakeFromBitmap call share the pixels
+  // instead of copying.
+  sampled_bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(sampled_bitmap);
+}
+
 }  // namespace flutter
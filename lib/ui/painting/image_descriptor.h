@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DESCRIPTOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DESCRIPTOR_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -103,12 +104,25 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   /// if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// Decodes this image, EXIF oriented, with the largest sample size that
+  /// keeps it at least as large as |target_dimensions|. Sampling skips rows
+  /// and columns while decoding, so only the sampled pixels are allocated.
+  ///
+  /// Returns nullptr if the image is not backed by a codec that can sample
+  /// while decoding, or if it is too small to be sampled down.
+  sk_sp<SkImage> sampled_image(const SkISize& target_dimensions) const;
+
   void dispose() {
+    disposed_ = true;
     ClearDartWrapper();
     generator_.reset();
     platform_image_generator_.reset();
   }
 
+  /// Whether |dispose| was called. Decodes of a disposed descriptor that have
+  /// not started yet are cancelled.
+  bool is_disposed() const { return disposed_; }
+
   size_t GetAllocationSize() const override {
     return sizeof(ImageDescriptor) + sizeof(SkImageInfo) + buffer_->size();
   }
@@ -128,6 +142,7 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   std::unique_ptr<SkImageGenerator> platform_image_generator_;
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
+  std::atomic<bool> disposed_{false};
 
   const SkImageInfo CreateImageInfo() const;
 
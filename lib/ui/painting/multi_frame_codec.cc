@@ -13,16 +13,33 @@
 namespace flutter {
 
 MultiFrameCodec::MultiFrameCodec(
-    std::shared_ptr<SkCodecImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+    std::shared_ptr<SkCodecImageGenerator> generator,
+    ImageDecoder::FrameDecodeOptions options,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : state_(new State(std::move(generator),
+                       options,
+                       std::move(worker_task_runner))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<SkCodecImageGenerator> generator)
+MultiFrameCodec::State::State(
+    std::shared_ptr<SkCodecImageGenerator> generator,
+    ImageDecoder::FrameDecodeOptions options,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
     : generator_(std::move(generator)),
       frameCount_(generator_->getFrameCount()),
       repetitionCount_(generator_->getRepetitionCount()),
-      nextFrameIndex_(0) {}
+      options_(options),
+      workerTaskRunner_(std::move(worker_task_runner)),
+      nextFrameIndex_(0),
+      cacheEnabled_(options_.frame_cache_max_bytes > 0) {
+  frameDurations_.reserve(frameCount_);
+  for (int i = 0; i < frameCount_; i++) {
+    SkCodec::FrameInfo frameInfo{0};
+    generator_->getFrameInfo(i, &frameInfo);
+    frameDurations_.push_back(frameInfo.fDuration);
+  }
+}
 
 static void InvokeNextFrameCallback(
     fml::RefPtr<CanvasImage> image,
@@ -73,8 +90,8 @@ static bool CopyToBitmap(SkBitmap* dst,
   return true;
 }
 
-sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext) {
+SkBitmap MultiFrameCodec::State::DecodeFrame(int frameIndex) {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeFrame");
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->getInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -84,16 +101,16 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   bitmap.allocPixels(info);
 
   SkCodec::Options options;
-  options.fFrameIndex = nextFrameIndex_;
+  options.fFrameIndex = frameIndex;
   SkCodec::FrameInfo frameInfo{0};
-  generator_->getFrameInfo(nextFrameIndex_, &frameInfo);
+  generator_->getFrameInfo(frameIndex, &frameInfo);
   const int requiredFrameIndex = frameInfo.fRequiredFrame;
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
+      FML_LOG(ERROR) << "Frame " << frameIndex << " depends on frame "
                      << requiredFrameIndex
                      << " and no required frames are cached.";
-      return nullptr;
+      return SkBitmap();
     } else if (lastRequiredFrameIndex_ != requiredFrameIndex) {
       FML_DLOG(INFO) << "Required frame " << requiredFrameIndex
                      << " is not cached. Using " << lastRequiredFrameIndex_
@@ -109,14 +126,132 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
 
   if (!generator_->getPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
                              &options)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frameIndex;
+    return SkBitmap();
   }
 
+  // The pixels are not written to anymore, so the frame can be shared with
+  // the cache and the images made from it without copying.
+  bitmap.setImmutable();
+
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.fDisposalMethod == SkCodecAnimation::DisposalMethod::kKeep) {
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
+  }
+
+  return bitmap;
+}
+
+SkBitmap MultiFrameCodec::State::DecodeNextFrame() {
+  const int frameIndex = decodeFrameIndex_;
+  decodeFrameIndex_ = (decodeFrameIndex_ + 1) % frameCount_;
+  SkBitmap bitmap = DecodeFrame(frameIndex);
+  decodedFrameCount_++;
+
+  // Keep the frames of the first loop for as long as all of them fit in the
+  // cache.
+  if (cacheEnabled_) {
+    cachedFramesBytes_ += bitmap.computeByteSize();
+    std::scoped_lock lock(framesMutex_);
+    if (bitmap.isNull() ||
+        cachedFramesBytes_ > options_.frame_cache_max_bytes) {
+      cacheEnabled_ = false;
+      cachedFrames_.clear();
+      cachedFrames_.shrink_to_fit();
+    } else {
+      FML_DCHECK(frameIndex == static_cast<int>(cachedFrames_.size()));
+      cachedFrames_.push_back(bitmap);
+      if (IsLoopCached()) {
+        // Nothing will be decoded anymore.
+        cacheEnabled_ = false;
+      }
+    }
+  }
+
+  return bitmap;
+}
+
+bool MultiFrameCodec::State::IsLoopCached() const {
+  return cachedFrames_.size() == static_cast<size_t>(frameCount_);
+}
+
+bool MultiFrameCodec::State::TakeReadyFrame(SkBitmap* frame) {
+  if (IsLoopCached()) {
+    decodedFrames_.clear();
+    *frame = cachedFrames_[nextFrameIndex_];
+    cachedFramesServedCount_++;
+    return true;
+  }
+  if (!decodedFrames_.empty()) {
+    *frame = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+    return true;
+  }
+  return false;
+}
+
+SkBitmap MultiFrameCodec::State::TakeNextFrame() {
+  SkBitmap frame;
+  {
+    std::scoped_lock lock(framesMutex_);
+    if (TakeReadyFrame(&frame)) {
+      return frame;
+    }
+  }
+
+  // The worker may be decoding this frame. Wait for it before checking again.
+  std::scoped_lock decode_lock(decodeMutex_);
+  {
+    std::scoped_lock lock(framesMutex_);
+    if (TakeReadyFrame(&frame)) {
+      return frame;
+    }
+  }
+  FML_DCHECK(decodeFrameIndex_ == nextFrameIndex_);
+  return DecodeNextFrame();
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead(
+    const std::shared_ptr<State>& state) {
+  if (!state->workerTaskRunner_ || state->options_.lookahead_frames == 0) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state->framesMutex_);
+    if (state->decodingAhead_ || state->IsLoopCached() ||
+        state->decodedFrames_.size() >= state->options_.lookahead_frames) {
+      return;
+    }
+    state->decodingAhead_ = true;
+  }
+  auto decode_ahead = [weak_state = std::weak_ptr<State>(state)]() {
+    TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+    // Stop as soon as the codec is collected.
+    while (auto self = weak_state.lock()) {
+      std::scoped_lock decode_lock(self->decodeMutex_);
+      {
+        std::scoped_lock lock(self->framesMutex_);
+        if (self->IsLoopCached() ||
+            self->decodedFrames_.size() >= self->options_.lookahead_frames) {
+          self->decodingAhead_ = false;
+          return;
+        }
+      }
+      SkBitmap frame = self->DecodeNextFrame();
+      self->decodedAheadFrameCount_++;
+      std::scoped_lock lock(self->framesMutex_);
+      self->decodedFrames_.push_back(std::move(frame));
+    }
+  };
+  state->workerTaskRunner_->PostTask(decode_ahead);
+}
+
+sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
+    fml::WeakPtr<GrDirectContext> resourceContext) {
+  SkBitmap bitmap = TakeNextFrame();
+  if (bitmap.isNull()) {
+    return nullptr;
   }
 
   if (resourceContext) {
@@ -144,9 +279,7 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   if (skImage) {
     image = CanvasImage::Create();
     image->set_image({skImage, std::move(unref_queue)});
-    SkCodec::FrameInfo skFrameInfo{0};
-    generator_->getFrameInfo(nextFrameIndex_, &skFrameInfo);
-    duration = skFrameInfo.fDuration;
+    duration = frameDurations_[nextFrameIndex_];
   }
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
@@ -186,6 +319,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             std::move(callback), std::move(ui_task_runner),
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             trace_id);
+        State::ScheduleDecodeAhead(state);
       }));
 
   return Dart_Null();
@@ -199,4 +333,12 @@ int MultiFrameCodec::repetitionCount() const {
   return state_->repetitionCount_;
 }
 
+MultiFrameCodec::DecodeStats MultiFrameCodec::GetDecodeStats() const {
+  DecodeStats stats;
+  stats.decoded_frames = state_->decodedFrameCount_;
+  stats.decoded_ahead_frames = state_->decodedAheadFrameCount_;
+  stats.cached_frames_served = state_->cachedFramesServedCount_;
+  return stats;
+}
+
 }  // namespace flutter
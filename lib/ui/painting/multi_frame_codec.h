@@ -5,15 +5,26 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  MultiFrameCodec(std::shared_ptr<SkCodecImageGenerator> generator);
+  MultiFrameCodec(
+      std::shared_ptr<SkCodecImageGenerator> generator,
+      ImageDecoder::FrameDecodeOptions options = {},
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr);
 
   ~MultiFrameCodec() override;
 
@@ -26,6 +37,18 @@ class MultiFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  // Counts of how the frames handed out by the codec were obtained.
+  struct DecodeStats {
+    // The frames decoded, on the IO thread or ahead.
+    int decoded_frames = 0;
+    // The frames decoded ahead on the worker task runner.
+    int decoded_ahead_frames = 0;
+    // The frames taken from the cache of the first loop.
+    int cached_frames_served = 0;
+  };
+
+  DecodeStats GetDecodeStats() const;
+
  private:
   // Captures the state shared between the IO and UI task runners.
   //
@@ -36,23 +59,78 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
+  //
+  // Frames are decoded in order. With a look-ahead, the frames following the
+  // last one requested are decoded on the worker task runner, and handed to
+  // the IO task runner for upload when they are requested.
   struct State {
-    State(std::shared_ptr<SkCodecImageGenerator> generator);
+    State(std::shared_ptr<SkCodecImageGenerator> generator,
+          ImageDecoder::FrameDecodeOptions options,
+          std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
 
     const std::shared_ptr<SkCodecImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const ImageDecoder::FrameDecodeOptions options_;
+    const std::shared_ptr<fml::ConcurrentTaskRunner> workerTaskRunner_;
+
+    // The duration of every frame, in milliseconds.
+    std::vector<int> frameDurations_;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // Only read or written to on the IO thread.
     int nextFrameIndex_;
+
+    // Held while decoding a frame, which happens either on the IO thread or
+    // on the worker decoding ahead. Guards the decoding members below.
+    std::mutex decodeMutex_;
+    // The index of the next frame to decode. Frames are decoded in order, so
+    // this is the frame after the last one in |decodedFrames_|.
+    int decodeFrameIndex_ = 0;
+    bool cacheEnabled_;
+    size_t cachedFramesBytes_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::unique_ptr<SkBitmap> lastRequiredFrame_;
 
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
+    // Guards the decoded frames. Never held while decoding, so that the IO
+    // thread can take a frame while the worker decodes the next one. When
+    // both are held, |decodeMutex_| is acquired first.
+    std::mutex framesMutex_;
+    // Frames decoded ahead of being requested, starting at |nextFrameIndex_|.
+    // A frame that could not be decoded is a null bitmap.
+    std::deque<SkBitmap> decodedFrames_;
+    bool decodingAhead_ = false;
+    // The frames of the first loop while all of them fit in the cache.
+    std::vector<SkBitmap> cachedFrames_;
+
+    std::atomic_int decodedFrameCount_ = 0;
+    std::atomic_int decodedAheadFrameCount_ = 0;
+    std::atomic_int cachedFramesServedCount_ = 0;
+
+    // Decodes and composites a frame, which must follow the last decoded one.
+    // Must be called with |decodeMutex_| held.
+    SkBitmap DecodeFrame(int frameIndex);
+
+    // Decodes the frame at |decodeFrameIndex_| and adds it to the cache.
+    // Must be called with |decodeMutex_| held.
+    SkBitmap DecodeNextFrame();
+
+    // Must be called with |framesMutex_| held.
+    bool IsLoopCached() const;
+
+    // Takes the frame at |nextFrameIndex_| out of the cache or the frames
+    // decoded ahead. Must be called with |framesMutex_| held.
+    bool TakeReadyFrame(SkBitmap* frame);
+
+    // Returns the frame at |nextFrameIndex_|, decoding it if it is not ready.
+    SkBitmap TakeNextFrame();
+
+    // Decodes frames on the worker task runner until |lookahead_frames| of
+    // them are ready.
+    static void ScheduleDecodeAhead(const std::shared_ptr<State>& state);
+
     sk_sp<SkImage> GetNextFrameImage(
         fml::WeakPtr<GrDirectContext> resourceContext);
 
@@ -25,10 +25,15 @@ class Picture : public RefCountedDartWrappable<Picture> {
  public:
   ~Picture() override;
   static fml::RefPtr<Picture> Create(Dart_Handle dart_handle,
-                                     flutter::SkiaGPUObject<SkPicture> picture);
+                                     flutter::SkiaGPUObject<SkPicture> picture,
+                                     uint64_t content_hash = 0);
 
   sk_sp<SkPicture> picture() const { return picture_.get(); }
 
+  // A hash of the content of the picture, or 0 if it is unknown. Pictures
+  // with equal hashes draw identical pixels.
+  uint64_t content_hash() const { return content_hash_; }
+
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
                       Dart_Handle raw_image_callback);
@@ -45,9 +50,10 @@ class Picture : public RefCountedDartWrappable<Picture> {
                                       Dart_Handle raw_image_callback);
 
  private:
-  Picture(flutter::SkiaGPUObject<SkPicture> picture);
+  Picture(flutter::SkiaGPUObject<SkPicture> picture, uint64_t content_hash);
 
   flutter::SkiaGPUObject<SkPicture> picture_;
+  uint64_t content_hash_;
 };
 
 }  // namespace flutter
@@ -48,8 +48,10 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
   }
 
   fml::RefPtr<Picture> picture = Picture::Create(
-      dart_picture, UIDartState::CreateGPUObject(
-                        picture_recorder_.finishRecordingAsPicture()));
+      dart_picture,
+      UIDartState::CreateGPUObject(
+          picture_recorder_.finishRecordingAsPicture()),
+      canvas_->content_hash());
 
   canvas_->Invalidate();
   canvas_ = nullptr;
@@ -62,11 +62,16 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   fml::RefPtr<SingleFrameCodec>* raw_codec_ref =
       new fml::RefPtr<SingleFrameCodec>(this);
 
-  decoder->Decode(
+  decode_id_ = decoder->Decode(
       descriptor_, target_width_, target_height_, [raw_codec_ref](auto image) {
         std::unique_ptr<fml::RefPtr<SingleFrameCodec>> codec_ref(raw_codec_ref);
         fml::RefPtr<SingleFrameCodec> codec(std::move(*codec_ref));
 
+        if (codec->pending_callbacks_.empty()) {
+          // The codec was disposed before the image was decoded.
+          return;
+        }
+
         auto state = codec->pending_callbacks_.front().dart_state().lock();
 
         if (!state) {
@@ -107,6 +112,19 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   return Dart_Null();
 }
 
+void SingleFrameCodec::dispose() {
+  if (status_ == Status::kInProgress) {
+    // Nothing will use the image anymore, so skip its decode if it has not
+    // started yet.
+    auto decoder = UIDartState::Current()->GetImageDecoder();
+    if (decoder) {
+      decoder->Cancel(decode_id_);
+    }
+    pending_callbacks_.clear();
+  }
+  Codec::dispose();
+}
+
 size_t SingleFrameCodec::GetAllocationSize() const {
   const auto& data_size = descriptor_->GetAllocationSize();
   const auto frame_byte_size =
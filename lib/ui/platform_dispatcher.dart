@@ -281,9 +281,21 @@ class PlatformDispatcher {
     }
   }
 
+  // Called from the engine, via hooks.dart
+  void _dispatchCompactPointerDataPacket(ByteData packet) {
+    if (onPointerDataPacket != null) {
+      _invoke1<PointerDataPacket>(
+        onPointerDataPacket,
+        _onPointerDataPacketZone,
+        _unpackCompactPointerDataPacket(packet),
+      );
+    }
+  }
+
   // If this value changes, update the encoding code in the following files:
   //
   //  * pointer_data.cc
+  //  * pointer_data_packet.cc
   //  * pointer.dart
   //  * AndroidTouchProcessor.java
   static const int _kPointerDataFieldCount = 29;
@@ -332,6 +344,89 @@ class PlatformDispatcher {
     return PointerDataPacket(data: data);
   }
 
+  // Must match kCompactPointerDataVersion in pointer_data_packet.cc.
+  static const int _kCompactPointerDataVersion = 1;
+
+  // The bit mask of the indices of the double fields of the pointer data.
+  // Must match kPointerDataDoubleFields in pointer_data_packet.cc.
+  static const int _kPointerDataDoubleFields = (0xF << 7) | (0xFFF << 14) | (0x3 << 27);
+
+  /// Decodes a packet in the compact encoding described by
+  /// `PointerDataPacket::Encoding::kCompact` in pointer_data_packet.h.
+  static PointerDataPacket _unpackCompactPointerDataPacket(ByteData packet) {
+    assert(packet.getUint8(0) == _kCompactPointerDataVersion);
+    int offset = 1;
+    int readVarint() {
+      int result = 0;
+      int shift = 0;
+      int byte;
+      do {
+        byte = packet.getUint8(offset++);
+        result |= (byte & 0x7F) << shift;
+        shift += 7;
+      } while ((byte & 0x80) != 0);
+      return result;
+    }
+
+    final int length = readVarint();
+    final Int64List ints = Int64List(_kPointerDataFieldCount);
+    final Float64List doubles = Float64List(_kPointerDataFieldCount);
+    final List<PointerData> data = <PointerData>[];
+    for (int i = 0; i < length; ++i) {
+      final int changed = readVarint();
+      final int floats = readVarint();
+      for (int field = 0; field < _kPointerDataFieldCount; ++field) {
+        final int bit = 1 << field;
+        if ((changed & bit) == 0) {
+          continue;
+        }
+        if ((floats & bit) != 0) {
+          doubles[field] = packet.getFloat32(offset, _kFakeHostEndian);
+          offset += 4;
+        } else if ((_kPointerDataDoubleFields & bit) != 0) {
+          doubles[field] = packet.getFloat64(offset, _kFakeHostEndian);
+          offset += 8;
+        } else {
+          final int zigzag = readVarint();
+          ints[field] += ((zigzag >> 1) & 0x7FFFFFFFFFFFFFFF) ^ -(zigzag & 1);
+        }
+      }
+      data.add(PointerData(
+        embedderId: ints[0],
+        timeStamp: Duration(microseconds: ints[1]),
+        change: PointerChange.values[ints[2]],
+        kind: PointerDeviceKind.values[ints[3]],
+        signalKind: PointerSignalKind.values[ints[4]],
+        device: ints[5],
+        pointerIdentifier: ints[6],
+        physicalX: doubles[7],
+        physicalY: doubles[8],
+        physicalDeltaX: doubles[9],
+        physicalDeltaY: doubles[10],
+        buttons: ints[11],
+        obscured: ints[12] != 0,
+        synthesized: ints[13] != 0,
+        pressure: doubles[14],
+        pressureMin: doubles[15],
+        pressureMax: doubles[16],
+        distance: doubles[17],
+        distanceMax: doubles[18],
+        size: doubles[19],
+        radiusMajor: doubles[20],
+        radiusMinor: doubles[21],
+        radiusMin: doubles[22],
+        radiusMax: doubles[23],
+        orientation: doubles[24],
+        tilt: doubles[25],
+        platformData: ints[26],
+        scrollDeltaX: doubles[27],
+        scrollDeltaY: doubles[28],
+      ));
+    }
+    assert(offset == packet.lengthInBytes);
+    return PointerDataPacket(data: data);
+  }
+
   /// A callback that is invoked to report the [FrameTiming] of recently
   /// rasterized frames.
   ///
@@ -470,6 +565,22 @@ class PlatformDispatcher {
     }
   }
 
+  /// Sends a batch of messages that arrived from the platform within a single
+  /// task to the framework, in the order they were sent.
+  ///
+  /// An exception thrown while handling one message is reported to the current
+  /// zone and does not prevent the delivery of the messages that follow it.
+  void _dispatchPlatformMessages(List<String> names, List<Object?> data, List<int> responseIds) {
+    assert(names.length == data.length && names.length == responseIds.length);
+    for (int i = 0; i < names.length; i++) {
+      try {
+        _dispatchPlatformMessage(names[i], data[i] as ByteData?, responseIds[i]);
+      } catch (error, stackTrace) {
+        Zone.current.handleUncaughtError(error, stackTrace);
+      }
+    }
+  }
+
   /// Set the debug name associated with this platform dispatcher's root
   /// isolate.
   ///
@@ -1926,6 +1926,20 @@ class Paragraph extends NativeFieldWrapperClass2 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native 'Paragraph_layout';
 
+  /// Computes the size and position of each glyph in each of the given
+  /// paragraphs, laying out `paragraphs[i]` with `constraints[i]`.
+  ///
+  /// This is equivalent to calling [layout] on each of the paragraphs, but the
+  /// engine may lay them out concurrently on several threads. All of the
+  /// paragraphs are laid out when this method returns.
+  static void layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    _layoutAll(paragraphs, <double>[
+      for (final ParagraphConstraints constraint in constraints) constraint.width,
+    ]);
+  }
+  static void _layoutAll(List<Paragraph> paragraphs, List<double> widths) native 'Paragraph_layoutAll';
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -4,10 +4,19 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -37,7 +46,13 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, getPositionForOffset)    \
   V(Paragraph, computeLineMetrics)
 
-DART_BIND_ALL(Paragraph, FOR_EACH_BINDING)
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+DART_NATIVE_CALLBACK_STATIC(Paragraph, layoutAll)
+
+void Paragraph::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({DART_REGISTER_NATIVE_STATIC(Paragraph, layoutAll),
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
 
 Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
     : m_paragraph(std::move(paragraph)) {}
@@ -87,12 +102,107 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+void Paragraph::layoutAll(const std::vector<Paragraph*>& paragraphs,
+                          const std::vector<double>& widths) {
+  if (paragraphs.size() != widths.size()) {
+    Dart_ThrowException(
+        ToDart("Paragraph.layoutAll called with " +
+               std::to_string(paragraphs.size()) + " paragraphs but " +
+               std::to_string(widths.size()) + " widths."));
+    return;
+  }
+  std::vector<txt::Paragraph*> txt_paragraphs;
+  txt_paragraphs.reserve(paragraphs.size());
+  for (Paragraph* paragraph : paragraphs) {
+    if (!paragraph) {
+      Dart_ThrowException(ToDart("Paragraph.layoutAll called with null."));
+      return;
+    }
+    txt_paragraphs.push_back(paragraph->m_paragraph.get());
+  }
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> runner;
+#if !FLUTTER_ENABLE_SKSHAPER
+  // The font collections of SkParagraph may not be used on several threads at
+  // once.
+  auto image_decoder = UIDartState::Current()->GetImageDecoder();
+  if (image_decoder) {
+    runner = image_decoder->GetConcurrentTaskRunner();
+  }
+#endif  // !FLUTTER_ENABLE_SKSHAPER
+  LayoutAll(txt_paragraphs, widths, runner);
+}
+
+namespace {
+
+// The paragraphs of a call to Paragraph::LayoutAll. Each thread taking part in
+// it lays out the next paragraph that no other thread claimed, until all of
+// them are claimed. The state outlives the call, since the tasks posted to the
+// worker pool may only start once all the paragraphs are laid out.
+struct LayoutBatch {
+  LayoutBatch(const std::vector<txt::Paragraph*>& p,
+              const std::vector<double>& w)
+      : paragraphs(p), widths(w), remaining(p.size()) {}
+
+  const std::vector<txt::Paragraph*> paragraphs;
+  const std::vector<double> widths;
+  std::atomic_size_t next = 0;
+  fml::CountDownLatch remaining;
+
+  void Run() {
+    for (size_t index = next++; index < paragraphs.size(); index = next++) {
+      paragraphs[index]->Layout(widths[index]);
+      remaining.CountDown();
+    }
+  }
+};
+
+}  // namespace
+
+void Paragraph::LayoutAll(
+    const std::vector<txt::Paragraph*>& paragraphs,
+    const std::vector<double>& widths,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& runner) {
+  FML_DCHECK(paragraphs.size() == widths.size());
+  TRACE_EVENT1("flutter", "Paragraph::LayoutAll", "count",
+               std::to_string(paragraphs.size()).c_str());
+  // A paragraph that is listed twice may not be laid out by two threads at
+  // once.
+  std::vector<txt::Paragraph*> sorted_paragraphs(paragraphs);
+  std::sort(sorted_paragraphs.begin(), sorted_paragraphs.end());
+  const bool has_duplicates =
+      std::adjacent_find(sorted_paragraphs.begin(), sorted_paragraphs.end()) !=
+      sorted_paragraphs.end();
+  if (!runner || paragraphs.size() < 2 || has_duplicates) {
+    for (size_t i = 0; i < paragraphs.size(); i++) {
+      paragraphs[i]->Layout(widths[i]);
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<LayoutBatch>(paragraphs, widths);
+  // The calling thread lays out paragraphs too.
+  const size_t helper_count =
+      std::min<size_t>(paragraphs.size() - 1,
+                       std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < helper_count; i++) {
+    runner->PostTask([batch]() {
+      TRACE_EVENT0("flutter", "Paragraph::LayoutAll::Worker");
+      batch->Run();
+    });
+  }
+  batch->Run();
+  batch->remaining.Wait();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   SkCanvas* sk_canvas = canvas->canvas();
   if (!sk_canvas) {
     return;
   }
   m_paragraph->Paint(sk_canvas, x, y);
+  uint64_t hash = m_paragraph->GetContentHash();
+  canvas->AddContentHash(hash != 0 ? fml::HashCombine64(hash, x, y) : 0);
 }
 
 static tonic::Float32List EncodeTextBoxes(
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_LIB_UI_TEXT_PARAGRAPH_H_
 #define FLUTTER_LIB_UI_TEXT_PARAGRAPH_H_
 
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/canvas.h"
@@ -43,6 +47,9 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   void layout(double width);
   void paint(Canvas* canvas, double x, double y);
 
+  static void layoutAll(const std::vector<Paragraph*>& paragraphs,
+                        const std::vector<double>& widths);
+
   tonic::Float32List getRectsForRange(unsigned start,
                                       unsigned end,
                                       unsigned boxHeightStyle,
@@ -55,6 +62,15 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
   size_t GetAllocationSize() const override;
 
+  /// Lays out each of |paragraphs| at the width at the same index of
+  /// |widths|. The paragraphs are laid out concurrently on |runner| and on the
+  /// calling thread, or only on the calling thread if |runner| is null. All of
+  /// them are laid out when this returns.
+  static void LayoutAll(
+      const std::vector<txt::Paragraph*>& paragraphs,
+      const std::vector<double>& widths,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& runner);
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
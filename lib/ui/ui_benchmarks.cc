@@ -4,12 +4,20 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/lib/ui/text/font_collection.h"
+#include "flutter/lib/ui/text/paragraph.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "flutter/third_party/txt/src/txt/paragraph_builder.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 #include <future>
 
@@ -112,9 +120,117 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Measures the encoding of a packet of touch moves and its decoding in Dart,
+// in the full encoding (0) and the compact encoding (1).
+static void BM_DispatchPointerDataPacket(benchmark::State& state) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate = testing::RunDartCodeInIsolate(
+      vm_ref, settings, task_runners, "receivePointerDataPackets", {},
+      testing::GetFixturesPath(), {});
+
+  const bool compact = state.range(0) != 0;
+  constexpr size_t kEventCount = 64;
+  PointerDataPacket packet(kEventCount);
+  for (size_t i = 0; i < kEventCount; i++) {
+    PointerData data;
+    data.Clear();
+    data.time_stamp = 1000000 + i * 1000;
+    data.change = PointerData::Change::kMove;
+    data.kind = PointerData::DeviceKind::kTouch;
+    data.device = i % 2;
+    data.physical_x = 100.0 + i;
+    data.physical_y = 200.0 + i * 0.5;
+    data.physical_delta_x = 1.0;
+    data.physical_delta_y = 0.5;
+    data.pressure = 1.0;
+    data.pressure_max = 1.0;
+    packet.SetPointerData(i, data);
+  }
+
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      std::unique_ptr<PointerDataPacket> compact_packet =
+          compact ? packet.EncodeCompact() : nullptr;
+      const std::vector<uint8_t>& buffer =
+          compact ? compact_packet->data() : packet.data();
+      bytes = buffer.size();
+      Dart_Handle data =
+          tonic::DartByteData::Create(buffer.data(), buffer.size());
+      Dart_Handle library = Dart_LookupLibrary(tonic::ToDart("dart:ui"));
+      return !tonic::LogIfError(tonic::DartInvokeField(
+          library,
+          compact ? "_dispatchCompactPointerDataPacket"
+                  : "_dispatchPointerDataPacket",
+          {data}));
+    });
+    FML_CHECK(successful);
+  }
+  state.counters["PacketBytes"] = bytes;
+}
+
+// Lays out a batch of paragraphs one at a time on the calling thread (0) and
+// concurrently on a worker pool (1).
+static void BM_ParagraphLayoutAll(benchmark::State& state) {
+  FontCollection font_collection;
+  font_collection.RegisterTestFonts();
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  std::shared_ptr<fml::ConcurrentTaskRunner> runner =
+      state.range(0) != 0 ? loop->GetTaskRunner() : nullptr;
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = {"Ahem"};
+  text_style.font_size = 14;
+  const std::u16string text =
+      u"A message in a long conversation, wrapped over a few lines so that "
+      u"laying it out takes about as long as laying out a typical chat "
+      u"bubble or a paragraph of a document.";
+
+  constexpr size_t kParagraphCount = 64;
+  const std::vector<double> widths(kParagraphCount, 300);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<std::unique_ptr<txt::Paragraph>> paragraphs;
+    std::vector<txt::Paragraph*> batch;
+    for (size_t i = 0; i < kParagraphCount; i++) {
+      auto builder = txt::ParagraphBuilder::CreateTxtBuilder(
+          paragraph_style, font_collection.GetFontCollection());
+      builder->PushStyle(text_style);
+      builder->AddText(text);
+      builder->Pop();
+      paragraphs.push_back(builder->Build());
+      batch.push_back(paragraphs.back().get());
+    }
+    state.ResumeTiming();
+
+    Paragraph::LayoutAll(batch, widths, runner);
+  }
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_DispatchPointerDataPacket)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_ParagraphLayoutAll)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
 }  // namespace flutter
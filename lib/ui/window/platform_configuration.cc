@@ -278,7 +278,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? WrapByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -298,6 +298,57 @@ void PlatformConfiguration::DispatchPlatformMessage(
                               tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  if (messages.size() == 1) {
+    DispatchPlatformMessage(std::move(messages.front()));
+    return;
+  }
+  std::shared_ptr<tonic::DartState> dart_state = library_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING) << "Dropping " << messages.size()
+                      << " platform messages for lack of DartState.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+
+  std::vector<std::string> names;
+  std::vector<Dart_Handle> data;
+  std::vector<int> response_ids;
+  for (auto& message : messages) {
+    Dart_Handle data_handle =
+        (message->hasData()) ? WrapByteData(message->releaseData())
+                             : Dart_Null();
+    if (Dart_IsError(data_handle)) {
+      FML_DLOG(WARNING)
+          << "Dropping platform message because of a Dart error on channel: "
+          << message->channel();
+      continue;
+    }
+
+    int response_id = 0;
+    if (auto response = message->response()) {
+      response_id = next_response_id_++;
+      pending_responses_[response_id] = response;
+    }
+
+    names.push_back(message->channel());
+    data.push_back(data_handle);
+    response_ids.push_back(response_id);
+  }
+
+  // The data is passed as a List<dynamic>, as there is no converter for a list
+  // of nullable ByteData.
+  Dart_Handle data_list = Dart_NewList(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    Dart_ListSetAt(data_list, i, data[i]);
+  }
+
+  tonic::LogIfError(tonic::DartInvokeField(
+      library_.value(), "_dispatchPlatformMessages",
+      {tonic::ToDart(names), data_list, tonic::ToDart(response_ids)}));
+}
+
 void PlatformConfiguration::DispatchSemanticsAction(int32_t id,
                                                     SemanticsAction action,
                                                     std::vector<uint8_t> args) {
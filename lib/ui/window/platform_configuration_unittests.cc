@@ -6,7 +6,9 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -15,6 +17,7 @@
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 namespace flutter {
 namespace testing {
@@ -140,5 +143,65 @@ TEST_F(ShellTest, PlatformConfigurationWindowMetricsUpdate) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, LargePlatformMessagesAreNotCopiedIntoDart) {
+  fml::AutoResetWaitableEvent handler_latch;
+  fml::AutoResetWaitableEvent message_latch;
+
+  std::vector<uint8_t> payload(1024 * 1024);
+  for (size_t i = 0; i < payload.size(); i++) {
+    payload[i] = i % 251;
+  }
+  auto mapping = std::make_unique<fml::DataMapping>(payload);
+  const uint8_t* mapping_bytes = mapping->GetMapping();
+
+  auto nativeOnPlatformMessageHandlerSet = [&](Dart_NativeArguments args) {
+    handler_latch.Signal();
+  };
+
+  auto nativeValidatePlatformMessage = [&](Dart_NativeArguments args) {
+    auto handle = Dart_GetNativeArgument(args, 0);
+    EXPECT_EQ(Dart_GetTypeOfExternalTypedData(handle),
+              Dart_TypedData_kByteData);
+    tonic::DartByteData data(handle);
+    // Dart reads the bytes of the mapping the message was created with.
+    EXPECT_EQ(data.data(), mapping_bytes);
+    ASSERT_EQ(data.length_in_bytes(), payload.size());
+    EXPECT_EQ(memcmp(data.data(), payload.data(), payload.size()), 0);
+    message_latch.Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("OnPlatformMessageHandlerSet",
+                    CREATE_NATIVE_ENTRY(nativeOnPlatformMessageHandlerSet));
+  AddNativeCallback("ValidatePlatformMessage",
+                    CREATE_NATIVE_ENTRY(nativeValidatePlatformMessage));
+
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("receivePlatformMessage");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  handler_latch.Wait();
+  shell->GetPlatformView()->DispatchPlatformMessage(
+      fml::MakeRefCounted<PlatformMessage>("test/channel", std::move(mapping),
+                                           nullptr));
+
+  message_latch.Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,22 +6,39 @@
 
 #include <utility>
 
+#include "flutter/fml/logging.h"
+
 namespace flutter {
 
 PlatformMessage::PlatformMessage(std::string channel,
                                  std::vector<uint8_t> data,
                                  fml::RefPtr<PlatformMessageResponse> response)
+    : PlatformMessage(std::move(channel),
+                      std::make_unique<fml::DataMapping>(std::move(data)),
+                      std::move(response)) {}
+
+PlatformMessage::PlatformMessage(std::string channel,
+                                 std::unique_ptr<fml::Mapping> data,
+                                 fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
       data_(std::move(data)),
       hasData_(true),
-      response_(std::move(response)) {}
+      response_(std::move(response)) {
+  FML_DCHECK(data_);
+}
+
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
-      data_(),
+      data_(std::make_unique<fml::DataMapping>(std::vector<uint8_t>())),
       hasData_(false),
       response_(std::move(response)) {}
 
 PlatformMessage::~PlatformMessage() = default;
 
+std::unique_ptr<fml::Mapping> PlatformMessage::releaseData() {
+  return std::exchange(
+      data_, std::make_unique<fml::DataMapping>(std::vector<uint8_t>()));
+}
+
 }  // namespace flutter
@@ -14,6 +14,34 @@
 
 namespace flutter {
 
+namespace {
+
+// Smaller mappings are copied into the Dart heap, which is cheaper than
+// tracking an external allocation.
+constexpr size_t kExternalByteDataThreshold = 1000;
+
+void FinalizeMapping(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<fml::Mapping*>(peer);
+}
+
+}  // namespace
+
+Dart_Handle WrapByteData(std::unique_ptr<fml::Mapping> mapping) {
+  const size_t size = mapping->GetSize();
+  uint8_t* bytes = mapping->GetMutableMapping();
+  if (bytes == nullptr || size < kExternalByteDataThreshold) {
+    return tonic::DartByteData::Create(mapping->GetMapping(), size);
+  }
+  Dart_Handle byte_data = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, bytes, size, mapping.get(), size,
+      FinalizeMapping);
+  if (!Dart_IsError(byte_data)) {
+    // The finalizer owns the mapping now.
+    mapping.release();
+  }
+  return byte_data;
+}
+
 PlatformMessageResponseDart::PlatformMessageResponseDart(
     tonic::DartPersistentValue callback,
     fml::RefPtr<fml::TaskRunner> ui_task_runner)
@@ -42,8 +70,7 @@ void PlatformMessageResponseDart::Complete(std::unique_ptr<fml::Mapping> data) {
         }
         tonic::DartState::Scope scope(dart_state);
 
-        Dart_Handle byte_buffer =
-            tonic::DartByteData::Create(data->GetMapping(), data->GetSize());
+        Dart_Handle byte_buffer = WrapByteData(std::move(data));
         tonic::DartInvoke(callback.Release(), {byte_buffer});
       }));
 }
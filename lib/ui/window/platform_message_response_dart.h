@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_H_
 #define FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_H_
 
+#include <memory>
+
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
 #include "third_party/tonic/dart_persistent_value.h"
@@ -29,6 +32,11 @@ class PlatformMessageResponseDart : public PlatformMessageResponse {
   fml::RefPtr<fml::TaskRunner> ui_task_runner_;
 };
 
+// Creates a ByteData holding the bytes of |mapping|. Large mutable mappings
+// are handed to Dart as external typed data, which keeps the mapping alive
+// instead of copying it. Must be called in a Dart scope.
+Dart_Handle WrapByteData(std::unique_ptr<fml::Mapping> mapping);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_RESPONSE_DART_H_
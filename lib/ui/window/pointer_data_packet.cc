@@ -4,20 +4,119 @@
 
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 
+#include <cmath>
 #include <cstring>
+#include <limits>
+
+#include "flutter/fml/logging.h"
 
 namespace flutter {
 
+namespace {
+
+// Must match _kCompactPointerDataVersion in platform_dispatcher.dart.
+constexpr uint8_t kCompactPointerDataVersion = 1;
+
+// The bit mask of the indices of the double fields of |PointerData|.
+// Must match _kPointerDataDoubleFields in platform_dispatcher.dart.
+constexpr uint32_t kPointerDataDoubleFields =
+    (0xFu << 7) | (0xFFFu << 14) | (0x3u << 27);
+
+void WriteVarint(std::vector<uint8_t>& buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteBytes(std::vector<uint8_t>& buffer, const void* bytes, size_t size) {
+  const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+  buffer.insert(buffer.end(), begin, begin + size);
+}
+
+bool IsFloat(double value) {
+  return std::fabs(value) <= std::numeric_limits<float>::max() &&
+         static_cast<double>(static_cast<float>(value)) == value;
+}
+
+}  // namespace
+
 PointerDataPacket::PointerDataPacket(size_t count)
     : data_(count * sizeof(PointerData)) {}
 
 PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes)
     : data_(data, data + num_bytes) {}
 
+PointerDataPacket::PointerDataPacket(std::vector<uint8_t> data,
+                                     Encoding encoding)
+    : data_(std::move(data)), encoding_(encoding) {}
+
 PointerDataPacket::~PointerDataPacket() = default;
 
 void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
 }
 
+std::unique_ptr<PointerDataPacket> PointerDataPacket::EncodeCompact() const {
+  FML_DCHECK(encoding_ == Encoding::kFull);
+  static_assert(kPointerDataFieldCount <= 32, "The field masks are 32 bits.");
+  const size_t count = data_.size() / sizeof(PointerData);
+
+  std::vector<uint8_t> buffer;
+  // Simple moves take around 24 bytes.
+  buffer.reserve(16 + count * 32);
+  buffer.push_back(kCompactPointerDataVersion);
+  WriteVarint(buffer, count);
+
+  uint64_t previous[kPointerDataFieldCount] = {};
+  uint64_t fields[kPointerDataFieldCount];
+  for (size_t i = 0; i < count; i++) {
+    memcpy(fields, &data_[i * sizeof(PointerData)], sizeof(PointerData));
+
+    uint32_t changed = 0;
+    uint32_t floats = 0;
+    for (int field = 0; field < kPointerDataFieldCount; field++) {
+      const uint32_t bit = 1u << field;
+      if (fields[field] == previous[field]) {
+        continue;
+      }
+      changed |= bit;
+      if (kPointerDataDoubleFields & bit) {
+        double value;
+        memcpy(&value, &fields[field], sizeof(value));
+        if (IsFloat(value)) {
+          floats |= bit;
+        }
+      }
+    }
+    WriteVarint(buffer, changed);
+    WriteVarint(buffer, floats);
+
+    for (int field = 0; field < kPointerDataFieldCount; field++) {
+      const uint32_t bit = 1u << field;
+      if (!(changed & bit)) {
+        continue;
+      }
+      if (floats & bit) {
+        double value;
+        memcpy(&value, &fields[field], sizeof(value));
+        const float float_value = static_cast<float>(value);
+        WriteBytes(buffer, &float_value, sizeof(float_value));
+      } else if (kPointerDataDoubleFields & bit) {
+        WriteBytes(buffer, &fields[field], sizeof(fields[field]));
+      } else {
+        const int64_t delta =
+            static_cast<int64_t>(fields[field] - previous[field]);
+        WriteVarint(buffer, (static_cast<uint64_t>(delta) << 1) ^
+                                static_cast<uint64_t>(delta >> 63));
+      }
+    }
+    memcpy(previous, fields, sizeof(fields));
+  }
+
+  return std::unique_ptr<PointerDataPacket>(
+      new PointerDataPacket(std::move(buffer), Encoding::kCompact));
+}
+
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_PACKET_H_
 
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -15,6 +16,25 @@ namespace flutter {
 
 class PointerDataPacket {
  public:
+  /// The layout of the bytes of a packet.
+  enum class Encoding {
+    /// An array of |PointerData|.
+    kFull,
+
+    /// A version byte and the varint encoded number of events, followed by
+    /// every event encoded against the one before it (the first one against
+    /// an event with all its fields set to zero). An event starts with two
+    /// varint encoded bit masks of the indices of its fields: the fields that
+    /// differ from the previous event, and among them the double fields whose
+    /// value is exactly representable as a float. The changed fields follow in
+    /// order: integer fields as the zigzag varint of their difference with the
+    /// previous event, and double fields as a float or a double.
+    ///
+    /// This is decoded by `_unpackCompactPointerDataPacket` in
+    /// platform_dispatcher.dart.
+    kCompact,
+  };
+
   explicit PointerDataPacket(size_t count);
   PointerDataPacket(uint8_t* data, size_t num_bytes);
   ~PointerDataPacket();
@@ -22,8 +42,17 @@ class PointerDataPacket {
   void SetPointerData(size_t i, const PointerData& data);
   const std::vector<uint8_t>& data() const { return data_; }
 
+  Encoding encoding() const { return encoding_; }
+
+  /// Returns a packet holding the events of this |Encoding::kFull| packet in
+  /// the |Encoding::kCompact| encoding.
+  std::unique_ptr<PointerDataPacket> EncodeCompact() const;
+
  private:
   std::vector<uint8_t> data_;
+  Encoding encoding_ = Encoding::kFull;
+
+  PointerDataPacket(std::vector<uint8_t> data, Encoding encoding);
 
   FML_DISALLOW_COPY_AND_ASSIGN(PointerDataPacket);
 };
@@ -32,8 +32,12 @@ void Window::DispatchPointerDataPacket(const PointerDataPacket& packet) {
   if (Dart_IsError(data_handle)) {
     return;
   }
-  tonic::LogIfError(tonic::DartInvokeField(
-      library_.value(), "_dispatchPointerDataPacket", {data_handle}));
+  const char* hook =
+      packet.encoding() == PointerDataPacket::Encoding::kCompact
+          ? "_dispatchCompactPointerDataPacket"
+          : "_dispatchPointerDataPacket";
+  tonic::LogIfError(
+      tonic::DartInvokeField(library_.value(), hook, {data_handle}));
 }
 
 void Window::UpdateWindowMetrics(const ViewportMetrics& metrics) {
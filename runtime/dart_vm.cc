@@ -258,6 +258,16 @@ std::shared_ptr<DartVM> DartVM::Create(
 
 static std::atomic_size_t gVMLaunchCount;
 
+static fml::ConcurrentMessageLoop::Options ConcurrentMessageLoopOptions(
+    const Settings& settings) {
+  fml::ConcurrentMessageLoop::Options options;
+  if (settings.enable_work_stealing_workers) {
+    options.scheduling = fml::ConcurrentMessageLoop::Scheduling::kWorkStealing;
+  }
+  options.pin_workers_to_cpus = settings.pin_worker_threads;
+  return options;
+}
+
 size_t DartVM::GetVMLaunchCount() {
   return gVMLaunchCount;
 }
@@ -265,7 +275,8 @@ size_t DartVM::GetVMLaunchCount() {
 DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                std::shared_ptr<IsolateNameServer> isolate_name_server)
     : settings_(vm_data->GetSettings()),
-      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
+      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create(
+          ConcurrentMessageLoopOptions(settings_))),
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
               fml::closure work) { runner->PostTask(work); }),
@@ -41,9 +41,12 @@ class Animator final {
     virtual void OnAnimatorDrawLastLayerTree() = 0;
   };
 
+  /// A |pipeline_depth| of 0 selects the default depth for |task_runners|.
   Animator(Delegate& delegate,
            TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           FramePacingMode pacing_mode = FramePacingMode::kFifo,
+           uint32_t pipeline_depth = 0);
 
   ~Animator();
 
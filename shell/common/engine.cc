@@ -25,6 +25,7 @@
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "txt/fallback_font_cache.h"
 
 namespace flutter {
 
@@ -50,10 +51,28 @@ Engine::Engine(
       runtime_controller_(std::move(runtime_controller)),
       activity_running_(true),
       have_surface_(false),
-      image_decoder_(task_runners, image_decoder_task_runner, io_manager),
+      image_decoder_(task_runners,
+                     image_decoder_task_runner,
+                     io_manager,
+                     settings_.max_concurrent_image_decodes > 0
+                         ? settings_.max_concurrent_image_decodes
+                         : ImageDecoder::kDefaultMaxConcurrentDecodes),
       task_runners_(std::move(task_runners)),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  image_decoder_.SetFrameDecodeOptions(
+      {settings_.animated_image_lookahead_frames,
+       settings_.animated_image_cache_max_bytes});
+  if (settings_.text_layout_cache_max_bytes > 0) {
+    txt::FontCollection::SetLayoutCacheMaxBytes(
+        settings_.text_layout_cache_max_bytes);
+  }
+  if (!settings_.font_fallback_cache_path.empty()) {
+    task_runners_.GetIOTaskRunner()->PostTask(
+        [path = settings_.font_fallback_cache_path]() {
+          txt::FallbackFontCache::GetInstance().LoadSnapshot(path);
+        });
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -187,6 +206,7 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 void Engine::BeginFrame(fml::TimePoint frame_time) {
   TRACE_EVENT0("flutter", "Engine::BeginFrame");
   runtime_controller_->BeginFrame(frame_time);
+  txt::FontCollection::TraceLayoutCacheStats();
 }
 
 void Engine::ReportTimings(std::vector<int64_t> timings) {
@@ -204,6 +224,11 @@ void Engine::NotifyIdle(int64_t deadline) {
                trace_event.c_str());
   runtime_controller_->NotifyIdle(deadline, hint_freed_bytes_since_last_idle_);
   hint_freed_bytes_since_last_idle_ = 0;
+  if (!settings_.font_fallback_cache_path.empty() &&
+      txt::FallbackFontCache::GetInstance().ScheduleSave()) {
+    task_runners_.GetIOTaskRunner()->PostTask(
+        []() { txt::FallbackFontCache::GetInstance().SaveSnapshot(); });
+  }
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -255,36 +280,65 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
 }
 
 void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
+  if (HandleEnginePlatformMessage(message)) {
+    return;
+  }
+
   std::string channel = message->channel();
-  if (channel == kLifecycleChannel) {
-    if (HandleLifecyclePlatformMessage(message.get())) {
-      return;
+  if (runtime_controller_->IsRootIsolateRunning() &&
+      runtime_controller_->DispatchPlatformMessage(std::move(message))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
+}
+
+void Engine::DispatchPlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  std::vector<fml::RefPtr<PlatformMessage>> isolate_messages;
+  isolate_messages.reserve(messages.size());
+  for (auto& message : messages) {
+    if (!HandleEnginePlatformMessage(message)) {
+      isolate_messages.push_back(std::move(message));
     }
+  }
+  if (isolate_messages.empty()) {
+    return;
+  }
+
+  const size_t count = isolate_messages.size();
+  if (runtime_controller_->IsRootIsolateRunning() &&
+      runtime_controller_->DispatchPlatformMessages(
+          std::move(isolate_messages))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping " << count << " platform messages.";
+}
+
+bool Engine::HandleEnginePlatformMessage(
+    fml::RefPtr<PlatformMessage>& message) {
+  const std::string& channel = message->channel();
+  if (channel == kLifecycleChannel) {
+    return HandleLifecyclePlatformMessage(message.get());
   } else if (channel == kLocalizationChannel) {
-    if (HandleLocalizationPlatformMessage(message.get())) {
-      return;
-    }
+    return HandleLocalizationPlatformMessage(message.get());
   } else if (channel == kSettingsChannel) {
     HandleSettingsPlatformMessage(message.get());
-    return;
+    return true;
   } else if (!runtime_controller_->IsRootIsolateRunning() &&
              channel == kNavigationChannel) {
     // If there's no runtime_, we may still need to set the initial route.
     HandleNavigationPlatformMessage(std::move(message));
-    return;
-  }
-
-  if (runtime_controller_->IsRootIsolateRunning() &&
-      runtime_controller_->DispatchPlatformMessage(std::move(message))) {
-    return;
+    return true;
   }
-
-  FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
+  return false;
 }
 
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string state(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string state(reinterpret_cast<const char*>(data.GetMapping()),
+                    data.GetSize());
   if (state == "AppLifecycleState.paused" ||
       state == "AppLifecycleState.detached") {
     activity_running_ = false;
@@ -311,7 +365,8 @@ bool Engine::HandleNavigationPlatformMessage(
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -329,7 +384,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -369,7 +425,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string jsonData(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
+                       data.GetSize());
   if (runtime_controller_->SetUserSettingsData(std::move(jsonData)) &&
       have_surface_) {
     ScheduleFrame();
@@ -472,7 +529,11 @@ void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
   if (runtime_controller_) {
-    runtime_controller_->DispatchPointerDataPacket(*packet);
+    if (settings_.compact_pointer_data_packets) {
+      runtime_controller_->DispatchPointerDataPacket(*packet->EncodeCompact());
+    } else {
+      runtime_controller_->DispatchPointerDataPacket(*packet);
+    }
   }
 }
 
@@ -486,8 +547,8 @@ void Engine::HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message) {
     return;
   }
   const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.data()),
-                         data.size());
+  std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
+                         data.GetSize());
 
   if (asset_manager_) {
     std::unique_ptr<fml::Mapping> asset_mapping =
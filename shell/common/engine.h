@@ -689,6 +689,19 @@ class Engine final : public RuntimeDelegate,
   ///
   void DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it a batch of
+  ///             messages that arrived while the UI task runner was busy. The
+  ///             messages the engine does not handle itself are delivered to
+  ///             the root isolate in a single call, in the order in which
+  ///             they were sent.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -910,6 +923,10 @@ class Engine final : public RuntimeDelegate,
 
   void StartAnimatorIfPossible();
 
+  // Returns true if |message| was consumed by the engine and must not be
+  // dispatched to the root isolate.
+  bool HandleEnginePlatformMessage(fml::RefPtr<PlatformMessage>& message);
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(fml::RefPtr<PlatformMessage> message);
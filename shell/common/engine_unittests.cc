@@ -65,6 +65,8 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(fml::RefPtr<PlatformMessage>));
+  MOCK_METHOD1(DispatchPlatformMessages,
+               bool(std::vector<fml::RefPtr<PlatformMessage>>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
 };
@@ -239,6 +241,48 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesForwardsBatchInOrder) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    std::vector<std::string> channels;
+    EXPECT_CALL(*mock_runtime_controller, DispatchPlatformMessage(::testing::_))
+        .Times(0);
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages(::testing::_))
+        .WillOnce([&channels](
+                      std::vector<fml::RefPtr<PlatformMessage>> messages) {
+          for (const auto& message : messages) {
+            channels.push_back(message->channel());
+          }
+          return true;
+        });
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    // The settings message is handled by the engine and is not forwarded.
+    std::vector<fml::RefPtr<PlatformMessage>> messages;
+    for (const char* channel :
+         {"sensor", "flutter/settings", "other", "sensor"}) {
+      messages.push_back(fml::MakeRefCounted<PlatformMessage>(
+          channel, fml::MakeRefCounted<MockResponse>()));
+    }
+    engine->DispatchPlatformMessages(std::move(messages));
+    EXPECT_EQ(channels,
+              std::vector<std::string>({"sensor", "other", "sensor"}));
+  });
+}
+
 TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   PostUITaskSync([this] {
     intptr_t error_id = 123;
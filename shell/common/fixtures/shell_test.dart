@@ -14,6 +14,7 @@ void main() {}
 void nativeReportTimingsCallback(List<int> timings) native 'NativeReportTimingsCallback';
 void nativeOnBeginFrame(int microseconds) native 'NativeOnBeginFrame';
 void nativeOnPointerDataPacket(List<int> sequences) native 'NativeOnPointerDataPacket';
+void nativeOnPointerDataFields(List<double> fields) native 'NativeOnPointerDataFields';
 
 @pragma('vm:entry-point')
 void reportTimingsMain() {
@@ -46,6 +47,23 @@ void onPointerDataPacketMain() {
   };
 }
 
+@pragma('vm:entry-point')
+void onPointerDataFieldsMain() {
+  PlatformDispatcher.instance.onPointerDataPacket = (PointerDataPacket packet) {
+    List<double> fields = <double>[];
+    for (PointerData data in packet.data) {
+      fields.add(data.timeStamp.inMicroseconds.toDouble());
+      fields.add(PointerChange.values.indexOf(data.change).toDouble());
+      fields.add(data.device.toDouble());
+      fields.add(data.physicalX);
+      fields.add(data.physicalY);
+      fields.add(data.physicalDeltaY);
+      fields.add(data.pressure);
+    }
+    nativeOnPointerDataFields(fields);
+  };
+}
+
 @pragma('vm:entry-point')
 void emptyMain() {}
 
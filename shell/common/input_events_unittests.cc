@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -412,5 +414,196 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, CanDispatchCompactPointerPacket) {
+  auto settings = CreateSettingsForFixture();
+  settings.compact_pointer_data_packets = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings, true);
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onPointerDataFieldsMain");
+  fml::AutoResetWaitableEvent reportLatch;
+  std::vector<double> fields;
+  auto nativeOnPointerDataFields = [&reportLatch,
+                                    &fields](Dart_NativeArguments args) {
+    Dart_Handle exception = nullptr;
+    fields = tonic::DartConverter<std::vector<double>>::FromArguments(
+        args, 0, exception);
+    reportLatch.Signal();
+  };
+  AddNativeCallback("NativeOnPointerDataFields",
+                    CREATE_NATIVE_ENTRY(nativeOnPointerDataFields));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+
+  // The values cover fields that are unchanged, decreasing, negative, and not
+  // representable as floats. The packet converter fills in the delta of the
+  // move.
+  auto packet = std::make_unique<PointerDataPacket>(4);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 1.0 / 3.0, 4.5);
+  data.time_stamp = 123456789;
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 1.0 / 3.0, 4.5);
+  data.time_stamp = 123464789;
+  data.pressure = 0.75;
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1.0 / 3.0, 2.5);
+  data.time_stamp = 123464788;
+  data.pressure = 0.75;
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 1.0 / 3.0, 2.5);
+  data.time_stamp = 123472789;
+  packet->SetPointerData(3, data);
+  ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+  bool will_draw_new_frame;
+  ShellTest::VSyncFlush(shell.get(), will_draw_new_frame);
+
+  reportLatch.Wait();
+  const std::vector<double> expected = {
+      123456789, 1, 0, 1.0 / 3.0, 4.5, 0.0,  0.0,   //
+      123464789, 4, 0, 1.0 / 3.0, 4.5, 0.0,  0.75,  //
+      123464788, 5, 0, 1.0 / 3.0, 2.5, -2.0, 0.75,  //
+      123472789, 6, 0, 1.0 / 3.0, 2.5, 0.0,  0.0,   //
+  };
+  ASSERT_EQ(fields, expected);
+
+  DestroyShell(std::move(shell));
+}
+
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    const auto& buffer = packet->data();
+    std::vector<PointerData> events(buffer.size() / sizeof(PointerData));
+    memcpy(events.data(), buffer.data(), buffer.size());
+    packets.push_back(std::move(events));
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::vector<PointerData>> packets;
+  fml::closure vsync_callback;
+};
+
+static std::unique_ptr<PointerDataPacket> MakePointerDataPacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+static PointerData CreateSimulatedMove(int64_t device,
+                                       int64_t time_stamp,
+                                       double x,
+                                       double delta_x) {
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, x, 0.0);
+  data.device = device;
+  data.time_stamp = time_stamp;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+TEST(CoalescingPointerDataDispatcherTest, MergesMovesOfEachDevicePerFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(
+      delegate, CoalescingPointerDataDispatcher::Options{});
+
+  PointerData down;
+  CreateSimulatedPointerData(down, PointerData::Change::kDown, 0.0, 0.0);
+  dispatcher.DispatchPacket(MakePointerDataPacket({down}), 0);
+  // Nothing was in progress, so the packet is dispatched right away.
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  PointerData hover;
+  CreateSimulatedPointerData(hover, PointerData::Change::kHover, 5.0, 0.0);
+  hover.device = 1;
+  hover.kind = PointerData::DeviceKind::kMouse;
+  PointerData up;
+  CreateSimulatedPointerData(up, PointerData::Change::kUp, 6.0, 0.0);
+  dispatcher.DispatchPacket(
+      MakePointerDataPacket({CreateSimulatedMove(0, 0, 1.0, 1.0)}), 1);
+  dispatcher.DispatchPacket(
+      MakePointerDataPacket({CreateSimulatedMove(0, 0, 3.0, 2.0), hover}), 2);
+  dispatcher.DispatchPacket(
+      MakePointerDataPacket({CreateSimulatedMove(0, 0, 6.0, 3.0), up}), 3);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  const std::vector<PointerData>& events = delegate.packets.back();
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].change, PointerData::Change::kMove);
+  EXPECT_EQ(events[0].physical_x, 6.0);
+  EXPECT_EQ(events[0].physical_delta_x, 6.0);
+  EXPECT_EQ(events[1].change, PointerData::Change::kHover);
+  EXPECT_EQ(events[1].device, 1);
+  EXPECT_EQ(events[2].change, PointerData::Change::kUp);
+  EXPECT_EQ(dispatcher.GetLastDispatchedHistory().size(), 5u);
+
+  // Nothing is pending, so the next vsync ends the dispatch in progress.
+  delegate.FireVsync();
+  EXPECT_EQ(delegate.packets.size(), 2u);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, ResamplesMovesBehindVsync) {
+  FakePointerDataDispatcherDelegate delegate;
+  fml::TimePoint now =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMicroseconds(100000));
+  CoalescingPointerDataDispatcher::Options options;
+  options.resample = true;
+  options.resampling_delay = fml::TimeDelta::FromMicroseconds(8000);
+  options.clock = [&now]() { return now; };
+  CoalescingPointerDataDispatcher dispatcher(delegate, options);
+
+  PointerData down;
+  CreateSimulatedPointerData(down, PointerData::Change::kDown, 0.0, 0.0);
+  down.time_stamp = 60000;
+  dispatcher.DispatchPacket(
+      MakePointerDataPacket({down, CreateSimulatedMove(0, 70000, 0.0, 0.0),
+                             CreateSimulatedMove(0, 90000, 10.0, 10.0),
+                             CreateSimulatedMove(0, 95000, 20.0, 10.0)}),
+      0);
+  // Resampled events are only dispatched at vsync.
+  ASSERT_TRUE(delegate.packets.empty());
+
+  // The sample time is 92000, between the second and the third move.
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  ASSERT_EQ(delegate.packets[0].size(), 2u);
+  const PointerData& resampled = delegate.packets[0][1];
+  EXPECT_EQ(resampled.time_stamp, 92000);
+  EXPECT_DOUBLE_EQ(resampled.physical_x, 14.0);
+  EXPECT_DOUBLE_EQ(resampled.physical_delta_x, 14.0);
+  EXPECT_EQ(dispatcher.GetLastDispatchedHistory().size(), 3u);
+
+  // The held move is dispatched with the rest of its delta once the sample
+  // time passes it.
+  now = now + fml::TimeDelta::FromMilliseconds(16);
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  ASSERT_EQ(delegate.packets[1].size(), 1u);
+  EXPECT_EQ(delegate.packets[1][0].time_stamp, 95000);
+  EXPECT_DOUBLE_EQ(delegate.packets[1][0].physical_x, 20.0);
+  EXPECT_DOUBLE_EQ(delegate.packets[1][0].physical_delta_x, 6.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -12,6 +12,7 @@
 #include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/unique_fd.h"
@@ -307,5 +308,263 @@ TEST_F(ShellTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, PrefetchedSkSLsMatchLoadedSkSLs) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.cache_sksl = true;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+
+  // Enough SkSLs to be read by several prefetch tasks.
+  const size_t kShaderCount = 40;
+  for (size_t i = 0; i < kShaderCount; i++) {
+    StorePersistentCache(persistent_cache,
+                         *SkData::MakeWithCString(std::to_string(i).c_str()),
+                         *SkData::MakeWithCString("value"));
+  }
+  std::promise<bool> io_flushed;
+  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [&io_flushed]() { io_flushed.set_value(true); });
+  io_flushed.get_future().get();  // Wait for the IO thread to flush the files.
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), kShaderCount);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  persistent_cache->PrefetchSkSLs(loop->GetTaskRunner());
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), kShaderCount);
+
+  // Loading again without a new prefetch reads the files directly.
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), kShaderCount);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, PruneRemovesLeastUsedEntries) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+
+  sk_sp<SkData> cold_key = SkData::MakeWithCString("cold");
+  sk_sp<SkData> hot_key = SkData::MakeWithCString("hot");
+  sk_sp<SkData> value = SkData::MakeWithCString(std::string(99, 'x').c_str());
+  StorePersistentCache(persistent_cache, *cold_key, *value);
+  StorePersistentCache(persistent_cache, *hot_key, *value);
+  WaitForIO(shell.get());
+  ASSERT_NE(persistent_cache->load(*hot_key), nullptr);
+  ASSERT_EQ(persistent_cache->GetUsage(*cold_key).hits, 1u);
+  ASSERT_EQ(persistent_cache->GetUsage(*hot_key).hits, 2u);
+
+  // Nothing is removed while the cache is within the limit.
+  persistent_cache->Prune(200);
+  WaitForIO(shell.get());
+  ASSERT_EQ(persistent_cache->GetUsage(*cold_key).hits, 1u);
+
+  persistent_cache->Prune(150);
+  WaitForIO(shell.get());
+  ASSERT_EQ(persistent_cache->GetUsage(*cold_key).hits, 0u);
+  ASSERT_EQ(persistent_cache->load(*cold_key), nullptr);
+  ASSERT_NE(persistent_cache->load(*hot_key), nullptr);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, LoadsHotSkSLsFirst) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.cache_sksl = true;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+
+  // Skia stores an SkSL every time it compiles it.
+  for (const char* key : {"a", "b", "c", "b", "c", "b"}) {
+    StorePersistentCache(persistent_cache, *SkData::MakeWithCopy(key, 1),
+                         *SkData::MakeWithCString("value"));
+  }
+  WaitForIO(shell.get());
+
+  auto hot_sksls = persistent_cache->LoadHotSkSLs(2);
+  ASSERT_EQ(hot_sksls.size(), 2u);
+  CheckTextSkData(hot_sksls[0].first, "b");
+  CheckTextSkData(hot_sksls[1].first, "c");
+  ASSERT_EQ(persistent_cache->LoadHotSkSLs(10).size(), 3u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+static sk_sp<SkData> MakeData(const std::string& string) {
+  return SkData::MakeWithCopy(string.data(), string.size());
+}
+
+static std::string ToString(const sk_sp<SkData>& data) {
+  if (data == nullptr) {
+    return "";
+  }
+  return std::string(static_cast<const char*>(data->data()), data->size());
+}
+
+TEST(PersistentCacheArchiveTest, StoresAndReloadsEntries) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kRead));
+  {
+    PersistentCacheArchive archive(directory, "archive", false);
+    ASSERT_TRUE(archive.IsValid());
+    ASSERT_TRUE(archive.Store(*MakeData("key1"), *MakeData("value1")));
+    ASSERT_TRUE(archive.Store(*MakeData("key2"), *MakeData("value2")));
+    ASSERT_TRUE(archive.Store(*MakeData("key1"), *MakeData("new value1")));
+    ASSERT_EQ(ToString(archive.Load(*MakeData("key1"))), "new value1");
+    ASSERT_GT(archive.GetStaleBytes(), 0u);
+  }
+
+  PersistentCacheArchive archive(directory, "archive", true);
+  ASSERT_TRUE(archive.IsValid());
+  ASSERT_EQ(archive.GetEntryCount(), 2u);
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key1"))), "new value1");
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key2"))), "value2");
+  ASSERT_EQ(archive.Load(*MakeData("key3")), nullptr);
+  ASSERT_EQ(archive.LoadAll().size(), 2u);
+  ASSERT_FALSE(archive.Store(*MakeData("key3"), *MakeData("value3")));
+}
+
+TEST(PersistentCacheArchiveTest, IgnoresCorruptRecords) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kRead));
+  {
+    PersistentCacheArchive archive(directory, "archive", false);
+    ASSERT_TRUE(archive.Store(*MakeData("key1"), *MakeData("value1")));
+    ASSERT_TRUE(archive.Store(*MakeData("key2"), *MakeData("value2")));
+  }
+
+  {
+    // Flip the last byte of the second value.
+    auto file = fml::OpenFile(*directory, "archive", false,
+                              fml::FilePermission::kReadWrite);
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                    fml::FileMapping::Protection::kWrite});
+    ASSERT_NE(mapping.GetMutableMapping(), nullptr);
+    mapping.GetMutableMapping()[mapping.GetSize() - 1] ^= 0xff;
+  }
+
+  PersistentCacheArchive archive(directory, "archive", false);
+  ASSERT_EQ(archive.GetEntryCount(), 1u);
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key1"))), "value1");
+  ASSERT_EQ(archive.Load(*MakeData("key2")), nullptr);
+
+  // The corrupt record is overwritten by the next one.
+  ASSERT_TRUE(archive.Store(*MakeData("key3"), *MakeData("value3")));
+  PersistentCacheArchive reopened(directory, "archive", true);
+  ASSERT_EQ(reopened.GetEntryCount(), 2u);
+  ASSERT_EQ(ToString(reopened.Load(*MakeData("key3"))), "value3");
+}
+
+TEST(PersistentCacheArchiveTest, CompactionDropsStaleRecords) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kRead));
+  PersistentCacheArchive archive(directory, "archive", false);
+  ASSERT_TRUE(archive.Store(*MakeData("other"), *MakeData("other value")));
+  const std::string large_value(4096, 'x');
+  for (int i = 0; i < 64; i++) {
+    ASSERT_TRUE(archive.Store(*MakeData("key"),
+                              *MakeData(large_value + std::to_string(i))));
+  }
+  ASSERT_TRUE(archive.NeedsCompaction());
+  const size_t size_before = archive.GetFileSize();
+
+  ASSERT_TRUE(archive.Compact());
+  ASSERT_LT(archive.GetFileSize(), size_before);
+  ASSERT_EQ(archive.GetStaleBytes(), 0u);
+  ASSERT_FALSE(archive.NeedsCompaction());
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key"))), large_value + "63");
+  ASSERT_EQ(ToString(archive.Load(*MakeData("other"))), "other value");
+
+  ASSERT_TRUE(archive.Clear());
+  ASSERT_EQ(archive.GetEntryCount(), 0u);
+  ASSERT_EQ(archive.Load(*MakeData("key")), nullptr);
+}
+
+TEST(PersistentCacheArchiveTest, RemovesEntries) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kRead));
+  {
+    PersistentCacheArchive archive(directory, "archive", false);
+    ASSERT_TRUE(archive.Store(*MakeData("key1"), *MakeData("value1")));
+    ASSERT_TRUE(archive.Store(*MakeData("key2"), *MakeData("value2")));
+    ASSERT_TRUE(archive.Remove(*MakeData("key1")));
+    ASSERT_EQ(archive.Load(*MakeData("key1")), nullptr);
+    ASSERT_EQ(archive.GetEntryCount(), 1u);
+  }
+
+  PersistentCacheArchive archive(directory, "archive", false);
+  ASSERT_EQ(archive.Load(*MakeData("key1")), nullptr);
+  auto entries = archive.ListEntries();
+  ASSERT_EQ(entries.size(), 1u);
+  ASSERT_EQ(entries[0].first, "key2");
+  ASSERT_EQ(entries[0].second, 6u);
+
+  const size_t stale_bytes = archive.GetStaleBytes();
+  ASSERT_GT(stale_bytes, 0u);
+  ASSERT_TRUE(archive.Compact());
+  ASSERT_EQ(archive.GetStaleBytes(), 0u);
+  ASSERT_EQ(archive.GetEntryCount(), 1u);
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key2"))), "value2");
+
+  // An entry can be stored again after it was removed.
+  ASSERT_TRUE(archive.Store(*MakeData("key1"), *MakeData("value3")));
+  ASSERT_EQ(ToString(archive.Load(*MakeData("key1"))), "value3");
+}
+
+TEST(PersistentCacheUsageTest, SavesAndReloadsUsage) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kRead));
+  {
+    PersistentCacheUsage usage(directory, "usage", false);
+    usage.RecordUse("key1", 100);
+    usage.RecordUse("key1", 200);
+    usage.RecordUse("key2", 150);
+    usage.RecordUse("key3", 150);
+    usage.Remove("key3");
+    ASSERT_TRUE(usage.ScheduleSave());
+    ASSERT_FALSE(usage.ScheduleSave());
+    ASSERT_TRUE(usage.Save());
+  }
+
+  PersistentCacheUsage usage(directory, "usage", true);
+  ASSERT_EQ(usage.GetAll().size(), 2u);
+  ASSERT_EQ(usage.Get("key1").hits, 2u);
+  ASSERT_EQ(usage.Get("key1").last_used, 200);
+  ASSERT_EQ(usage.Get("key2").hits, 1u);
+  ASSERT_EQ(usage.Get("key2").last_used, 150);
+  ASSERT_EQ(usage.Get("key3").hits, 0u);
+  ASSERT_FALSE(usage.ScheduleSave());
+}
+
 }  // namespace testing
 }  // namespace flutter
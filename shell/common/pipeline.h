@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/semaphore.h"
@@ -26,6 +27,14 @@ size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer.
+///
+/// The |FramePacingMode| decides what happens when the producer gets ahead of
+/// the consumer. In the |FramePacingMode::kFifo| mode the pipeline holds up to
+/// |depth| resources, counting the one being consumed, and |Produce| fails
+/// once they are all in use. The other modes ignore |depth| and keep at most
+/// one resource waiting for the consumer: |FramePacingMode::kMailbox| replaces
+/// a waiting resource with a newer one, and |FramePacingMode::kLowLatency|
+/// frees a slot for the producer as soon as the consumer takes a resource.
 template <class R>
 class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
  public:
@@ -90,8 +99,13 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth,
+                    FramePacingMode pacing_mode = FramePacingMode::kFifo)
+      : depth_(depth),
+        pacing_mode_(pacing_mode),
+        empty_(SlotCount(depth, pacing_mode)),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
@@ -156,12 +170,20 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
       items_count = queue_.size();
     }
 
+    if (pacing_mode_ == FramePacingMode::kLowLatency) {
+      // Let the producer start on the next resource while this one is being
+      // consumed.
+      empty_.Signal();
+    }
+
     {
       TRACE_EVENT0("flutter", "PipelineConsume");
       consumer(std::move(resource));
     }
 
-    empty_.Signal();
+    if (pacing_mode_ != FramePacingMode::kLowLatency) {
+      empty_.Signal();
+    }
     --inflight_;
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
@@ -173,16 +195,52 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
 
  private:
   const uint32_t depth_;
+  const FramePacingMode pacing_mode_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  // The number of resources that can be produced before one is consumed.
+  static uint32_t SlotCount(uint32_t depth, FramePacingMode pacing_mode) {
+    switch (pacing_mode) {
+      case FramePacingMode::kFifo:
+        return depth;
+      case FramePacingMode::kMailbox:
+        // One resource being consumed, one waiting and one being produced.
+        return 3;
+      case FramePacingMode::kLowLatency:
+        // The resource being consumed has already released its slot.
+        return 1;
+    }
+    return depth;
+  }
+
   bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
+    ResourcePtr replaced_resource;
+    size_t replaced_trace_id = 0;
+    bool replaced = false;
     {
       std::scoped_lock lock(queue_mutex_);
-      queue_.emplace_back(std::move(resource), trace_id);
+      if (pacing_mode_ == FramePacingMode::kMailbox && !queue_.empty()) {
+        std::tie(replaced_resource, replaced_trace_id) =
+            std::move(queue_.back());
+        queue_.back() = {std::move(resource), trace_id};
+        replaced = true;
+      } else {
+        queue_.emplace_back(std::move(resource), trace_id);
+      }
+    }
+
+    if (replaced) {
+      // The replaced resource is dropped. The consumer was already signaled
+      // for the slot it occupied, which now holds the new resource.
+      TRACE_FLOW_END("flutter", "PipelineItem", replaced_trace_id);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", replaced_trace_id);
+      empty_.Signal();
+      --inflight_;
+      return true;
     }
 
     // Ensure the queue mutex is not held as that would be a pessimization.
@@ -131,5 +131,75 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, MailboxReplacesResourceWaitingForConsumer) {
+  fml::RefPtr<IntPipeline> pipeline =
+      fml::MakeRefCounted<IntPipeline>(1, FramePacingMode::kMailbox);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  bool result = continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result, true);
+  result = continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result, true);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
+
+  PipelineConsumeResult consume_result_2 =
+      pipeline->Consume([](std::unique_ptr<int> v) { FAIL(); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::NoneAvailable);
+}
+
+TEST(PipelineTest, MailboxProducerDoesNotWaitForConsumer) {
+  fml::RefPtr<IntPipeline> pipeline =
+      fml::MakeRefCounted<IntPipeline>(1, FramePacingMode::kMailbox);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+
+  PipelineConsumeResult consume_result_1 =
+      pipeline->Consume([&pipeline](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, 1);
+        for (int i = 2; i <= 4; i++) {
+          Continuation continuation = pipeline->Produce();
+          ASSERT_TRUE(continuation);
+          ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)));
+        }
+      });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 4); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, LowLatencyProducesWhileConsuming) {
+  fml::RefPtr<IntPipeline> pipeline =
+      fml::MakeRefCounted<IntPipeline>(2, FramePacingMode::kLowLatency);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  // Only one resource may wait for the consumer, whatever the depth.
+  ASSERT_FALSE(pipeline->Produce());
+
+  Continuation continuation_2;
+  PipelineConsumeResult consume_result_1 =
+      pipeline->Consume([&](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, 1);
+        continuation_2 = pipeline->Produce();
+        ASSERT_TRUE(continuation_2);
+        ASSERT_FALSE(pipeline->Produce());
+      });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
+
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,8 +4,77 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
+namespace {
+
+std::vector<PointerData> ReadPointerData(const PointerDataPacket& packet) {
+  const auto& buffer = packet.data();
+  std::vector<PointerData> events(buffer.size() / sizeof(PointerData));
+  memcpy(events.data(), buffer.data(), events.size() * sizeof(PointerData));
+  return events;
+}
+
+std::unique_ptr<PointerDataPacket> MakePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+bool IsCoalescable(const PointerData& event) {
+  return event.signal_kind == PointerData::SignalKind::kNone &&
+         (event.change == PointerData::Change::kMove ||
+          event.change == PointerData::Change::kHover);
+}
+
+// Whether |event| continues the run of move or hover events of |run|.
+bool ContinuesRun(const PointerData& run, const PointerData& event) {
+  return run.device == event.device && run.change == event.change &&
+         run.kind == event.kind &&
+         run.pointer_identifier == event.pointer_identifier &&
+         run.buttons == event.buttons;
+}
+
+std::vector<PointerData> Coalesce(const std::vector<PointerData>& events) {
+  std::vector<PointerData> coalesced;
+  // Maps a device to the index in |coalesced| of the run its last event
+  // belongs to, if that event is a move or hover event.
+  std::unordered_map<int64_t, size_t> runs;
+  for (const auto& event : events) {
+    auto run = runs.find(event.device);
+    if (!IsCoalescable(event)) {
+      if (run != runs.end()) {
+        runs.erase(run);
+      }
+    } else if (run != runs.end() &&
+               ContinuesRun(coalesced[run->second], event)) {
+      PointerData& merged = coalesced[run->second];
+      const double delta_x = merged.physical_delta_x + event.physical_delta_x;
+      const double delta_y = merged.physical_delta_y + event.physical_delta_y;
+      merged = event;
+      merged.physical_delta_x = delta_x;
+      merged.physical_delta_y = delta_y;
+      continue;
+    } else {
+      runs[event.device] = coalesced.size();
+    }
+    coalesced.push_back(event);
+  }
+  return coalesced;
+}
+
+}  // namespace
+
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
@@ -50,6 +119,147 @@ void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
       });
 }
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    Options options)
+    : DefaultPointerDataDispatcher(delegate),
+      options_(std::move(options)),
+      weak_factory_(this) {}
+
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  std::vector<PointerData> events = ReadPointerData(*packet);
+  pending_events_.insert(pending_events_.end(), events.begin(), events.end());
+  pending_trace_flow_id_ = trace_flow_id;
+  if (is_pointer_data_in_progress_) {
+    return;
+  }
+  if (options_.resample) {
+    is_pointer_data_in_progress_ = true;
+    ScheduleSecondaryVsyncCallback();
+  } else {
+    DispatchPendingEvents();
+  }
+}
+
+void CoalescingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
+          dispatcher->DispatchPendingEvents();
+        }
+      });
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingEvents() {
+  std::vector<PointerData> events;
+  std::vector<PointerData> history;
+  if (options_.resample) {
+    const fml::TimePoint sample_time =
+        options_.clock() - options_.resampling_delay;
+    TakeResampledEvents(sample_time.ToEpochDelta().ToMicroseconds(), events,
+                        history);
+  } else {
+    events.swap(pending_events_);
+    history = events;
+  }
+
+  is_pointer_data_in_progress_ = !events.empty() || !pending_events_.empty();
+  if (!events.empty()) {
+    TRACE_EVENT2("flutter", "CoalescingPointerDataDispatcher::Dispatch",
+                 "received", std::to_string(history.size()).c_str(),
+                 "dispatched", std::to_string(events.size()).c_str());
+    history_ = std::move(history);
+    DefaultPointerDataDispatcher::DispatchPacket(MakePacket(Coalesce(events)),
+                                                 pending_trace_flow_id_);
+  }
+  if (is_pointer_data_in_progress_) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void CoalescingPointerDataDispatcher::TakeResampledEvents(
+    int64_t sample_time,
+    std::vector<PointerData>& events,
+    std::vector<PointerData>& history) {
+  // Events with time stamps past the current time are not on the clock of
+  // |options_.clock|, and are not held back.
+  const int64_t now = options_.clock().ToEpochDelta().ToMicroseconds();
+
+  // Maps each device to the index of the first event of the run of move or
+  // hover events that ends its pending events, if any.
+  std::unordered_map<int64_t, size_t> trailing_runs;
+  for (size_t i = 0; i < pending_events_.size(); i++) {
+    const PointerData& event = pending_events_[i];
+    auto run = trailing_runs.find(event.device);
+    if (!IsCoalescable(event)) {
+      if (run != trailing_runs.end()) {
+        trailing_runs.erase(run);
+      }
+    } else if (run == trailing_runs.end() ||
+               !ContinuesRun(pending_events_[run->second], event)) {
+      trailing_runs[event.device] = i;
+    }
+  }
+
+  std::vector<PointerData> held;
+  // The last event of each trailing run sampled before |sample_time|.
+  std::unordered_map<int64_t, PointerData> last_sampled;
+  std::unordered_set<int64_t> held_devices;
+  for (size_t i = 0; i < pending_events_.size(); i++) {
+    PointerData event = pending_events_[i];
+    auto run = trailing_runs.find(event.device);
+    const bool in_trailing_run =
+        run != trailing_runs.end() && i >= run->second;
+    const bool is_held =
+        in_trailing_run && (held_devices.count(event.device) > 0 ||
+                            (event.time_stamp > sample_time &&
+                             event.time_stamp <= now));
+    if (!is_held) {
+      events.push_back(event);
+      history.push_back(event);
+      if (in_trailing_run) {
+        last_sampled[event.device] = event;
+      }
+      continue;
+    }
+
+    // The first held event of a run that was sampled before |sample_time| is
+    // interpolated with the event before it, and keeps the part of its delta
+    // that was not dispatched.
+    if (held_devices.insert(event.device).second) {
+      auto before = last_sampled.find(event.device);
+      if (before != last_sampled.end()) {
+        const PointerData& previous = before->second;
+        const int64_t interval = event.time_stamp - previous.time_stamp;
+        const double t =
+            interval > 0
+                ? std::clamp(
+                      static_cast<double>(sample_time - previous.time_stamp) /
+                          interval,
+                      0.0, 1.0)
+                : 1.0;
+        PointerData resampled = event;
+        resampled.time_stamp = sample_time;
+        resampled.physical_x =
+            previous.physical_x + (event.physical_x - previous.physical_x) * t;
+        resampled.physical_y =
+            previous.physical_y + (event.physical_y - previous.physical_y) * t;
+        resampled.physical_delta_x = event.physical_delta_x * t;
+        resampled.physical_delta_y = event.physical_delta_y * t;
+        events.push_back(resampled);
+        event.physical_delta_x -= resampled.physical_delta_x;
+        event.physical_delta_y -= resampled.physical_delta_y;
+      }
+    }
+    held.push_back(event);
+  }
+  pending_events_.swap(held);
+}
+
 void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   FML_DCHECK(pending_packet_ != nullptr);
   FML_DCHECK(is_pointer_data_in_progress_);
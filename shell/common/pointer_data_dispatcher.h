@@ -5,6 +5,10 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <functional>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -162,6 +166,84 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that merges the consecutive move and hover events of each
+/// device into a single event per frame. Like `SmoothPointerDataDispatcher`,
+/// the first packet received while no pointer data dispatch is in progress is
+/// dispatched right away, and the packets received after it are held until
+/// the next vsync. The held events are then dispatched as a single packet in
+/// which every run of move (or hover) events of a device, with the same
+/// pointer and buttons and not interrupted by another event of that device, is
+/// replaced by its last event. The deltas of the merged events are summed, so
+/// the framework sees the same total motion.
+///
+/// The events of other devices may be interleaved with a run. The merged event
+/// takes the place of the first event of its run, so the order of the events
+/// of each device is preserved, but not the order across devices.
+///
+/// With `Options::resample`, nothing is dispatched before the vsync. The runs
+/// that end the held events of a device are then resampled at the vsync time
+/// minus `Options::resampling_delay`: the dispatched event is interpolated
+/// between the last event before that time and the first event after it, and
+/// the events after it are held until a later vsync. The time stamps of the
+/// events must be in microseconds on the clock of `Options::clock`, which is
+/// the monotonic clock of `fml::TimePoint` by default.
+///
+/// The original events of the last packet dispatched by this object are kept
+/// and can be retrieved with `GetLastDispatchedHistory`.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  struct Options {
+    bool resample = false;
+    fml::TimeDelta resampling_delay = fml::TimeDelta::FromMilliseconds(16);
+    std::function<fml::TimePoint()> clock = &fml::TimePoint::Now;
+  };
+
+  CoalescingPointerDataDispatcher(Delegate& delegate, Options options);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+  /// The events received by this object that were merged into the last
+  /// dispatched packet, in the order they were received. Resampled events
+  /// are not included.
+  const std::vector<PointerData>& GetLastDispatchedHistory() const {
+    return history_;
+  }
+
+ private:
+  const Options options_;
+
+  // The events received since the last dispatch, and the events held back by
+  // the last resampling.
+  std::vector<PointerData> pending_events_;
+  uint64_t pending_trace_flow_id_ = 0;
+
+  std::vector<PointerData> history_;
+
+  bool is_pointer_data_in_progress_ = false;
+
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+
+  // Dispatches the pending events that are due, and schedules the next vsync
+  // callback if any pointer data was dispatched or is still pending.
+  void DispatchPendingEvents();
+
+  // Moves the events of |pending_events_| that are due at |sample_time|, in
+  // microseconds, into |events| and |history|, and adds the resampled events
+  // to |events|.
+  void TakeResampledEvents(int64_t sample_time,
+                           std::vector<PointerData>& events,
+                           std::vector<PointerData>& history);
+
+  void ScheduleSecondaryVsyncCallback();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -75,6 +75,7 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     SetResourceCacheMaxBytes(max_cache_bytes_.value(),
                              user_override_resource_cache_bytes_);
   }
+  PrecompileSkSLs();
   compositor_context_->OnGrContextCreated();
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
@@ -96,10 +97,25 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   }
 }
 
+void Rasterizer::PrecompileSkSLs() {
+  // Skia only compiles SkSL ahead of time for OpenGL.
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context || context->backend() != GrBackendApi::kOpenGL) {
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  PersistentCache::GetCacheForProcess()->PrecompileSkSLs(
+      context, delegate_.GetSettings().sksl_precompile_progress_callback);
+}
+
 void Rasterizer::Teardown() {
   compositor_context_->OnGrContextDestroyed();
   surface_.reset();
   last_layer_tree_.reset();
+  last_damage_context_.reset();
 
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
@@ -450,6 +466,28 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
   auto root_surface_canvas =
       embedder_root_canvas ? embedder_root_canvas : frame->SkiaCanvas();
 
+  // Partial repaint is only possible when the whole frame is rendered into the
+  // root surface. With an external view embedder the frame is split across
+  // several surfaces that are composited by the embedder.
+  std::unique_ptr<DamageContext> damage_context;
+  FrameDamage frame_damage;
+  if (!external_view_embedder_ &&
+      frame->framebuffer_info().supports_partial_repaint) {
+    const SkIRect surface_bounds =
+        root_surface_transformation
+            .mapRect(SkRect::Make(layer_tree.frame_size()))
+            .roundOut();
+    damage_context = std::make_unique<DamageContext>(surface_bounds);
+    frame_damage.current_frame = damage_context.get();
+    frame_damage.previous_frame = last_damage_context_.get();
+    frame_damage.existing_damage = frame->framebuffer_info().existing_damage;
+  }
+  // The previous frame is only a valid reference if it is the frame that was
+  // presented last, so it is discarded here and replaced once this frame has
+  // been submitted successfully.
+  std::unique_ptr<DamageContext> previous_damage_context =
+      std::move(last_damage_context_);
+
   auto compositor_frame = compositor_context_->AcquireFrame(
       surface_->GetContext(),         // skia GrContext
       root_surface_canvas,            // root surface canvas
@@ -461,19 +499,28 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
   );
 
   if (compositor_frame) {
+    if (damage_context) {
+      compositor_frame->set_frame_damage(&frame_damage);
+    }
     RasterStatus raster_status = compositor_frame->Raster(layer_tree, false);
     if (raster_status == RasterStatus::kFailed ||
         raster_status == RasterStatus::kSkipAndRetry) {
       return raster_status;
     }
+    if (damage_context) {
+      SurfaceFrame::SubmitInfo submit_info;
+      submit_info.frame_damage = frame_damage.frame_damage;
+      submit_info.buffer_damage = frame_damage.buffer_damage;
+      frame->set_submit_info(submit_info);
+    }
     if (external_view_embedder_ &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFrame(
           surface_->GetContext(), std::move(frame),
           delegate_.GetIsGpuDisabledSyncSwitch());
-    } else {
-      frame->Submit();
+    } else if (frame->Submit() && damage_context) {
+      last_damage_context_ = std::move(damage_context);
     }
 
     FireNextFrameCallbackIfPresent();
@@ -89,6 +89,9 @@ class Rasterizer final : public SnapshotDelegate {
     /// is critical that GPU operations are not processed.
     virtual std::shared_ptr<fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
         const = 0;
+
+    /// The settings of the shell.
+    virtual const Settings& GetSettings() const = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -444,6 +447,10 @@ class Rasterizer final : public SnapshotDelegate {
   // has not successfully rasterized. This can happen due to the change in the
   // thread configuration. This will be inserted to the front of the pipeline.
   std::unique_ptr<flutter::LayerTree> resubmitted_layer_tree_;
+  // The paint regions of the last frame presented to the surface. Used to
+  // compute the damage of the next frame on surfaces that support partial
+  // repaint.
+  std::unique_ptr<DamageContext> last_damage_context_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
@@ -474,6 +481,10 @@ class Rasterizer final : public SnapshotDelegate {
 
   void FireNextFrameCallbackIfPresent();
 
+  // Compiles the SkSLs of the persistent cache into the context of a new
+  // OpenGL surface, reporting the progress to the shell's settings.
+  void PrecompileSkSLs();
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
 
   FML_DISALLOW_COPY_AND_ASSIGN(Rasterizer);
@@ -25,6 +25,7 @@ class MockDelegate : public Rasterizer::Delegate {
   MOCK_CONST_METHOD0(GetTaskRunners, const TaskRunners&());
   MOCK_CONST_METHOD0(GetIsGpuDisabledSyncSwitch,
                      std::shared_ptr<fml::SyncSwitch>());
+  MOCK_CONST_METHOD0(GetSettings, const Settings&());
 };
 
 class MockSurface : public Surface {
@@ -40,6 +40,14 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+struct Shell::PlatformMessageBatch {
+  std::mutex mutex;
+  // Set by the UI task once it took the messages. Later messages start a new
+  // batch.
+  bool dispatched = false;
+  std::vector<fml::RefPtr<PlatformMessage>> messages;
+};
+
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     DartVMRef vm,
     TaskRunners task_runners,
@@ -70,6 +78,15 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        RasterCache& raster_cache =
+            rasterizer->compositor_context()->raster_cache();
+        raster_cache.SetMaxBytes(shell->GetSettings().raster_cache_max_bytes);
+        raster_cache.SetMaxUnusedFrames(
+            shell->GetSettings().raster_cache_max_unused_frames);
+        if (shell->GetSettings().enable_async_raster_cache) {
+          raster_cache.SetWorkerTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+        }
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -126,6 +143,18 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.pointer_data_coalescing_mode !=
+      PointerDataCoalescingMode::kNone) {
+    CoalescingPointerDataDispatcher::Options options;
+    options.resample = settings.pointer_data_coalescing_mode ==
+                       PointerDataCoalescingMode::kResample;
+    options.resampling_delay =
+        fml::TimeDelta::FromMicroseconds(settings.pointer_resampling_delay_us);
+    dispatcher_maker = [options](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<CoalescingPointerDataDispatcher>(delegate,
+                                                               options);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -147,8 +176,10 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pacing_mode,
+            shell->GetSettings().frame_pipeline_depth);
 
         engine_promise.set_value(std::make_unique<Engine>(
             *shell,                          //
@@ -260,6 +291,7 @@ std::unique_ptr<Shell> Shell::Create(
     Shell::CreateCallback<Rasterizer> on_create_rasterizer) {
   PerformInitializationTasks(settings);
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetUseArchive(settings.use_persistent_cache_archive);
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
@@ -288,6 +320,7 @@ std::unique_ptr<Shell> Shell::Create(
     DartVMRef vm) {
   PerformInitializationTasks(settings);
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetUseArchive(settings.use_persistent_cache_archive);
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshots");
 
@@ -599,6 +632,18 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     PersistentCache::GetCacheForProcess()->Purge();
   }
 
+  if (settings_.persistent_cache_max_bytes > 0) {
+    PersistentCache::GetCacheForProcess()->SetMaxBytes(
+        settings_.persistent_cache_max_bytes);
+  }
+
+  if (settings_.parallel_sksl_precompile) {
+    // Read the SkSLs while the rest of the engine starts up, so that the
+    // rasterizer only has to compile them once its surface is created.
+    PersistentCache::GetCacheForProcess()->PrefetchSkSLs(
+        vm_->GetConcurrentWorkerTaskRunner());
+  }
+
   return true;
 }
 
@@ -873,6 +918,33 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (settings_.batch_platform_messages) {
+    // Append to the batch whose task has not run yet, if any, so that a burst
+    // of messages only posts a single task to the UI task runner.
+    if (platform_message_batch_) {
+      std::scoped_lock lock(platform_message_batch_->mutex);
+      if (!platform_message_batch_->dispatched) {
+        platform_message_batch_->messages.push_back(std::move(message));
+        return;
+      }
+    }
+    platform_message_batch_ = std::make_shared<PlatformMessageBatch>();
+    platform_message_batch_->messages.push_back(std::move(message));
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = engine_->GetWeakPtr(), batch = platform_message_batch_] {
+          std::vector<fml::RefPtr<PlatformMessage>> messages;
+          {
+            std::scoped_lock lock(batch->mutex);
+            batch->dispatched = true;
+            messages.swap(batch->messages);
+          }
+          if (engine) {
+            engine->DispatchPlatformMessages(std::move(messages));
+          }
+        });
+    return;
+  }
+
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), message = std::move(message)] {
         if (engine) {
@@ -1127,7 +1199,8 @@ void Shell::HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject())
     return;
   auto root = document.GetObject();
@@ -1541,7 +1614,12 @@ bool Shell::OnServiceProtocolGetSkSLs(
 
   rapidjson::Value shaders_json(rapidjson::kObjectType);
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
-  std::vector<PersistentCache::SkSLCache> sksls = persistent_cache->LoadSkSLs();
+  // With a "hotSetSize", only the most used SkSLs are returned.
+  std::vector<PersistentCache::SkSLCache> sksls =
+      params.count("hotSetSize") > 0
+          ? persistent_cache->LoadHotSkSLs(
+                std::strtoull(params.at("hotSetSize").data(), nullptr, 10))
+          : persistent_cache->LoadSkSLs();
   for (const auto& sksl : sksls) {
     size_t b64_size =
         SkBase64::Encode(sksl.second->data(), sksl.second->size(), nullptr);
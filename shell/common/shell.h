@@ -250,7 +250,7 @@ class Shell final : public PlatformView::Delegate,
   //------------------------------------------------------------------------------
   /// @return     The settings used to launch this shell.
   ///
-  const Settings& GetSettings() const;
+  const Settings& GetSettings() const override;
 
   //------------------------------------------------------------------------------
   /// @brief      If callers wish to interact directly with any shell
@@ -458,6 +458,11 @@ class Shell final : public PlatformView::Delegate,
   // used to discard wrong size layer tree produced during interactive resizing
   SkISize expected_frame_size_ = SkISize::MakeEmpty();
 
+  // The platform messages that arrived since the last UI task dispatching
+  // them was posted. Only used if |Settings::batch_platform_messages| is set.
+  struct PlatformMessageBatch;
+  std::shared_ptr<PlatformMessageBatch> platform_message_batch_;
+
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
@@ -411,6 +411,129 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+  settings.enable_work_stealing_workers =
+      command_line.HasOption(FlagForSwitch(Switch::EnableWorkStealingWorkers));
+  settings.pin_worker_threads =
+      command_line.HasOption(FlagForSwitch(Switch::PinWorkerThreads));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TextLayoutCacheMaxBytes))) {
+    std::string text_layout_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TextLayoutCacheMaxBytes),
+                                &text_layout_cache_max_bytes);
+    settings.text_layout_cache_max_bytes =
+        std::stoull(text_layout_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePacing))) {
+    std::string frame_pacing_mode;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePacing),
+                                &frame_pacing_mode);
+    if (frame_pacing_mode == "fifo") {
+      settings.frame_pacing_mode = FramePacingMode::kFifo;
+    } else if (frame_pacing_mode == "mailbox") {
+      settings.frame_pacing_mode = FramePacingMode::kMailbox;
+    } else if (frame_pacing_mode == "low-latency") {
+      settings.frame_pacing_mode = FramePacingMode::kLowLatency;
+    } else {
+      FML_LOG(INFO) << "Unknown frame pacing mode '" << frame_pacing_mode
+                    << "'. Will default to 'fifo'.";
+    }
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    settings.frame_pipeline_depth = std::stoul(frame_pipeline_depth);
+  }
+
+  settings.use_persistent_cache_archive =
+      command_line.HasOption(FlagForSwitch(Switch::UsePersistentCacheArchive));
+
+  settings.parallel_sksl_precompile =
+      command_line.HasOption(FlagForSwitch(Switch::ParallelSkSLPrecompile));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::PersistentCacheMaxBytes))) {
+    std::string persistent_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::PersistentCacheMaxBytes),
+                                &persistent_cache_max_bytes);
+    settings.persistent_cache_max_bytes =
+        std::stoull(persistent_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::MaxConcurrentImageDecodes))) {
+    std::string max_concurrent_image_decodes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::MaxConcurrentImageDecodes),
+        &max_concurrent_image_decodes);
+    settings.max_concurrent_image_decodes =
+        std::stoul(max_concurrent_image_decodes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageLookaheadFrames))) {
+    std::string animated_image_lookahead_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageLookaheadFrames),
+        &animated_image_lookahead_frames);
+    settings.animated_image_lookahead_frames =
+        std::stoul(animated_image_lookahead_frames);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageCacheMaxBytes))) {
+    std::string animated_image_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageCacheMaxBytes),
+        &animated_image_cache_max_bytes);
+    settings.animated_image_cache_max_bytes =
+        std::stoull(animated_image_cache_max_bytes);
+  }
+
+  settings.batch_platform_messages =
+      command_line.HasOption(FlagForSwitch(Switch::BatchPlatformMessages));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::PointerDataCoalescing))) {
+    std::string pointer_data_coalescing;
+    command_line.GetOptionValue(FlagForSwitch(Switch::PointerDataCoalescing),
+                                &pointer_data_coalescing);
+    if (pointer_data_coalescing == "none") {
+      settings.pointer_data_coalescing_mode = PointerDataCoalescingMode::kNone;
+    } else if (pointer_data_coalescing == "coalesce") {
+      settings.pointer_data_coalescing_mode =
+          PointerDataCoalescingMode::kCoalesce;
+    } else if (pointer_data_coalescing == "resample") {
+      settings.pointer_data_coalescing_mode =
+          PointerDataCoalescingMode::kResample;
+    } else {
+      FML_LOG(INFO) << "Unknown pointer data coalescing mode '"
+                    << pointer_data_coalescing << "'. Will default to 'none'.";
+    }
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::PointerResamplingDelay))) {
+    std::string pointer_resampling_delay;
+    command_line.GetOptionValue(FlagForSwitch(Switch::PointerResamplingDelay),
+                                &pointer_resampling_delay);
+    settings.pointer_resampling_delay_us = std::stoll(pointer_resampling_delay);
+  }
+
+  settings.compact_pointer_data_packets =
+      command_line.HasOption(FlagForSwitch(Switch::CompactPointerDataPackets));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::FontFallbackCachePath),
+                              &settings.font_fallback_cache_path);
   return settings;
 }
 
@@ -202,6 +202,88 @@ DEF_SWITCH(
 DEF_SWITCH(OldGenHeapSize,
            "old-gen-heap-size",
            "The size limit in megabytes for the Dart VM old gen heap space.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The size limit in bytes for the images held by the raster cache. "
+           "The least recently used entries are evicted first once the limit "
+           "is exceeded. Defaults to no limit.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize pictures into the raster cache on worker threads instead "
+           "of the raster thread.")
+DEF_SWITCH(EnableWorkStealingWorkers,
+           "enable-work-stealing-workers",
+           "Give each concurrent worker thread a task queue of its own and let "
+           "idle workers steal tasks from busy ones.")
+DEF_SWITCH(PinWorkerThreads,
+           "pin-worker-threads",
+           "Bind each concurrent worker thread to a single CPU. Only supported "
+           "on Linux and Android.")
+DEF_SWITCH(TextLayoutCacheMaxBytes,
+           "text-layout-cache-max-bytes",
+           "The size limit in bytes for the cache of shaped words shared by "
+           "all paragraph layouts.")
+DEF_SWITCH(FramePacing,
+           "frame-pacing-mode",
+           "How frames are handed from the UI thread to the raster thread. "
+           "One of 'fifo' (the default; every frame is rasterized in order), "
+           "'mailbox' (a newer frame replaces the one waiting to be "
+           "rasterized) or 'low-latency' (the UI thread may build the next "
+           "frame while the raster thread is busy, but never queues more than "
+           "one frame).")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The number of frames held by the pipeline between the UI and "
+           "raster threads in the 'fifo' frame pacing mode.")
+DEF_SWITCH(UsePersistentCacheArchive,
+           "use-persistent-cache-archive",
+           "Store the entries of the persistent cache in a single archive file "
+           "instead of one file per entry.")
+DEF_SWITCH(ParallelSkSLPrecompile,
+           "parallel-sksl-precompile",
+           "Read the cached SkSL shaders on the concurrent worker threads "
+           "during startup, ahead of their precompilation on the raster "
+           "thread.")
+DEF_SWITCH(PersistentCacheMaxBytes,
+           "persistent-cache-max-bytes",
+           "The max size in bytes of the persistent cache. The least recently "
+           "used entries are removed when it grows past this size.")
+DEF_SWITCH(MaxConcurrentImageDecodes,
+           "max-concurrent-image-decodes",
+           "The max number of images decoded at the same time by an engine. "
+           "Further decodes are queued.")
+DEF_SWITCH(AnimatedImageLookaheadFrames,
+           "animated-image-lookahead-frames",
+           "The number of frames of an animated image decoded on the worker "
+           "threads ahead of being shown.")
+DEF_SWITCH(AnimatedImageCacheMaxBytes,
+           "animated-image-cache-max-bytes",
+           "The max size in bytes of the decoded frames kept by an animated "
+           "image to play its loop again without decoding it.")
+DEF_SWITCH(BatchPlatformMessages,
+           "batch-platform-messages",
+           "Deliver the platform messages that arrive while the UI thread is "
+           "busy to the root isolate in a single call.")
+DEF_SWITCH(PointerDataCoalescing,
+           "pointer-data-coalescing",
+           "How pointer events are dispatched to the framework. One of 'none' "
+           "(the default; the dispatcher of the platform is used), 'coalesce' "
+           "(the move and hover events of a device are merged into one per "
+           "frame) or 'resample' (like 'coalesce', with the pointer positions "
+           "resampled behind the vsync).")
+DEF_SWITCH(PointerResamplingDelay,
+           "pointer-resampling-delay-us",
+           "How far behind the vsync pointer positions are sampled in the "
+           "'resample' pointer data coalescing mode, in microseconds.")
+DEF_SWITCH(CompactPointerDataPackets,
+           "compact-pointer-data-packets",
+           "Send pointer data packets to the framework in a compact, delta "
+           "encoded format.")
+DEF_SWITCH(FontFallbackCachePath,
+           "font-fallback-cache-path",
+           "Path to a directory holding a snapshot of the fallback fonts "
+           "matched for code points, which is loaded at startup and updated "
+           "while the engine is idle.")
 
 DEF_SWITCHES_END
 
@@ -20,6 +20,11 @@ bool GPUSurfaceGLDelegate::SurfaceSupportsReadback() const {
   return true;
 }
 
+SurfaceFrame::FramebufferInfo GPUSurfaceGLDelegate::GLContextFramebufferInfo(
+    intptr_t fbo_id) const {
+  return SurfaceFrame::FramebufferInfo{};
+}
+
 SkMatrix GPUSurfaceGLDelegate::GLContextSurfaceTransformation() const {
   SkMatrix matrix;
   matrix.setIdentity();
@@ -7,6 +7,7 @@
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
@@ -20,6 +21,19 @@ struct GLFrameInfo {
   uint32_t height;
 };
 
+// A structure to represent the information which is passed to the embedder
+// when presenting a frame buffer object.
+struct GLPresentInfo {
+  uint32_t fbo_id;
+
+  // The area of the frame that changed since the previous frame, if known.
+  // Platforms that support it can pass this to e.g. eglSwapBuffersWithDamage.
+  std::optional<SkIRect> frame_damage;
+
+  // The area of the frame buffer that was repainted, if known.
+  std::optional<SkIRect> buffer_damage;
+};
+
 class GPUSurfaceGLDelegate {
  public:
   ~GPUSurfaceGLDelegate();
@@ -33,7 +47,7 @@ class GPUSurfaceGLDelegate {
 
   // Called to present the main GL surface. This is only called for the main GL
   // context and not any of the contexts dedicated for IO.
-  virtual bool GLContextPresent(uint32_t fbo_id) = 0;
+  virtual bool GLContextPresent(const GLPresentInfo& present_info) = 0;
 
   // The ID of the main window bound framebuffer. Typically FBO0.
   virtual intptr_t GLContextFBO(GLFrameInfo frame_info) const = 0;
@@ -49,6 +63,14 @@ class GPUSurfaceGLDelegate {
   // circumstances such as a BackdropFilter.
   virtual bool SurfaceSupportsReadback() const;
 
+  // Describes the content of the frame buffer with the given ID before the
+  // next frame is rendered into it. Surfaces that preserve the content of
+  // their buffers (e.g. through EGL_EXT_buffer_age) can report the area that
+  // is out of date so that only the damaged part of the next frame is
+  // repainted. By default the buffer content is assumed to be undefined.
+  virtual SurfaceFrame::FramebufferInfo GLContextFramebufferInfo(
+      intptr_t fbo_id) const;
+
   // A transformation applied to the onscreen surface before the canvas is
   // flushed.
   virtual SkMatrix GLContextSurfaceTransformation() const;
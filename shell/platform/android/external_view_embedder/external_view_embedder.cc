@@ -84,7 +84,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     return;
   }
 
-  std::unordered_map<int64_t, std::list<SkRect>> overlay_layers;
+  std::unordered_map<int64_t, std::vector<SkRect>> overlay_layers;
   std::unordered_map<int64_t, sk_sp<SkPicture>> pictures;
   SkCanvas* background_canvas = frame->SkiaCanvas();
   auto current_frame_view_count = composition_order_.size();
@@ -93,6 +93,9 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   // below.
   SkAutoCanvasRestore save(background_canvas, /*doSave=*/true);
 
+  // Reused by all the r-tree queries of this frame.
+  std::vector<SkRect> intersection_rects;
+  std::vector<int> search_scratch;
   for (size_t i = 0; i < current_frame_view_count; i++) {
     int64_t view_id = composition_order_[i];
 
@@ -114,8 +117,8 @@ void AndroidExternalViewEmbedder::SubmitFrame(
       int64_t current_view_id = composition_order_[j];
       SkRect current_view_rect = GetViewRect(current_view_id);
       // Each rect corresponds to a native view that renders Flutter UI.
-      std::list<SkRect> intersection_rects =
-          rtree->searchNonOverlappingDrawnRects(current_view_rect);
+      rtree->searchNonOverlappingDrawnRects(
+          current_view_rect, &intersection_rects, &search_scratch);
       auto allocation_size = intersection_rects.size();
 
       // Limit the number of native views, so it doesn't grow forever.
@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
+#define FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
+
+#include <string>
+#include <utility>
+
+#include "flutter/shell/platform/common/cpp/text_range.h"
+
+namespace flutter {
+
+// A change made to the text of a |TextInputModel|.
+//
+// The |range| of the text as it was before the change, in UTF-16 code units,
+// was replaced by |text|. An insertion has a collapsed range, and a deletion
+// has empty text.
+class TextEditingDelta {
+ public:
+  TextEditingDelta(const TextRange& range, std::string text)
+      : range_(range), text_(std::move(text)) {}
+
+  // The replaced range.
+  const TextRange& range() const { return range_; }
+
+  // The replacement text, as UTF-8.
+  const std::string& text() const { return text_; }
+
+ private:
+  TextRange range_;
+  std::string text_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
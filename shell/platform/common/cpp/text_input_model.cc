@@ -36,9 +36,10 @@ TextInputModel::~TextInputModel() = default;
 void TextInputModel::SetText(const std::string& text) {
   std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       utf16_converter;
-  text_ = utf16_converter.from_bytes(text);
+  text_.SetText(utf16_converter.from_bytes(text));
   selection_ = TextRange(0);
   composing_range_ = TextRange(0);
+  deltas_.clear();
 }
 
 bool TextInputModel::SetSelection(const TextRange& range) {
@@ -77,7 +78,7 @@ void TextInputModel::UpdateComposingText(const std::string& composing_text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  ReplaceText(composing_range_.start(), composing_range_.length(), text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -101,7 +102,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  ReplaceText(start, selection_.length(), {});
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -110,6 +111,34 @@ bool TextInputModel::DeleteSelected() {
   return true;
 }
 
+void TextInputModel::ReplaceText(size_t start,
+                                 size_t length,
+                                 const std::u16string& text) {
+  if (length == 0 && text.empty()) {
+    return;
+  }
+  if (delta_tracking_enabled_) {
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
+        utf8_converter;
+    deltas_.emplace_back(TextRange(start, start + length),
+                         utf8_converter.to_bytes(text));
+  }
+  text_.Replace(start, length, text);
+}
+
+void TextInputModel::set_delta_tracking_enabled(bool enabled) {
+  delta_tracking_enabled_ = enabled;
+  if (!enabled) {
+    deltas_.clear();
+  }
+}
+
+std::vector<TextEditingDelta> TextInputModel::TakeDeltas() {
+  std::vector<TextEditingDelta> deltas;
+  deltas.swap(deltas_);
+  return deltas;
+}
+
 void TextInputModel::AddCodePoint(char32_t c) {
   if (c <= 0xFFFF) {
     AddText(std::u16string({static_cast<char16_t>(c)}));
@@ -127,13 +156,15 @@ void TextInputModel::AddCodePoint(char32_t c) {
 void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
-    // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
-    selection_ = TextRange(composing_range_.start());
-    composing_range_.set_end(composing_range_.start() + text.length());
+    // Replace the current composing text, set the cursor after it.
+    size_t start = composing_range_.start();
+    ReplaceText(start, composing_range_.length(), text);
+    composing_range_.set_end(start + text.length());
+    selection_ = TextRange(start + text.length());
+    return;
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  ReplaceText(position, 0, text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -151,7 +182,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    ReplaceText(position - count, count, {});
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -169,7 +200,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    ReplaceText(position, count, {});
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -207,7 +238,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  ReplaceText(start, deleted_length, {});
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -272,16 +303,38 @@ bool TextInputModel::MoveCursorBack() {
 std::string TextInputModel::GetText() const {
   std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       utf8_converter;
-  return utf8_converter.to_bytes(text_);
+  return utf8_converter.to_bytes(text_.ToString());
 }
 
 int TextInputModel::GetCursorOffset() const {
   // Measure the length of the current text up to the selection extent.
   // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
+  auto leading_text = text_.Substring(0, selection_.extent());
   std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       utf8_converter;
   return utf8_converter.to_bytes(leading_text).size();
 }
 
+std::string TextInputModel::GetTextAroundCursor(size_t max_length,
+                                                int* cursor_offset) const {
+  size_t cursor = selection_.extent();
+  size_t start = cursor - std::min(cursor, max_length);
+  size_t end = cursor + std::min(text_.length() - cursor, max_length);
+  // Keep surrogate pairs at the ends of the window whole.
+  if (start > 0 && start < cursor && IsTrailingSurrogate(text_.at(start))) {
+    start++;
+  }
+  if (end < text_.length() && end > cursor &&
+      IsLeadingSurrogate(text_.at(end - 1))) {
+    end--;
+  }
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
+      utf8_converter;
+  std::string text =
+      utf8_converter.to_bytes(text_.Substring(start, cursor - start));
+  *cursor_offset = text.size();
+  text += utf8_converter.to_bytes(text_.Substring(cursor, end - cursor));
+  return text;
+}
+
 }  // namespace flutter
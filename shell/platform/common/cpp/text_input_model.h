@@ -7,13 +7,21 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "flutter/shell/platform/common/cpp/text_editing_delta.h"
+#include "flutter/shell/platform/common/cpp/text_piece_table.h"
 #include "flutter/shell/platform/common/cpp/text_range.h"
 
 namespace flutter {
 
 // Handles underlying text input state, using a simple ASCII model.
 //
+// The text is kept in a piece table, so that edits near the cursor do not
+// copy the rest of the text. When delta tracking is enabled, every change to
+// the text is recorded as a |TextEditingDelta|, so that the change can be
+// reported to the framework without sending the whole text.
+//
 // Ignores special states like "insert mode" for now.
 class TextInputModel {
  public:
@@ -22,7 +30,8 @@ class TextInputModel {
 
   // Sets the text.
   //
-  // Resets the selection base and extent.
+  // Resets the selection base and extent. Discards the pending deltas, since
+  // the new text is the one the framework already has.
   void SetText(const std::string& text);
 
   // Attempts to set the text selection.
@@ -154,6 +163,13 @@ class TextInputModel {
   // GetText().
   int GetCursorOffset() const;
 
+  // Gets the text within |max_length| UTF-16 code units of the cursor as
+  // UTF-8, and sets |cursor_offset| to the byte offset of the cursor in it.
+  //
+  // Unlike |GetText|, only copies the returned part of the text, so input
+  // methods can query the context of the cursor in long texts cheaply.
+  std::string GetTextAroundCursor(size_t max_length, int* cursor_offset) const;
+
   // The current selection.
   TextRange selection() const { return selection_; }
 
@@ -165,6 +181,17 @@ class TextInputModel {
   // Whether multi-step input composing mode is active.
   bool composing() const { return composing_; }
 
+  // Whether changes to the text are recorded as deltas.
+  bool delta_tracking_enabled() const { return delta_tracking_enabled_; }
+
+  // Starts or stops recording changes to the text as deltas. Stopping
+  // discards the pending deltas.
+  void set_delta_tracking_enabled(bool enabled);
+
+  // Returns the changes made to the text since the last call, in the order
+  // they were made, and clears them. Empty unless delta tracking is enabled.
+  std::vector<TextEditingDelta> TakeDeltas();
+
  private:
   // Deletes the current selection, if any.
   //
@@ -172,6 +199,11 @@ class TextInputModel {
   // reset to the start of the selected range.
   bool DeleteSelected();
 
+  // Replaces the |length| code units starting at |start| with |text|, and
+  // records the change as a delta. Does not update the selection or the
+  // composing range.
+  void ReplaceText(size_t start, size_t length, const std::u16string& text);
+
   // Returns the currently editable text range.
   //
   // In composing mode, returns the composing range; otherwise, returns a range
@@ -183,10 +215,12 @@ class TextInputModel {
   // Returns a range covering the entire text.
   TextRange text_range() const { return TextRange(0, text_.length()); }
 
-  std::u16string text_;
+  TextPieceTable text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
+  bool delta_tracking_enabled_ = false;
+  std::vector<TextEditingDelta> deltas_;
 };
 
 }  // namespace flutter
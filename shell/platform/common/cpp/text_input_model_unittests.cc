@@ -1486,4 +1486,114 @@ TEST(TextInputModel, GetCursorOffsetReverseSelection) {
   EXPECT_EQ(model->GetCursorOffset(), 1);
 }
 
+TEST(TextInputModel, GetTextAroundCursor) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDEFGHIJ");
+  EXPECT_TRUE(model->SetSelection(TextRange(4)));
+  int cursor_offset = -1;
+  EXPECT_STREQ(model->GetTextAroundCursor(2, &cursor_offset).c_str(),
+               "CDEF");
+  EXPECT_EQ(cursor_offset, 2);
+  EXPECT_STREQ(model->GetTextAroundCursor(100, &cursor_offset).c_str(),
+               "ABCDEFGHIJ");
+  EXPECT_EQ(cursor_offset, 4);
+  EXPECT_TRUE(model->SetSelection(TextRange(2, 9)));
+  EXPECT_STREQ(model->GetTextAroundCursor(3, &cursor_offset).c_str(), "GHIJ");
+  EXPECT_EQ(cursor_offset, 3);
+}
+
+TEST(TextInputModel, GetTextAroundCursorKeepsSurrogatePairs) {
+  auto model = std::make_unique<TextInputModel>();
+  // Each of these characters takes two UTF-16 code units and 4 UTF-8 bytes.
+  model->SetText("𐍈𐍈𐍈");
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  int cursor_offset = -1;
+  // A window of one code unit on each side would split both neighbours.
+  EXPECT_STREQ(model->GetTextAroundCursor(1, &cursor_offset).c_str(), "");
+  EXPECT_EQ(cursor_offset, 0);
+  EXPECT_STREQ(model->GetTextAroundCursor(3, &cursor_offset).c_str(),
+               "𐍈𐍈");
+  EXPECT_EQ(cursor_offset, 4);
+}
+
+TEST(TextInputModel, DeltasAreNotRecordedByDefault) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(5)));
+  model->AddText("FG");
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->TakeDeltas().empty());
+}
+
+TEST(TextInputModel, DeltasRecordTextChanges) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking_enabled(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(1, 3)));
+  model->AddText("x");
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->MoveCursorToEnd());
+  model->AddCodePoint(0x10348);
+  EXPECT_STREQ(model->GetText().c_str(), "ADE𐍈");
+
+  std::vector<TextEditingDelta> deltas = model->TakeDeltas();
+  ASSERT_EQ(deltas.size(), 4u);
+  EXPECT_EQ(deltas[0].range(), TextRange(1, 3));
+  EXPECT_EQ(deltas[0].text(), "");
+  EXPECT_EQ(deltas[1].range(), TextRange(1));
+  EXPECT_EQ(deltas[1].text(), "x");
+  EXPECT_EQ(deltas[2].range(), TextRange(1, 2));
+  EXPECT_EQ(deltas[2].text(), "");
+  EXPECT_EQ(deltas[3].range(), TextRange(3));
+  EXPECT_EQ(deltas[3].text(), "𐍈");
+  EXPECT_TRUE(model->TakeDeltas().empty());
+}
+
+TEST(TextInputModel, DeltasRecordComposingChanges) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking_enabled(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  model->BeginComposing();
+  model->UpdateComposingText("ni");
+  model->UpdateComposingText("你");
+  model->CommitComposing();
+  model->EndComposing();
+  EXPECT_STREQ(model->GetText().c_str(), "AB你CDE");
+
+  std::vector<TextEditingDelta> deltas = model->TakeDeltas();
+  ASSERT_EQ(deltas.size(), 2u);
+  EXPECT_EQ(deltas[0].range(), TextRange(2));
+  EXPECT_EQ(deltas[0].text(), "ni");
+  EXPECT_EQ(deltas[1].range(), TextRange(2, 4));
+  EXPECT_EQ(deltas[1].text(), "你");
+}
+
+TEST(TextInputModel, DeltasRecordDeleteSurrounding) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking_enabled(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(3)));
+  EXPECT_TRUE(model->DeleteSurrounding(-2, 1));
+  EXPECT_TRUE(model->Delete());
+  EXPECT_STREQ(model->GetText().c_str(), "ADE");
+
+  std::vector<TextEditingDelta> deltas = model->TakeDeltas();
+  ASSERT_EQ(deltas.size(), 2u);
+  EXPECT_EQ(deltas[0].range(), TextRange(1, 2));
+  EXPECT_EQ(deltas[1].range(), TextRange(1, 2));
+}
+
+TEST(TextInputModel, SetTextDiscardsDeltas) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking_enabled(true);
+  model->AddText("ABC");
+  model->SetText("XYZ");
+  EXPECT_TRUE(model->TakeDeltas().empty());
+  model->AddText("W");
+  model->set_delta_tracking_enabled(false);
+  EXPECT_TRUE(model->TakeDeltas().empty());
+  EXPECT_STREQ(model->GetText().c_str(), "WXYZ");
+}
+
 }  // namespace flutter
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/cpp/text_piece_table.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+TextPieceTable::TextPieceTable() = default;
+
+TextPieceTable::TextPieceTable(std::u16string text) {
+  SetText(std::move(text));
+}
+
+TextPieceTable::~TextPieceTable() = default;
+
+void TextPieceTable::SetText(std::u16string text) {
+  original_ = std::move(text);
+  added_.clear();
+  pieces_.clear();
+  if (!original_.empty()) {
+    pieces_.push_back({false, 0, original_.length()});
+  }
+  length_ = original_.length();
+  cached_piece_ = 0;
+  cached_offset_ = 0;
+}
+
+void TextPieceTable::Replace(size_t position,
+                             size_t length,
+                             const std::u16string& text) {
+  FML_DCHECK(position <= length_ && length <= length_ - position);
+
+  // Text inserted right after the last text added extends its piece.
+  if (length == 0 && position > 0 && !text.empty()) {
+    size_t offset;
+    Piece& piece = pieces_[FindPiece(position - 1, &offset)];
+    if (piece.added && piece.start + piece.length == added_.length() &&
+        offset + piece.length == position) {
+      added_.append(text);
+      piece.length += text.length();
+      length_ += text.length();
+      return;
+    }
+  }
+
+  size_t first = SplitAt(position);
+  size_t last = SplitAt(position + length);
+  pieces_.erase(pieces_.begin() + first, pieces_.begin() + last);
+  if (!text.empty()) {
+    pieces_.insert(pieces_.begin() + first,
+                   {true, added_.length(), text.length()});
+    added_.append(text);
+  }
+  length_ = length_ - length + text.length();
+  cached_piece_ = 0;
+  cached_offset_ = 0;
+
+  if (pieces_.size() > kMaxPieceCount) {
+    SetText(ToString());
+  }
+}
+
+char16_t TextPieceTable::at(size_t position) const {
+  size_t offset;
+  size_t index = FindPiece(position, &offset);
+  FML_DCHECK(index < pieces_.size());
+  return PieceData(pieces_[index])[position - offset];
+}
+
+std::u16string TextPieceTable::Substring(size_t position,
+                                         size_t length) const {
+  std::u16string result;
+  result.reserve(length);
+  size_t offset;
+  for (size_t i = FindPiece(position, &offset);
+       i < pieces_.size() && length > 0; i++) {
+    const Piece& piece = pieces_[i];
+    size_t skipped = position - offset;
+    size_t count = std::min(piece.length - skipped, length);
+    result.append(PieceData(piece) + skipped, count);
+    length -= count;
+    position += count;
+    offset += piece.length;
+  }
+  return result;
+}
+
+std::u16string TextPieceTable::ToString() const {
+  return Substring(0, length_);
+}
+
+size_t TextPieceTable::FindPiece(size_t position, size_t* offset) const {
+  size_t index = 0;
+  size_t piece_offset = 0;
+  if (cached_piece_ < pieces_.size() && cached_offset_ <= position) {
+    index = cached_piece_;
+    piece_offset = cached_offset_;
+  }
+  while (index < pieces_.size() &&
+         piece_offset + pieces_[index].length <= position) {
+    piece_offset += pieces_[index].length;
+    index++;
+  }
+  if (index < pieces_.size()) {
+    cached_piece_ = index;
+    cached_offset_ = piece_offset;
+  }
+  *offset = piece_offset;
+  return index;
+}
+
+size_t TextPieceTable::SplitAt(size_t position) {
+  size_t offset;
+  size_t index = FindPiece(position, &offset);
+  if (index == pieces_.size() || offset == position) {
+    return index;
+  }
+  Piece& piece = pieces_[index];
+  size_t split = position - offset;
+  Piece tail = {piece.added, piece.start + split, piece.length - split};
+  piece.length = split;
+  pieces_.insert(pieces_.begin() + index + 1, tail);
+  return index + 1;
+}
+
+const char16_t* TextPieceTable::PieceData(const Piece& piece) const {
+  return (piece.added ? added_ : original_).data() + piece.start;
+}
+
+}  // namespace flutter
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_CPP_TEXT_PIECE_TABLE_H_
+#define FLUTTER_SHELL_PLATFORM_CPP_TEXT_PIECE_TABLE_H_
+
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+// UTF-16 text stored as a piece table.
+//
+// The text is a sequence of pieces, each referring to a span of either the
+// original text or an append-only buffer of the text added since. An edit
+// splits at most one piece and adds at most one, so its cost depends on the
+// number of pieces rather than on the length of the text. Text typed at the
+// cursor extends the last added piece in place. Once the table holds more than
+// |kMaxPieceCount| pieces, it is flattened back into a single original piece.
+class TextPieceTable {
+ public:
+  static constexpr size_t kMaxPieceCount = 256;
+
+  TextPieceTable();
+  explicit TextPieceTable(std::u16string text);
+  ~TextPieceTable();
+
+  // Replaces the whole text.
+  void SetText(std::u16string text);
+
+  // Replaces the |length| code units starting at |position| with |text|.
+  void Replace(size_t position, size_t length, const std::u16string& text);
+
+  void Insert(size_t position, const std::u16string& text) {
+    Replace(position, 0, text);
+  }
+
+  void Erase(size_t position, size_t length) { Replace(position, length, {}); }
+
+  // The code unit at |position|, which must be less than |length()|.
+  char16_t at(size_t position) const;
+
+  // The |length| code units starting at |position|.
+  std::u16string Substring(size_t position, size_t length) const;
+
+  std::u16string ToString() const;
+
+  // The length of the text, in UTF-16 code units.
+  size_t length() const { return length_; }
+
+  size_t piece_count() const { return pieces_.size(); }
+
+ private:
+  struct Piece {
+    // Whether the piece refers to |added_| rather than |original_|.
+    bool added;
+    size_t start;
+    size_t length;
+  };
+
+  // Returns the index of the piece containing |position|, and sets |offset| to
+  // the position of that piece. A position at the end of the text returns the
+  // number of pieces.
+  size_t FindPiece(size_t position, size_t* offset) const;
+
+  // Splits the pieces so that one starts at |position|, and returns its index.
+  size_t SplitAt(size_t position);
+
+  const char16_t* PieceData(const Piece& piece) const;
+
+  std::u16string original_;
+  std::u16string added_;
+  std::vector<Piece> pieces_;
+  size_t length_ = 0;
+
+  // The last piece found, which speeds up the scans of consecutive positions
+  // done when moving the cursor or deleting near it.
+  mutable size_t cached_piece_ = 0;
+  mutable size_t cached_offset_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_CPP_TEXT_PIECE_TABLE_H_
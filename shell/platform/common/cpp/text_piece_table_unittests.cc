@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/cpp/text_piece_table.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextPieceTable, Empty) {
+  TextPieceTable table;
+  EXPECT_EQ(table.length(), 0u);
+  EXPECT_EQ(table.piece_count(), 0u);
+  EXPECT_EQ(table.ToString(), u"");
+}
+
+TEST(TextPieceTable, SetText) {
+  TextPieceTable table(u"ABCDE");
+  EXPECT_EQ(table.length(), 5u);
+  EXPECT_EQ(table.piece_count(), 1u);
+  EXPECT_EQ(table.at(0), u'A');
+  EXPECT_EQ(table.at(4), u'E');
+  table.SetText(u"XY");
+  EXPECT_EQ(table.ToString(), u"XY");
+  EXPECT_EQ(table.piece_count(), 1u);
+}
+
+TEST(TextPieceTable, InsertSplitsPiece) {
+  TextPieceTable table(u"ABCDE");
+  table.Insert(2, u"xy");
+  EXPECT_EQ(table.ToString(), u"ABxyCDE");
+  EXPECT_EQ(table.length(), 7u);
+  EXPECT_EQ(table.piece_count(), 3u);
+  EXPECT_EQ(table.at(2), u'x');
+  EXPECT_EQ(table.at(4), u'C');
+}
+
+TEST(TextPieceTable, InsertAtEnds) {
+  TextPieceTable table(u"ABC");
+  table.Insert(0, u"x");
+  table.Insert(4, u"y");
+  EXPECT_EQ(table.ToString(), u"xABCy");
+  EXPECT_EQ(table.piece_count(), 3u);
+}
+
+TEST(TextPieceTable, TypingExtendsLastPiece) {
+  TextPieceTable table(u"ABCDE");
+  table.Insert(2, u"x");
+  table.Insert(3, u"y");
+  table.Insert(4, u"z");
+  EXPECT_EQ(table.ToString(), u"ABxyzCDE");
+  EXPECT_EQ(table.piece_count(), 3u);
+}
+
+TEST(TextPieceTable, Erase) {
+  TextPieceTable table(u"ABCDE");
+  table.Insert(2, u"xy");
+  table.Erase(1, 2);
+  EXPECT_EQ(table.ToString(), u"AyCDE");
+  table.Erase(0, 5);
+  EXPECT_EQ(table.ToString(), u"");
+  EXPECT_EQ(table.length(), 0u);
+  EXPECT_EQ(table.piece_count(), 0u);
+}
+
+TEST(TextPieceTable, Replace) {
+  TextPieceTable table(u"ABCDE");
+  table.Replace(1, 3, u"xyz");
+  EXPECT_EQ(table.ToString(), u"AxyzE");
+  table.Replace(0, 2, u"");
+  EXPECT_EQ(table.ToString(), u"yzE");
+}
+
+TEST(TextPieceTable, Substring) {
+  TextPieceTable table(u"ABCDE");
+  table.Insert(2, u"xy");
+  EXPECT_EQ(table.Substring(0, 3), u"ABx");
+  EXPECT_EQ(table.Substring(3, 3), u"yCD");
+  EXPECT_EQ(table.Substring(6, 1), u"E");
+  EXPECT_EQ(table.Substring(7, 0), u"");
+}
+
+TEST(TextPieceTable, FlattensManyPieces) {
+  TextPieceTable table(u"AB");
+  std::u16string expected = u"AB";
+  for (size_t i = 0; i < TextPieceTable::kMaxPieceCount; i++) {
+    // Inserting before the previous insertion creates a new piece each time.
+    table.Insert(1, u"x");
+    expected.insert(1, u"x");
+    EXPECT_LE(table.piece_count(), TextPieceTable::kMaxPieceCount);
+  }
+  EXPECT_EQ(table.ToString(), expected);
+  EXPECT_EQ(table.length(), expected.length());
+}
+
+}  // namespace flutter
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#ifndef FLUTTER_SHELL_PLATFORM_CPP_TEXT_RANGE_H_
+#define FLUTTER_SHELL_PLATFORM_CPP_TEXT_RANGE_H_
+
 #include <algorithm>
 
 #include "flutter/fml/logging.h"
@@ -92,3 +95,5 @@ class TextRange {
   size_t base_;
   size_t extent_;
 };
+
+#endif  // FLUTTER_SHELL_PLATFORM_CPP_TEXT_RANGE_H_
@@ -4,7 +4,6 @@
 
 #import <UIKit/UIGestureRecognizerSubclass.h>
 
-#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -509,7 +508,7 @@ bool FlutterPlatformViewsController::SubmitFrameGpuSafe(GrDirectContext* gr_cont
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
       SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
-      std::list<SkRect> intersection_rects =
+      std::vector<SkRect> intersection_rects =
           rtree->searchNonOverlappingDrawnRects(platform_view_rect);
       auto allocation_size = intersection_rects.size();
 
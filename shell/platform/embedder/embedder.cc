@@ -151,6 +151,16 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // OS_LINUX || OS_WIN
 
+#ifdef SHELL_ENABLE_GL
+static FlutterRect SkIRectToFlutterRect(const SkIRect& rect) {
+  FlutterRect flutter_rect = {static_cast<double>(rect.left()),
+                              static_cast<double>(rect.top()),
+                              static_cast<double>(rect.right()),
+                              static_cast<double>(rect.bottom())};
+  return flutter_rect;
+}
+#endif  // SHELL_ENABLE_GL
+
 static flutter::Shell::CreateCallback<flutter::PlatformView>
 InferOpenGLPlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -170,15 +180,31 @@ InferOpenGLPlatformViewCreationCallback(
   auto gl_clear_current = [ptr = config->open_gl.clear_current,
                            user_data]() -> bool { return ptr(user_data); };
 
-  auto gl_present = [present = config->open_gl.present,
-                     present_with_info = config->open_gl.present_with_info,
-                     user_data](uint32_t fbo_id) -> bool {
+  auto gl_present =
+      [present = config->open_gl.present,
+       present_with_info = config->open_gl.present_with_info,
+       user_data](const flutter::GLPresentInfo& gl_present_info) -> bool {
     if (present) {
       return present(user_data);
     } else {
+      FlutterRect frame_damage_rect = {};
+      FlutterRect buffer_damage_rect = {};
       FlutterPresentInfo present_info = {};
       present_info.struct_size = sizeof(FlutterPresentInfo);
-      present_info.fbo_id = fbo_id;
+      present_info.fbo_id = gl_present_info.fbo_id;
+      present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+      present_info.buffer_damage.struct_size = sizeof(FlutterDamage);
+      if (gl_present_info.frame_damage) {
+        frame_damage_rect = SkIRectToFlutterRect(*gl_present_info.frame_damage);
+        present_info.frame_damage.num_rects = 1;
+        present_info.frame_damage.damage = &frame_damage_rect;
+      }
+      if (gl_present_info.buffer_damage) {
+        buffer_damage_rect =
+            SkIRectToFlutterRect(*gl_present_info.buffer_damage);
+        present_info.buffer_damage.num_rects = 1;
+        present_info.buffer_damage.damage = &buffer_damage_rect;
+      }
       return present_with_info(user_data, &present_info);
     }
   };
@@ -199,6 +225,36 @@ InferOpenGLPlatformViewCreationCallback(
   };
 
   const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
+
+  // Partial repaint needs the frame damage to be reported back to the
+  // embedder, which is only possible through |present_with_info|.
+  std::function<flutter::SurfaceFrame::FramebufferInfo(intptr_t)>
+      gl_populate_existing_damage = nullptr;
+  if (SAFE_ACCESS(open_gl_config, populate_existing_damage, nullptr) !=
+          nullptr &&
+      SAFE_ACCESS(open_gl_config, present_with_info, nullptr) != nullptr) {
+    gl_populate_existing_damage =
+        [ptr = config->open_gl.populate_existing_damage,
+         user_data](intptr_t fbo_id) {
+          FlutterDamage existing_damage = {};
+          existing_damage.struct_size = sizeof(FlutterDamage);
+          ptr(user_data, fbo_id, &existing_damage);
+
+          SkIRect damage = SkIRect::MakeEmpty();
+          for (size_t i = 0; i < existing_damage.num_rects; i++) {
+            const FlutterRect& rect = existing_damage.damage[i];
+            damage.join(SkRect::MakeLTRB(rect.left, rect.top, rect.right,
+                                         rect.bottom)
+                            .roundOut());
+          }
+
+          flutter::SurfaceFrame::FramebufferInfo framebuffer_info;
+          framebuffer_info.supports_partial_repaint = true;
+          framebuffer_info.existing_damage = damage;
+          return framebuffer_info;
+        };
+  }
+
   std::function<bool()> gl_make_resource_current_callback = nullptr;
   if (SAFE_ACCESS(open_gl_config, make_resource_current, nullptr) != nullptr) {
     gl_make_resource_current_callback =
@@ -255,6 +311,7 @@ InferOpenGLPlatformViewCreationCallback(
       gl_make_resource_current_callback,   // gl_make_resource_current_callback
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
+      gl_populate_existing_damage,         // gl_populate_existing_damage
   };
 
   return fml::MakeCopyable(
@@ -822,6 +879,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  settings.raster_cache_max_bytes =
+      SAFE_ACCESS(args, raster_cache_max_bytes, 0);
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -944,8 +1003,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           const FlutterPlatformMessage incoming_message = {
               sizeof(FlutterPlatformMessage),  // struct_size
               message->channel().c_str(),      // channel
-              message->data().data(),          // message
-              message->data().size(),          // message_size
+              message->data().GetMapping(),    // message
+              message->data().GetSize(),       // message_size
               handle,                          // response_handle
           };
           handle->message = std::move(message);
@@ -359,6 +359,19 @@ typedef uint32_t (*UIntFrameInfoCallback)(
     void* /* user data */,
     const FlutterFrameInfo* /* frame info */);
 
+/// A set of rectangles describing an area of a surface, in physical pixels.
+///
+/// See: \ref FlutterOpenGLRendererConfig.populate_existing_damage and
+/// \ref FlutterPresentInfo.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterDamage).
+  size_t struct_size;
+  /// The number of rectangles in `damage`.
+  size_t num_rects;
+  /// The rectangles. The area described is the union of all rectangles.
+  FlutterRect* damage;
+} FlutterDamage;
+
 /// This information is passed to the embedder when a surface is presented.
 ///
 /// See: \ref FlutterOpenGLRendererConfig.present_with_info.
@@ -367,8 +380,26 @@ typedef struct {
   size_t struct_size;
   /// Id of the fbo backing the surface that was presented.
   uint32_t fbo_id;
+  /// The area of the surface that changed since the previous frame. Embedders
+  /// may pass this to the windowing system (e.g. eglSwapBuffersWithDamageKHR)
+  /// and must accumulate it to answer
+  /// `FlutterOpenGLRendererConfig.populate_existing_damage`. Only valid for the
+  /// duration of the call and only specified (`num_rects` is non-zero) if the
+  /// embedder provided `populate_existing_damage`.
+  FlutterDamage frame_damage;
+  /// The area of the fbo that was repainted by the engine. Only valid for the
+  /// duration of the call and only specified if the embedder provided
+  /// `populate_existing_damage`.
+  FlutterDamage buffer_damage;
 } FlutterPresentInfo;
 
+/// Callback for when the engine wants to know which part of the given fbo is
+/// out of date with respect to the last presented frame.
+typedef void (*FlutterFrameBufferWithDamageCallback)(
+    void* /* user data */,
+    const intptr_t /* fbo id */,
+    FlutterDamage* /* existing damage */);
+
 /// Callback for when a surface is presented.
 typedef bool (*BoolPresentInfoCallback)(
     void* /* user data */,
@@ -432,6 +463,17 @@ typedef struct {
   /// `FlutterPresentInfo` struct that the embedder can use to release any
   /// resources. The return value indicates success of the present call.
   BoolPresentInfoCallback present_with_info;
+  /// Specifying this callback enables partial repaint. Before rendering into
+  /// an fbo, the engine asks the embedder which area of that fbo is out of
+  /// date compared to the last frame presented to the surface. This is
+  /// typically the union of the `frame_damage` of all frames presented since
+  /// the fbo was last presented, as determined from the buffer age. If the
+  /// content of the fbo is undefined (e.g. a new buffer), the embedder must
+  /// report a rectangle covering the whole fbo. Reporting no rectangles means
+  /// that the fbo already contains the last presented frame. The rectangles
+  /// only need to remain valid for the duration of the call. This callback is
+  /// optional and requires `present_with_info` to be specified.
+  FlutterFrameBufferWithDamageCallback populate_existing_damage;
 } FlutterOpenGLRendererConfig;
 
 typedef struct {
@@ -1339,6 +1381,10 @@ typedef struct {
   /// `FlutterProjectArgs`.
   const char* const* dart_entrypoint_argv;
 
+  /// Max size in bytes of the images held by the raster cache, or 0 for no
+  /// limit. Once a frame leaves the cache above this size, the entries that
+  /// were used least recently are evicted first.
+  size_t raster_cache_max_bytes;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -45,8 +45,8 @@ bool EmbedderSurfaceGL::GLContextClearCurrent() {
 }
 
 // |GPUSurfaceGLDelegate|
-bool EmbedderSurfaceGL::GLContextPresent(uint32_t fbo_id) {
-  return gl_dispatch_table_.gl_present_callback(fbo_id);
+bool EmbedderSurfaceGL::GLContextPresent(const GLPresentInfo& present_info) {
+  return gl_dispatch_table_.gl_present_callback(present_info);
 }
 
 // |GPUSurfaceGLDelegate|
@@ -54,6 +54,16 @@ intptr_t EmbedderSurfaceGL::GLContextFBO(GLFrameInfo frame_info) const {
   return gl_dispatch_table_.gl_fbo_callback(frame_info);
 }
 
+// |GPUSurfaceGLDelegate|
+SurfaceFrame::FramebufferInfo EmbedderSurfaceGL::GLContextFramebufferInfo(
+    intptr_t fbo_id) const {
+  auto callback = gl_dispatch_table_.gl_populate_existing_damage;
+  if (!callback) {
+    return SurfaceFrame::FramebufferInfo{};
+  }
+  return callback(fbo_id);
+}
+
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextFBOResetAfterPresent() const {
   return fbo_reset_after_present_;
@@ -716,8 +716,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  auto data = delegate.message()->data();
-  auto call = std::string(data.begin(), data.end());
+  const fml::Mapping* data = &delegate.message()->data();
+  auto call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                          data->GetSize());
   std::string expected = "{\"method\":\"View.viewConnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -731,8 +732,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewDisconnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -750,8 +752,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewStateChanged\",\"args\":{\"state\":true}}";
   EXPECT_EQ(expected, call);
 }
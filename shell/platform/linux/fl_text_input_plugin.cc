@@ -21,6 +21,15 @@ static constexpr char kClearClientMethod[] = "TextInput.clearClient";
 static constexpr char kHideMethod[] = "TextInput.hide";
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+// Reports the changes to the text of a client that set
+// |kEnableRangeDeltasKey| in its configuration, instead of its whole text.
+// The arguments are the client ID and an editing state whose "text" is
+// replaced by "rangeDeltas", a list of {"deltaStart", "deltaEnd", "deltaText"}
+// maps applied in order. Each replaces the UTF-16 range [deltaStart, deltaEnd)
+// of the text as it was before that delta with deltaText. This is not the
+// framework's TextEditingDelta protocol, which also requires the old text.
+static constexpr char kUpdateEditingStateWithRangeDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithRangeDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 static constexpr char kSetEditableSizeAndTransform[] =
     "TextInput.setEditableSizeAndTransform";
@@ -29,6 +38,7 @@ static constexpr char kSetMarkedTextRect[] = "TextInput.setMarkedTextRect";
 static constexpr char kInputActionKey[] = "inputAction";
 static constexpr char kTextInputTypeKey[] = "inputType";
 static constexpr char kTextInputTypeNameKey[] = "name";
+static constexpr char kEnableRangeDeltasKey[] = "enableRangeDeltas";
 static constexpr char kTextKey[] = "text";
 static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
@@ -36,6 +46,10 @@ static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
+static constexpr char kRangeDeltasKey[] = "rangeDeltas";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 
 static constexpr char kTransform[] = "transform";
 
@@ -44,6 +58,10 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr int64_t kClientIdUnset = -1;
 
+// The number of UTF-16 code units on each side of the cursor given to input
+// methods that ask for the surrounding text.
+static constexpr size_t kSurroundingTextMaxLength = 1024;
+
 struct FlTextInputPluginPrivate {
   GObject parent_instance;
 
@@ -104,19 +122,26 @@ static void update_editing_state_response_cb(GObject* object,
   }
 }
 
-// Informs Flutter of text input changes.
-static void update_editing_state(FlTextInputPlugin* self) {
+// Called when a response is received from
+// TextInputClient.updateEditingStateWithRangeDeltas()
+static void update_editing_state_with_deltas_response_cb(GObject* object,
+                                                         GAsyncResult* result,
+                                                         gpointer user_data) {
+  g_autoptr(GError) error = nullptr;
+  if (!finish_method(object, result, &error)) {
+    g_warning("Failed to call %s: %s",
+              kUpdateEditingStateWithRangeDeltasMethod, error->message);
+  }
+}
+
+// Sets the selection and composing range of the text model in an editing
+// state |value|.
+static void set_selection_and_composing_range(FlTextInputPlugin* self,
+                                              FlValue* value) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
 
-  g_autoptr(FlValue) args = fl_value_new_list();
-  fl_value_append_take(args, fl_value_new_int(priv->client_id));
-  g_autoptr(FlValue) value = fl_value_new_map();
-
   TextRange selection = priv->text_model->selection();
-  fl_value_set_string_take(
-      value, kTextKey,
-      fl_value_new_string(priv->text_model->GetText().c_str()));
   fl_value_set_string_take(value, kSelectionBaseKey,
                            fl_value_new_int(selection.base()));
   fl_value_set_string_take(value, kSelectionExtentKey,
@@ -138,6 +163,58 @@ static void update_editing_state(FlTextInputPlugin* self) {
                            fl_value_new_string(kTextAffinityDownstream));
   fl_value_set_string_take(value, kSelectionIsDirectionalKey,
                            fl_value_new_bool(FALSE));
+}
+
+// Informs Flutter of the changes made to the text since the last update,
+// without sending the whole text.
+static void update_editing_state_with_deltas(FlTextInputPlugin* self) {
+  FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
+      fl_text_input_plugin_get_instance_private(self));
+
+  g_autoptr(FlValue) args = fl_value_new_list();
+  fl_value_append_take(args, fl_value_new_int(priv->client_id));
+  g_autoptr(FlValue) value = fl_value_new_map();
+
+  g_autoptr(FlValue) deltas = fl_value_new_list();
+  for (const flutter::TextEditingDelta& delta :
+       priv->text_model->TakeDeltas()) {
+    g_autoptr(FlValue) delta_value = fl_value_new_map();
+    fl_value_set_string_take(delta_value, kDeltaTextKey,
+                             fl_value_new_string(delta.text().c_str()));
+    fl_value_set_string_take(delta_value, kDeltaStartKey,
+                             fl_value_new_int(delta.range().start()));
+    fl_value_set_string_take(delta_value, kDeltaEndKey,
+                             fl_value_new_int(delta.range().end()));
+    fl_value_append(deltas, delta_value);
+  }
+  fl_value_set_string(value, kRangeDeltasKey, deltas);
+  set_selection_and_composing_range(self, value);
+
+  fl_value_append(args, value);
+
+  fl_method_channel_invoke_method(
+      priv->channel, kUpdateEditingStateWithRangeDeltasMethod, args, nullptr,
+      update_editing_state_with_deltas_response_cb, self);
+}
+
+// Informs Flutter of text input changes.
+static void update_editing_state(FlTextInputPlugin* self) {
+  FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
+      fl_text_input_plugin_get_instance_private(self));
+
+  if (priv->text_model->delta_tracking_enabled()) {
+    update_editing_state_with_deltas(self);
+    return;
+  }
+
+  g_autoptr(FlValue) args = fl_value_new_list();
+  fl_value_append_take(args, fl_value_new_int(priv->client_id));
+  g_autoptr(FlValue) value = fl_value_new_map();
+
+  fl_value_set_string_take(
+      value, kTextKey,
+      fl_value_new_string(priv->text_model->GetText().c_str()));
+  set_selection_and_composing_range(self, value);
 
   fl_value_append(args, value);
 
@@ -223,8 +300,9 @@ static void im_preedit_end_cb(FlTextInputPlugin* self) {
 static gboolean im_retrieve_surrounding_cb(FlTextInputPlugin* self) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  auto text = priv->text_model->GetText();
-  size_t cursor_offset = priv->text_model->GetCursorOffset();
+  int cursor_offset = 0;
+  auto text = priv->text_model->GetTextAroundCursor(kSurroundingTextMaxLength,
+                                                    &cursor_offset);
   gtk_im_context_set_surrounding(priv->im_context, text.c_str(), -1,
                                  cursor_offset);
   return TRUE;
@@ -275,6 +353,13 @@ static FlMethodResponse* set_client(FlTextInputPlugin* self, FlValue* args) {
     }
   }
 
+  FlValue* enable_range_deltas_value =
+      fl_value_lookup_string(config_value, kEnableRangeDeltasKey);
+  priv->text_model->set_delta_tracking_enabled(
+      enable_range_deltas_value != nullptr &&
+      fl_value_get_type(enable_range_deltas_value) == FL_VALUE_TYPE_BOOL &&
+      fl_value_get_bool(enable_range_deltas_value));
+
   return FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
 }
 
@@ -21,11 +21,21 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+// Reports the changes to the text of a client that set |kEnableRangeDeltas|
+// in its configuration, instead of its whole text. The arguments are the
+// client ID and an editing state whose "text" is replaced by "rangeDeltas", a
+// list of {"deltaStart", "deltaEnd", "deltaText"} objects applied in order.
+// Each replaces the UTF-16 range [deltaStart, deltaEnd) of the text as it was
+// before that delta with deltaText. This is not the framework's
+// TextEditingDelta protocol, which also requires the old text.
+static constexpr char kUpdateEditingStateWithRangeDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithRangeDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
 static constexpr char kTextInputAction[] = "inputAction";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
+static constexpr char kEnableRangeDeltas[] = "enableRangeDeltas";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
 static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
@@ -34,6 +44,10 @@ static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kTextKey[] = "text";
+static constexpr char kRangeDeltasKey[] = "rangeDeltas";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 
 static constexpr char kChannelName[] = "flutter/textinput";
 
@@ -49,7 +63,7 @@ void TextInputPlugin::TextHook(FlutterWindowsView* view,
     return;
   }
   active_model_->AddText(text);
-  SendStateUpdate(*active_model_);
+  SendUpdate(active_model_.get());
 }
 
 void TextInputPlugin::KeyboardHook(FlutterWindowsView* view,
@@ -135,6 +149,13 @@ void TextInputPlugin::HandleMethodCall(
       }
     }
     active_model_ = std::make_unique<TextInputModel>();
+    auto enable_range_deltas_json =
+        client_config.FindMember(kEnableRangeDeltas);
+    if (enable_range_deltas_json != client_config.MemberEnd() &&
+        enable_range_deltas_json->value.IsBool()) {
+      active_model_->set_delta_tracking_enabled(
+          enable_range_deltas_json->value.GetBool());
+    }
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
       result->Error(kBadArgumentError, "Method invoked without args");
@@ -180,6 +201,14 @@ void TextInputPlugin::HandleMethodCall(
   result->Success();
 }
 
+void TextInputPlugin::SendUpdate(TextInputModel* model) {
+  if (model->delta_tracking_enabled()) {
+    SendDeltaUpdate(model);
+  } else {
+    SendStateUpdate(*model);
+  }
+}
+
 void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
@@ -201,10 +230,42 @@ void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendDeltaUpdate(TextInputModel* model) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  rapidjson::Value deltas(rapidjson::kArrayType);
+  for (const TextEditingDelta& delta : model->TakeDeltas()) {
+    rapidjson::Value delta_json(rapidjson::kObjectType);
+    delta_json.AddMember(
+        kDeltaTextKey, rapidjson::Value(delta.text(), allocator).Move(),
+        allocator);
+    delta_json.AddMember(kDeltaStartKey, delta.range().start(), allocator);
+    delta_json.AddMember(kDeltaEndKey, delta.range().end(), allocator);
+    deltas.PushBack(delta_json, allocator);
+  }
+
+  TextRange selection = model->selection();
+  rapidjson::Value editing_state(rapidjson::kObjectType);
+  editing_state.AddMember(kRangeDeltasKey, deltas, allocator);
+  editing_state.AddMember(kComposingBaseKey, -1, allocator);
+  editing_state.AddMember(kComposingExtentKey, -1, allocator);
+  editing_state.AddMember(kSelectionAffinityKey, kAffinityDownstream,
+                          allocator);
+  editing_state.AddMember(kSelectionBaseKey, selection.base(), allocator);
+  editing_state.AddMember(kSelectionExtentKey, selection.extent(), allocator);
+  editing_state.AddMember(kSelectionIsDirectionalKey, false, allocator);
+  args->PushBack(editing_state, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithRangeDeltasMethod,
+                         std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
     model->AddText(std::u16string({u'\n'}));
-    SendStateUpdate(*model);
+    SendUpdate(model);
   }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
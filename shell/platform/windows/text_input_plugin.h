@@ -39,9 +39,18 @@ class TextInputPlugin : public KeyboardHookHandler {
   void TextHook(FlutterWindowsView* view, const std::u16string& text) override;
 
  private:
+  // Sends the changes made to the given model to the Flutter engine, as
+  // range deltas if the client enabled them, and as the full editing state
+  // otherwise.
+  void SendUpdate(TextInputModel* model);
+
   // Sends the current state of the given model to the Flutter engine.
   void SendStateUpdate(const TextInputModel& model);
 
+  // Sends the changes made to the text of the given model since the last
+  // update, along with its selection, to the Flutter engine.
+  void SendDeltaUpdate(TextInputModel* model);
+
   // Sends an action triggered by the Enter key to the Flutter engine.
   void EnterPressed(TextInputModel* model);
 
@@ -60,4 +60,31 @@ void main() {
       );
     }
   });
+
+  test('lays out a batch of paragraphs like one at a time', () {
+    final List<double> fontSizes = <double>[10.0, 20.0, 30.0, 40.0];
+    final List<Paragraph> paragraphs = <Paragraph>[];
+    final List<ParagraphConstraints> constraints = <ParagraphConstraints>[];
+    for (double fontSize in fontSizes) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'Ahem',
+        fontStyle: FontStyle.normal,
+        fontWeight: FontWeight.normal,
+        fontSize: fontSize,
+      ));
+      builder.addText('Test Ahem');
+      paragraphs.add(builder.build());
+      constraints.add(ParagraphConstraints(width: fontSize * 5.0));
+    }
+
+    Paragraph.layoutAll(paragraphs, constraints);
+
+    for (int i = 0; i < fontSizes.length; i++) {
+      final double fontSize = fontSizes[i];
+      expect(paragraphs[i].height, closeTo(fontSize * 2.0, 0.001));
+      expect(paragraphs[i].width, closeTo(fontSize * 5.0, 0.001));
+      expect(paragraphs[i].minIntrinsicWidth, closeTo(fontSize * 4.0, 0.001));
+      expect(paragraphs[i].maxIntrinsicWidth, closeTo(fontSize * 9.0, 0.001));
+    }
+  });
 }
@@ -340,6 +340,31 @@ void main() {
     expectEquals(name, 'testName');
   });
 
+  test('batched platform messages are delivered in order', () {
+    final List<String> names = <String>[];
+    final List<Object> errors = <Object>[];
+
+    runZonedGuarded(() {
+      window.onPlatformMessage = (String name, _, __) {
+        names.add(name);
+        if (name == 'b') {
+          throw 'failed';
+        }
+      };
+      _dispatchPlatformMessages(
+        <String>['a', 'b', 'c'],
+        <ByteData?>[null, null, null],
+        <int>[1, 2, 3],
+      );
+    }, (Object error, StackTrace stackTrace) {
+      errors.add(error);
+    });
+
+    expectEquals(names.join(), 'abc');
+    expectEquals(errors.length, 1);
+    expectEquals(errors.single, 'failed');
+  });
+
   test('onTextScaleFactorChanged preserves callback zone', () {
     late Zone innerZone;
     late Zone runZoneTextScaleFactor;
@@ -18,7 +18,10 @@
 #include "flutter/fml/logging.h"
 #include "flutter/third_party/txt/tests/txt_test_utils.h"
 #include "third_party/benchmark/include/benchmark/benchmark_api.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "txt/paint_record.h"
+#include "txt/paragraph_builder_txt.h"
 #include "txt/text_style.h"
 
 namespace txt {
@@ -42,4 +45,31 @@ static void BM_PaintRecordInit(benchmark::State& state) {
 }
 BENCHMARK(BM_PaintRecordInit);
 
+// Records a laid out label made of state.range(0) style runs that share a
+// color into a new picture, as a counter repainted every frame is.
+static void BM_PaintRecordRepaint(benchmark::State& state) {
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  for (int i = 0; i < state.range(0); i++) {
+    text_style.font_size = i % 2 == 0 ? 14 : 18;
+    builder.PushStyle(text_style);
+    builder.AddText(u"Frame 1234 ");
+    builder.Pop();
+  }
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(1000);
+
+  SkPictureRecorder recorder;
+  while (state.KeepRunning()) {
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(1000, 100));
+    paragraph->Paint(canvas, 0, 0);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    benchmark::DoNotOptimize(picture);
+  }
+}
+BENCHMARK(BM_PaintRecordRepaint)->RangeMultiplier(2)->Range(1, 16);
+
 }  // namespace txt
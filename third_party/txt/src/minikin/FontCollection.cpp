@@ -43,7 +43,7 @@ static inline T max(T a, T b) {
 const uint32_t EMOJI_STYLE_VS = 0xFE0F;
 const uint32_t TEXT_STYLE_VS = 0xFE0E;
 
-uint32_t FontCollection::sNextId = 0;
+std::atomic<uint32_t> FontCollection::sNextId = 0;
 
 // libtxt: return a locale string for a language list ID
 std::string GetFontLocale(uint32_t langListId) {
@@ -66,7 +66,6 @@ FontCollection::FontCollection(
 
 void FontCollection::init(
     const vector<std::shared_ptr<FontFamily>>& typefaces) {
-  std::scoped_lock _l(gMinikinLock);
   mId = sNextId++;
   vector<uint32_t> lastChar;
   size_t nTypefaces = typefaces.size();
@@ -293,7 +292,7 @@ uint32_t FontCollection::calcVariantMatchingScore(
 // the detail.
 // 3. Highest score wins, with ties resolved to the first font.
 // This method never returns nullptr.
-const std::shared_ptr<FontFamily>& FontCollection::getFamilyForChar(
+std::shared_ptr<FontFamily> FontCollection::getFamilyForChar(
     uint32_t ch,
     uint32_t vs,
     uint32_t langListId,
@@ -301,7 +300,7 @@ const std::shared_ptr<FontFamily>& FontCollection::getFamilyForChar(
   if (ch >= mMaxChar) {
     // libtxt: check if the fallback font provider can match this character
     if (mFallbackFontProvider) {
-      const std::shared_ptr<FontFamily>& fallback =
+      std::shared_ptr<FontFamily> fallback =
           findFallbackFont(ch, vs, langListId);
       if (fallback) {
         return fallback;
@@ -338,7 +337,7 @@ const std::shared_ptr<FontFamily>& FontCollection::getFamilyForChar(
   if (bestFamilyIndex == -1) {
     // libtxt: check if the fallback font provider can match this character
     if (mFallbackFontProvider) {
-      const std::shared_ptr<FontFamily>& fallback =
+      std::shared_ptr<FontFamily> fallback =
           findFallbackFont(ch, vs, langListId);
       if (fallback) {
         return fallback;
@@ -363,12 +362,13 @@ const std::shared_ptr<FontFamily>& FontCollection::getFamilyForChar(
                  : mFamilies[bestFamilyIndex];
 }
 
-const std::shared_ptr<FontFamily>& FontCollection::findFallbackFont(
+std::shared_ptr<FontFamily> FontCollection::findFallbackFont(
     uint32_t ch,
     uint32_t vs,
     uint32_t langListId) const {
   std::string locale = GetFontLocale(langListId);
 
+  std::scoped_lock lock(mCachedFallbackFamiliesMutex);
   const auto it = mCachedFallbackFamilies.find(locale);
   if (it != mCachedFallbackFamilies.end()) {
     for (const auto& fallbackFamily : it->second) {
@@ -378,7 +378,7 @@ const std::shared_ptr<FontFamily>& FontCollection::findFallbackFont(
     }
   }
 
-  const std::shared_ptr<FontFamily>& fallback =
+  std::shared_ptr<FontFamily> fallback =
       mFallbackFontProvider->matchFallbackFont(ch, GetFontLocale(langListId));
 
   if (fallback) {
@@ -428,8 +428,6 @@ bool FontCollection::hasVariationSelector(uint32_t baseCodepoint,
     return false;
   }
 
-  std::scoped_lock _l(gMinikinLock);
-
   // Currently mRanges can not be used here since it isn't aware of the
   // variation sequence.
   for (size_t i = 0; i < mVSFamilyVec.size(); i++) {
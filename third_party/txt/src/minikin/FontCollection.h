@@ -17,8 +17,10 @@
 #ifndef MINIKIN_FONT_COLLECTION_H
 #define MINIKIN_FONT_COLLECTION_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -38,7 +40,7 @@ class FontCollection {
   class FallbackFontProvider {
    public:
     virtual ~FallbackFontProvider() = default;
-    virtual const std::shared_ptr<FontFamily>& matchFallbackFont(
+    virtual std::shared_ptr<FontFamily> matchFallbackFont(
         uint32_t ch,
         std::string locale) = 0;
   };
@@ -96,13 +98,14 @@ class FontCollection {
   // Initialize the FontCollection.
   void init(const std::vector<std::shared_ptr<FontFamily>>& typefaces);
 
-  const std::shared_ptr<FontFamily>& getFamilyForChar(uint32_t ch,
-                                                      uint32_t vs,
-                                                      uint32_t langListId,
-                                                      int variant) const;
+  std::shared_ptr<FontFamily> getFamilyForChar(uint32_t ch,
+                                               uint32_t vs,
+                                               uint32_t langListId,
+                                               int variant) const;
 
-  const std::shared_ptr<FontFamily>&
-  findFallbackFont(uint32_t ch, uint32_t vs, uint32_t langListId) const;
+  std::shared_ptr<FontFamily> findFallbackFont(uint32_t ch,
+                                               uint32_t vs,
+                                               uint32_t langListId) const;
 
   uint32_t calcFamilyScore(uint32_t ch,
                            uint32_t vs,
@@ -122,7 +125,7 @@ class FontCollection {
                                            const FontFamily& fontFamily);
 
   // static for allocating unique id's
-  static uint32_t sNextId;
+  static std::atomic<uint32_t> sNextId;
 
   // unique id for this font collection (suitable for cache key)
   uint32_t mId;
@@ -155,6 +158,7 @@ class FontCollection {
 
   // libtxt extension: Fallback fonts discovered after this font collection
   // was constructed.
+  mutable std::mutex mCachedFallbackFamiliesMutex;
   mutable std::map<std::string, std::vector<std::shared_ptr<FontFamily>>>
       mCachedFallbackFamilies;
 };
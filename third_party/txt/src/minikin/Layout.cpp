@@ -20,8 +20,11 @@
 #include <unicode/ubidi.h>
 #include <unicode/utf16.h>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>  // for debugging
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -50,6 +53,13 @@ struct LayoutContext {
   FontStyle style;
   std::vector<hb_font_t*> hbFonts;  // parallel to mFaces
 
+  ~LayoutContext() {
+    clearHbFonts();
+    if (hbBuffer != nullptr) {
+      hb_buffer_destroy(hbBuffer);
+    }
+  }
+
   void clearHbFonts() {
     for (size_t i = 0; i < hbFonts.size(); i++) {
       hb_font_set_funcs(hbFonts[i], nullptr, nullptr, nullptr);
@@ -57,6 +67,13 @@ struct LayoutContext {
     }
     hbFonts.clear();
   }
+
+  // The buffer is created on first use so that layouts served entirely from
+  // the cache don't allocate one.
+  hb_buffer_t* getHbBuffer();
+
+ private:
+  hb_buffer_t* hbBuffer = nullptr;
 };
 
 // Layout cache datatypes
@@ -98,6 +115,7 @@ class LayoutCacheKey {
     delete[] mChars;
     mChars = NULL;
   }
+  size_t getTextBytes() const { return mNchars * sizeof(uint16_t); }
 
   void doLayout(Layout* layout,
                 LayoutContext* ctx,
@@ -129,53 +147,138 @@ class LayoutCacheKey {
   android::hash_t computeHash() const;
 };
 
-class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
+// The cache is split into shards selected by the key hash, each an LRU cache
+// with its own lock, so that threads laying out different words rarely
+// contend. Words are shaped without holding any lock; the cached layouts are
+// immutable and shared, so a layout evicted by one thread stays valid for the
+// threads still using it.
+//
+// The cache is bounded by the approximate number of bytes used by its entries
+// rather than their number, since the layout of a long word in a complex
+// script can be many times larger than that of a short Latin one. Each shard
+// gets an equal part of the budget.
+class LayoutCache {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
-    mCache.setOnEntryRemovedListener(this);
+  void clear() {
+    for (Shard& shard : mShards) {
+      std::scoped_lock lock(shard.mutex);
+      shard.cache.clear();
+    }
   }
 
-  void clear() { mCache.clear(); }
-
-  Layout* get(LayoutCacheKey& key,
-              LayoutContext* ctx,
-              const std::shared_ptr<FontCollection>& collection) {
-    Layout* layout = mCache.get(key);
-    if (layout == NULL) {
-      key.copyText();
-      layout = new Layout();
-      key.doLayout(layout, ctx, collection);
-      mCache.put(key, layout);
+  std::shared_ptr<Layout> get(
+      LayoutCacheKey& key,
+      LayoutContext* ctx,
+      const std::shared_ptr<FontCollection>& collection) {
+    Shard& shard = mShards[key.hash() % kShardCount];
+    {
+      std::scoped_lock lock(shard.mutex);
+      const std::shared_ptr<Layout>& layout = shard.cache.get(key);
+      if (layout != nullptr) {
+        mHits.fetch_add(1, std::memory_order_relaxed);
+        return layout;
+      }
+    }
+    mMisses.fetch_add(1, std::memory_order_relaxed);
+
+    auto layout = std::make_shared<Layout>();
+    key.doLayout(layout.get(), ctx, collection);
+
+    std::scoped_lock lock(shard.mutex);
+    key.copyText();
+    if (!shard.cache.put(key, layout)) {
+      // Another thread cached the same word in the meantime.
+      key.freeText();
+      return layout;
+    }
+    shard.bytes += entryBytes(key, *layout);
+    const size_t shardMaxBytes =
+        mMaxBytes.load(std::memory_order_relaxed) / kShardCount;
+    // The newest entry is kept even if it alone exceeds the budget.
+    while (shard.bytes > shardMaxBytes && shard.cache.size() > 1) {
+      shard.cache.removeOldest();
+      mEvictions.fetch_add(1, std::memory_order_relaxed);
     }
     return layout;
   }
 
+  void setMaxBytes(size_t maxBytes) {
+    mMaxBytes.store(maxBytes, std::memory_order_relaxed);
+    const size_t shardMaxBytes = maxBytes / kShardCount;
+    for (Shard& shard : mShards) {
+      std::scoped_lock lock(shard.mutex);
+      while (shard.bytes > shardMaxBytes && shard.cache.size() > 0) {
+        shard.cache.removeOldest();
+        mEvictions.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  LayoutCacheStats getStats() {
+    LayoutCacheStats stats;
+    stats.hits = mHits.load(std::memory_order_relaxed);
+    stats.misses = mMisses.load(std::memory_order_relaxed);
+    stats.evictions = mEvictions.load(std::memory_order_relaxed);
+    stats.maxBytes = mMaxBytes.load(std::memory_order_relaxed);
+    for (Shard& shard : mShards) {
+      std::scoped_lock lock(shard.mutex);
+      stats.entries += shard.cache.size();
+      stats.bytes += shard.bytes;
+    }
+    return stats;
+  }
+
  private:
-  // callback for OnEntryRemoved
-  void operator()(LayoutCacheKey& key, Layout*& value) {
-    key.freeText();
-    delete value;
+  static const size_t kShardCount = 16;
+
+  // Roughly the memory used by the 5000 entries the cache used to be limited
+  // to, for text made of short words.
+  static const size_t kDefaultMaxBytes = 2 * 1024 * 1024;
+
+  // The bookkeeping of the LRU cache (key copy, set node and list links) and
+  // the shared_ptr control block, on top of the layout and the key text.
+  static const size_t kEntryOverheadBytes =
+      sizeof(LayoutCacheKey) + sizeof(std::shared_ptr<Layout>) + 64;
+
+  static size_t entryBytes(const LayoutCacheKey& key, const Layout& layout) {
+    return kEntryOverheadBytes + key.getTextBytes() + layout.getMemoryUsage();
   }
 
-  android::LruCache<LayoutCacheKey, Layout*> mCache;
+  class Shard
+      : private android::OnEntryRemoved<LayoutCacheKey,
+                                        std::shared_ptr<Layout>> {
+   public:
+    Shard() : cache(android::LruCache<LayoutCacheKey, std::shared_ptr<Layout>>::
+                        kUnlimitedCapacity) {
+      cache.setOnEntryRemovedListener(this);
+    }
 
-  // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
-  // Layout*>::kUnlimitedCapacity;
+    std::mutex mutex;
+    android::LruCache<LayoutCacheKey, std::shared_ptr<Layout>> cache;
+    size_t bytes = 0;
 
-  // TODO: eviction based on memory footprint; for now, we just use a constant
-  // number of strings
-  static const size_t kMaxEntries = 5000;
+   private:
+    // callback for OnEntryRemoved
+    void operator()(LayoutCacheKey& key, std::shared_ptr<Layout>& value) {
+      bytes -= entryBytes(key, *value);
+      key.freeText();
+    }
+  };
+
+  Shard mShards[kShardCount];
+  std::atomic_size_t mMaxBytes = kDefaultMaxBytes;
+  std::atomic_size_t mHits = 0;
+  std::atomic_size_t mMisses = 0;
+  std::atomic_size_t mEvictions = 0;
 };
 
 class LayoutEngine {
  public:
   LayoutEngine() {
     unicodeFunctions = hb_unicode_funcs_create(hb_icu_get_unicode_funcs());
-    hbBuffer = hb_buffer_create();
-    hb_buffer_set_unicode_funcs(hbBuffer, unicodeFunctions);
+    hb_unicode_funcs_make_immutable(unicodeFunctions);
   }
 
-  hb_buffer_t* hbBuffer;
   hb_unicode_funcs_t* unicodeFunctions;
   LayoutCache layoutCache;
 
@@ -185,6 +288,15 @@ class LayoutEngine {
   }
 };
 
+hb_buffer_t* LayoutContext::getHbBuffer() {
+  if (hbBuffer == nullptr) {
+    hbBuffer = hb_buffer_create();
+    hb_buffer_set_unicode_funcs(hbBuffer,
+                                LayoutEngine::getInstance().unicodeFunctions);
+  }
+  return hbBuffer;
+}
+
 bool LayoutCacheKey::operator==(const LayoutCacheKey& other) const {
   return mId == other.mId && mStart == other.mStart && mCount == other.mCount &&
          mStyle == other.mStyle && mSize == other.mSize &&
@@ -254,34 +366,31 @@ static hb_bool_t harfbuzzGetGlyphHorizontalOrigin(hb_font_t* /* hbFont */,
   return true;
 }
 
-hb_font_funcs_t* getHbFontFuncs(bool forColorBitmapFont) {
-  assertMinikinLocked();
-
-  static hb_font_funcs_t* hbFuncs = nullptr;
-  static hb_font_funcs_t* hbFuncsForColorBitmap = nullptr;
-
-  hb_font_funcs_t** funcs =
-      forColorBitmapFont ? &hbFuncs : &hbFuncsForColorBitmap;
-  if (*funcs == nullptr) {
-    *funcs = hb_font_funcs_create();
-    if (forColorBitmapFont) {
-      // Don't override the h_advance function since we use HarfBuzz's
-      // implementation for emoji for performance reasons. Note that it is
-      // technically possible for a TrueType font to have outline and embedded
-      // bitmap at the same time. We ignore modified advances of hinted outline
-      // glyphs in that case.
-    } else {
-      // Override the h_advance function since we can't use HarfBuzz's
-      // implemenation. It may return the wrong value if the font uses hinting
-      // aggressively.
-      hb_font_funcs_set_glyph_h_advance_func(
-          *funcs, harfbuzzGetGlyphHorizontalAdvance, 0, 0);
-    }
-    hb_font_funcs_set_glyph_h_origin_func(
-        *funcs, harfbuzzGetGlyphHorizontalOrigin, 0, 0);
-    hb_font_funcs_make_immutable(*funcs);
+static hb_font_funcs_t* createHbFontFuncs(bool forColorBitmapFont) {
+  hb_font_funcs_t* funcs = hb_font_funcs_create();
+  if (forColorBitmapFont) {
+    // Don't override the h_advance function since we use HarfBuzz's
+    // implementation for emoji for performance reasons. Note that it is
+    // technically possible for a TrueType font to have outline and embedded
+    // bitmap at the same time. We ignore modified advances of hinted outline
+    // glyphs in that case.
+  } else {
+    // Override the h_advance function since we can't use HarfBuzz's
+    // implemenation. It may return the wrong value if the font uses hinting
+    // aggressively.
+    hb_font_funcs_set_glyph_h_advance_func(
+        funcs, harfbuzzGetGlyphHorizontalAdvance, 0, 0);
   }
-  return *funcs;
+  hb_font_funcs_set_glyph_h_origin_func(funcs, harfbuzzGetGlyphHorizontalOrigin,
+                                        0, 0);
+  hb_font_funcs_make_immutable(funcs);
+  return funcs;
+}
+
+hb_font_funcs_t* getHbFontFuncs(bool forColorBitmapFont) {
+  static hb_font_funcs_t* hbFuncs = createHbFontFuncs(false);
+  static hb_font_funcs_t* hbFuncsForColorBitmap = createHbFontFuncs(true);
+  return forColorBitmapFont ? hbFuncsForColorBitmap : hbFuncs;
 }
 
 static bool isColorBitmapFont(hb_font_t* font) {
@@ -316,7 +425,18 @@ int Layout::findFace(const FakedFont& face, LayoutContext* ctx) {
   // Note: ctx == NULL means we're copying from the cache, no need to create
   // corresponding hb_font object.
   if (ctx != NULL) {
-    hb_font_t* font = getHbFontLocked(face.font);
+    // The cached font is shared with other threads and must not be modified.
+    // The paint specific functions and the scale are set on a font owned by
+    // this context, created from the same parent with the same variations.
+    hb_font_t* cachedFont = getHbFont(face.font);
+    hb_font_t* parent = hb_font_get_parent(cachedFont);
+    hb_font_t* font = hb_font_create_sub_font(
+        parent != hb_font_get_empty() ? parent : cachedFont);
+    unsigned int coordsLength = 0;
+    const int* coords =
+        hb_font_get_var_coords_normalized(cachedFont, &coordsLength);
+    hb_font_set_var_coords_normalized(font, coords, coordsLength);
+    hb_font_destroy(cachedFont);
     hb_font_set_funcs(font, getHbFontFuncs(isColorBitmapFont(font)),
                       &ctx->paint, 0);
     ctx->hbFonts.push_back(font);
@@ -325,10 +445,7 @@ int Layout::findFace(const FakedFont& face, LayoutContext* ctx) {
 }
 
 static hb_script_t codePointToScript(hb_codepoint_t codepoint) {
-  static hb_unicode_funcs_t* u = 0;
-  if (!u) {
-    u = LayoutEngine::getInstance().unicodeFunctions;
-  }
+  static hb_unicode_funcs_t* u = LayoutEngine::getInstance().unicodeFunctions;
   return hb_unicode_script(u, codepoint);
 }
 
@@ -588,8 +705,6 @@ void Layout::doLayout(const uint16_t* buf,
                       const FontStyle& style,
                       const MinikinPaint& paint,
                       const std::shared_ptr<FontCollection>& collection) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -612,8 +727,6 @@ float Layout::measureText(const uint16_t* buf,
                           const MinikinPaint& paint,
                           const std::shared_ptr<FontCollection>& collection,
                           float* advances) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -720,9 +833,9 @@ float Layout::doLayoutWord(const uint16_t* buf,
     }
     advance = layoutForWord.getAdvance();
   } else {
-    Layout* layoutForWord = cache.get(key, ctx, collection);
+    std::shared_ptr<Layout> layoutForWord = cache.get(key, ctx, collection);
     if (layout) {
-      layout->appendLayout(layoutForWord, bufStart, wordSpacing);
+      layout->appendLayout(layoutForWord.get(), bufStart, wordSpacing);
     }
     if (advances) {
       layoutForWord->getAdvances(advances);
@@ -748,7 +861,7 @@ static void addFeatures(const std::string& str,
   const char* end = start + str.size();
 
   while (start < end) {
-    static hb_feature_t feature;
+    hb_feature_t feature;
     const char* p = strchr(start, ',');
     if (!p)
       p = end;
@@ -919,7 +1032,7 @@ void Layout::doLayoutRun(const uint16_t* buf,
                          bool isRtl,
                          LayoutContext* ctx,
                          const std::shared_ptr<FontCollection>& collection) {
-  hb_buffer_t* buffer = LayoutEngine::getInstance().hbBuffer;
+  hb_buffer_t* buffer = ctx->getHbBuffer();
   std::vector<FontCollection::Run> items;
   collection->itemize(buf + start, count, ctx->style, &items);
 
@@ -1192,11 +1305,24 @@ void Layout::getBounds(MinikinRect* bounds) const {
   bounds->set(mBounds);
 }
 
+size_t Layout::getMemoryUsage() const {
+  return sizeof(Layout) + mGlyphs.capacity() * sizeof(LayoutGlyph) +
+         mAdvances.capacity() * sizeof(float) +
+         mFaces.capacity() * sizeof(FakedFont);
+}
+
 void Layout::purgeCaches() {
-  std::scoped_lock _l(gMinikinLock);
   LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
   layoutCache.clear();
-  purgeHbFontCacheLocked();
+  purgeHbFontCache();
+}
+
+void Layout::setCacheMaxBytes(size_t maxBytes) {
+  LayoutEngine::getInstance().layoutCache.setMaxBytes(maxBytes);
+}
+
+LayoutCacheStats Layout::getCacheStats() {
+  return LayoutEngine::getInstance().layoutCache.getStats();
 }
 
 }  // namespace minikin
@@ -57,6 +57,18 @@ enum {
   kBidi_Mask = 0x7
 };
 
+// Statistics of the cache of laid out words shared by all layouts.
+struct LayoutCacheStats {
+  // Lookups that found a cached word, and lookups that had to shape it.
+  size_t hits = 0;
+  size_t misses = 0;
+  // Words removed to stay within the byte budget.
+  size_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;
+  size_t maxBytes = 0;
+};
+
 // Lifecycle and threading assumptions for Layout:
 // The object is assumed to be owned by a single thread; multiple threads
 // may not mutate it at the same time.
@@ -114,9 +126,18 @@ class Layout {
 
   void getBounds(MinikinRect* rect) const;
 
+  // Approximate number of bytes used by this layout.
+  size_t getMemoryUsage() const;
+
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // Sets the approximate number of bytes the cache of laid out words may use.
+  // The least recently used words are evicted once it is exceeded.
+  static void setCacheMaxBytes(size_t maxBytes);
+
+  static LayoutCacheStats getCacheStats();
+
  private:
   friend class LayoutCacheKey;
 
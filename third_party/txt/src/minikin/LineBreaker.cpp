@@ -121,19 +121,25 @@ bool isLineEndSpace(uint16_t c) {
 // paint is nullptr, it assumes the widths have already been calculated and
 // stored in the width buffer. This method finds the candidate word breaks
 // (using the ICU break iterator) and sends them to addCandidate.
+//
+// libtxt: |measured| skips the measurement but keeps the break penalties
+// derived from |paint|.
 float LineBreaker::addStyleRun(MinikinPaint* paint,
                                const std::shared_ptr<FontCollection>& typeface,
                                FontStyle style,
                                size_t start,
                                size_t end,
-                               bool isRtl) {
+                               bool isRtl,
+                               bool measured) {
   float width = 0.0f;
 
   float hyphenPenalty = 0.0;
   if (paint != nullptr) {
-    width = Layout::measureText(mTextBuf.data(), start, end - start,
-                                mTextBuf.size(), isRtl, style, *paint, typeface,
-                                mCharWidths.data() + start);
+    if (!measured) {
+      width = Layout::measureText(mTextBuf.data(), start, end - start,
+                                  mTextBuf.size(), isRtl, style, *paint,
+                                  typeface, mCharWidths.data() + start);
+    }
 
     // a heuristic that seems to perform well
     hyphenPenalty =
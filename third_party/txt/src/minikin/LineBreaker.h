@@ -141,12 +141,18 @@ class LineBreaker {
   // need to be changed is having some kind of callback (or virtual class, or
   // maybe even template), which could easily be instantiated with Minikin's
   // Layout. Future work for when needed.
+  //
+  // libtxt: When |measured| is set, the text is not measured again; the widths
+  // of its characters must already be stored in the width buffer, e.g. copied
+  // from an earlier layout of the same text. The breaks are computed as if the
+  // text had been measured with |paint|, and the returned width is 0.
   float addStyleRun(MinikinPaint* paint,
                     const std::shared_ptr<FontCollection>& typeface,
                     FontStyle style,
                     size_t start,
                     size_t end,
-                    bool isRtl);
+                    bool isRtl,
+                    bool measured = false);
 
   void addReplacement(size_t start, size_t end, float width);
 
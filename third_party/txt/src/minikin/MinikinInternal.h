@@ -19,22 +19,16 @@
 #ifndef MINIKIN_INTERNAL_H
 #define MINIKIN_INTERNAL_H
 
-#include <mutex>
-
 #include <hb.h>
 
 #include <minikin/MinikinFont.h>
 
 namespace minikin {
 
-// All external Minikin interfaces are designed to be thread-safe.
-// Presently, that's implemented by through a global lock, and having
-// all external interfaces take that lock.
-
-extern std::recursive_mutex gMinikinLock;
-
-// Aborts if gMinikinLock is not acquired. Do nothing on the release build.
-void assertMinikinLocked();
+// All external Minikin interfaces are designed to be thread-safe. The caches
+// shared between threads (layouts, HarfBuzz fonts and language lists) each have
+// their own locks, and the HarfBuzz fonts they hold are never modified after
+// they have been created, so layouts can run concurrently.
 
 hb_blob_t* getFontTable(const MinikinFont* minikinFont, uint32_t tag);
 
@@ -0,0 +1,295 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_font_cache.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkString.h"
+#include "txt/platform.h"
+
+namespace txt {
+
+namespace {
+
+// "FLFB" in little endian.
+constexpr uint32_t kSnapshotMagic = 0x42464c46;
+
+struct SnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t fingerprint;
+};
+
+// Followed by |locale_size| bytes of locale and |family_size| bytes of family
+// name.
+struct SnapshotRecord {
+  uint32_t ch;
+  int32_t weight;
+  int32_t width;
+  int32_t slant;
+  uint32_t locale_size;
+  uint32_t family_size;
+};
+
+void Append(std::vector<uint8_t>& contents, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  contents.insert(contents.end(), bytes, bytes + size);
+}
+
+}  // namespace
+
+bool FallbackFontCache::Key::operator==(const Key& other) const {
+  return ch == other.ch && locale == other.locale && style == other.style;
+}
+
+size_t FallbackFontCache::Key::Hasher::operator()(const Key& key) const {
+  return fml::HashCombine(key.ch, key.locale, key.style.weight(),
+                          key.style.width(),
+                          static_cast<int>(key.style.slant()));
+}
+
+FallbackFontCache& FallbackFontCache::GetInstance() {
+  static FallbackFontCache* instance = new FallbackFontCache();
+  return *instance;
+}
+
+FallbackFontCache::FallbackFontCache() = default;
+
+FallbackFontCache::~FallbackFontCache() = default;
+
+uint64_t FallbackFontCache::ComputeFingerprint(SkFontMgr* manager) {
+  TRACE_EVENT0("flutter", "FallbackFontCache::ComputeFingerprint");
+  if (!manager) {
+    return 0;
+  }
+  int count = manager->countFamilies();
+  std::size_t fingerprint = fml::HashCombine(count);
+  for (int i = 0; i < count; i++) {
+    SkString family_name;
+    manager->getFamilyName(i, &family_name);
+    fml::HashCombineSeed(fingerprint, std::string(family_name.c_str()));
+  }
+  return fingerprint;
+}
+
+bool FallbackFontCache::Lookup(uint32_t ch,
+                               const std::string& locale,
+                               const SkFontStyle& style,
+                               std::string* family_name) const {
+  std::scoped_lock lock(mutex_);
+  auto found = entries_.find({ch, locale, style});
+  if (found == entries_.end()) {
+    return false;
+  }
+  *family_name = found->second;
+  return true;
+}
+
+void FallbackFontCache::Insert(uint32_t ch,
+                               const std::string& locale,
+                               const SkFontStyle& style,
+                               const std::string& family_name) {
+  std::scoped_lock lock(mutex_);
+  auto inserted = entries_.insert({{ch, locale, style}, family_name});
+  if (!inserted.second && inserted.first->second == family_name) {
+    return;
+  }
+  inserted.first->second = family_name;
+  dirty_ = true;
+}
+
+void FallbackFontCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  dirty_ = dirty_ || !entries_.empty();
+  entries_.clear();
+}
+
+size_t FallbackFontCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void FallbackFontCache::LoadSnapshot(const std::string& path,
+                                     uint64_t fingerprint) {
+  TRACE_EVENT0("flutter", "FallbackFontCache::LoadSnapshot");
+  if (path.empty()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    if (path == snapshot_path_ && fingerprint == fingerprint_) {
+      return;
+    }
+  }
+
+  // The snapshot is read and parsed with the mutex unlocked so that font
+  // matching on other threads is not blocked by the file system.
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      path.c_str(), true, fml::FilePermission::kReadWrite));
+  Entries entries;
+  bool parsed = false;
+  if (directory->is_valid()) {
+    auto file = fml::OpenFileReadOnly(*directory, kSnapshotFileName);
+    if (file.is_valid()) {
+      fml::FileMapping mapping(file);
+      parsed = Parse(mapping.GetMapping(), mapping.GetSize(), fingerprint,
+                     &entries);
+      if (!parsed) {
+        FML_LOG(INFO) << "Ignoring a font fallback cache written for other "
+                         "fonts or by another version.";
+      }
+    }
+  } else {
+    FML_LOG(WARNING) << "Could not open the font fallback cache directory "
+                     << path;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (path == snapshot_path_ && fingerprint == fingerprint_) {
+    // Another thread loaded the same snapshot in the meantime.
+    return;
+  }
+  snapshot_path_ = path;
+  fingerprint_ = fingerprint;
+  snapshot_directory_ = std::move(directory);
+  if (parsed) {
+    // Only the matches made before the snapshot was loaded are new.
+    bool was_dirty = dirty_;
+    MergeLocked(std::move(entries));
+    dirty_ = was_dirty;
+  }
+}
+
+void FallbackFontCache::LoadSnapshot(const std::string& path) {
+  if (path.empty()) {
+    return;
+  }
+  LoadSnapshot(path, ComputeFingerprint(GetDefaultFontManager().get()));
+}
+
+bool FallbackFontCache::ScheduleSave() {
+  std::scoped_lock lock(mutex_);
+  if (!dirty_ || save_scheduled_ || !snapshot_directory_ ||
+      !snapshot_directory_->is_valid()) {
+    return false;
+  }
+  save_scheduled_ = true;
+  return true;
+}
+
+bool FallbackFontCache::SaveSnapshot() {
+  std::vector<uint8_t> contents;
+  std::shared_ptr<fml::UniqueFD> directory;
+  {
+    std::scoped_lock lock(mutex_);
+    save_scheduled_ = false;
+    directory = snapshot_directory_;
+    if (!directory || !directory->is_valid()) {
+      return false;
+    }
+    if (!dirty_) {
+      return true;
+    }
+    contents = SerializeLocked(fingerprint_);
+    dirty_ = false;
+  }
+
+  TRACE_EVENT0("flutter", "FallbackFontCache::SaveSnapshot");
+  if (!fml::WriteAtomically(*directory, kSnapshotFileName,
+                            fml::DataMapping(std::move(contents)))) {
+    FML_LOG(WARNING) << "Could not write the font fallback cache.";
+    std::scoped_lock lock(mutex_);
+    dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> FallbackFontCache::Serialize(uint64_t fingerprint) const {
+  std::scoped_lock lock(mutex_);
+  return SerializeLocked(fingerprint);
+}
+
+bool FallbackFontCache::Deserialize(const uint8_t* data,
+                                    size_t size,
+                                    uint64_t fingerprint) {
+  Entries entries;
+  if (!Parse(data, size, fingerprint, &entries)) {
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  MergeLocked(std::move(entries));
+  return true;
+}
+
+std::vector<uint8_t> FallbackFontCache::SerializeLocked(
+    uint64_t fingerprint) const {
+  std::vector<uint8_t> contents;
+  const SnapshotHeader header = {kSnapshotMagic, kVersion, fingerprint};
+  Append(contents, &header, sizeof(header));
+  for (const auto& [key, family_name] : entries_) {
+    const SnapshotRecord record = {
+        key.ch,
+        key.style.weight(),
+        key.style.width(),
+        static_cast<int32_t>(key.style.slant()),
+        static_cast<uint32_t>(key.locale.size()),
+        static_cast<uint32_t>(family_name.size())};
+    Append(contents, &record, sizeof(record));
+    Append(contents, key.locale.data(), key.locale.size());
+    Append(contents, family_name.data(), family_name.size());
+  }
+  return contents;
+}
+
+bool FallbackFontCache::Parse(const uint8_t* data,
+                              size_t size,
+                              uint64_t fingerprint,
+                              Entries* entries) {
+  if (data == nullptr || size < sizeof(SnapshotHeader)) {
+    return false;
+  }
+  SnapshotHeader header;
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kSnapshotMagic || header.version != kVersion ||
+      header.fingerprint != fingerprint) {
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  while (size - offset >= sizeof(SnapshotRecord)) {
+    SnapshotRecord record;
+    memcpy(&record, data + offset, sizeof(record));
+    offset += sizeof(record);
+    if (record.locale_size > size - offset ||
+        record.family_size > size - offset - record.locale_size) {
+      break;
+    }
+    const char* chars = reinterpret_cast<const char*>(data + offset);
+    Key key = {record.ch, std::string(chars, record.locale_size),
+               SkFontStyle(record.weight, record.width,
+                           static_cast<SkFontStyle::Slant>(record.slant))};
+    std::string family_name(chars + record.locale_size, record.family_size);
+    offset += record.locale_size + record.family_size;
+    entries->emplace(std::move(key), std::move(family_name));
+  }
+  return true;
+}
+
+void FallbackFontCache::MergeLocked(Entries entries) {
+  for (auto& [key, family_name] : entries) {
+    // Matches made by this process take precedence over the snapshot.
+    if (entries_.emplace(key, std::move(family_name)).second) {
+      dirty_ = true;
+    }
+  }
+}
+
+}  // namespace txt
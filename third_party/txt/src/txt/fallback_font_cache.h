@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
+#define LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+
+namespace txt {
+
+// The fallback font families matched for code points by the platform's default
+// font manager, shared by all the font collections of the process.
+//
+// Asking the platform for a font that covers a code point is slow, and a new
+// font collection asks again for every code point its text is missing. Since
+// the default font manager is the same for every collection, its matches are
+// cached here, so that a new engine starts with the matches of the engines
+// before it. The cache can also be written to a snapshot that is loaded by
+// later runs of the process.
+//
+// All methods are thread-safe.
+class FallbackFontCache {
+ public:
+  static constexpr uint32_t kVersion = 1;
+
+  static constexpr char kSnapshotFileName[] = "io.flutter.font_fallback_cache";
+
+  // The cache shared by the font collections of the process.
+  static FallbackFontCache& GetInstance();
+
+  FallbackFontCache();
+
+  ~FallbackFontCache();
+
+  // Returns a value identifying the font families of |manager|. Matches made by
+  // a manager with another set of families are not valid.
+  static uint64_t ComputeFingerprint(SkFontMgr* manager);
+
+  // Looks up the family matched for |ch|. Returns false if no match is cached.
+  // Otherwise sets |family_name|, which is empty if no family covers |ch|.
+  bool Lookup(uint32_t ch,
+              const std::string& locale,
+              const SkFontStyle& style,
+              std::string* family_name) const;
+
+  // Caches the family matched for |ch|. An empty |family_name| records that no
+  // family covers |ch|.
+  void Insert(uint32_t ch,
+              const std::string& locale,
+              const SkFontStyle& style,
+              const std::string& family_name);
+
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  // Keeps the snapshot in the directory at |path|, creating it if needed, and
+  // adds the matches stored in the snapshot to the cache. Does nothing if the
+  // snapshot was already loaded from |path|. A snapshot written with another
+  // fingerprint of the default font manager is ignored, and replaced by the
+  // next save.
+  void LoadSnapshot(const std::string& path, uint64_t fingerprint);
+
+  // Loads the snapshot at |path| with the fingerprint of the platform's
+  // default font manager. This may take a while and should not be called on
+  // the UI thread.
+  void LoadSnapshot(const std::string& path);
+
+  // Returns true unless a save is already scheduled or there is nothing new to
+  // save, in which case the caller does not need to schedule one.
+  bool ScheduleSave();
+
+  // Writes the cache to the snapshot if it changed since it was last loaded or
+  // written.
+  bool SaveSnapshot();
+
+  // The contents of a snapshot of the cache.
+  std::vector<uint8_t> Serialize(uint64_t fingerprint) const;
+
+  // Adds the matches stored in |data| to the cache. Returns false if |data| is
+  // not a snapshot written with |fingerprint|.
+  bool Deserialize(const uint8_t* data, size_t size, uint64_t fingerprint);
+
+ private:
+  struct Key {
+    uint32_t ch;
+    std::string locale;
+    SkFontStyle style;
+
+    bool operator==(const Key& other) const;
+
+    struct Hasher {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  using Entries = std::unordered_map<Key, std::string, Key::Hasher>;
+
+  mutable std::mutex mutex_;
+  Entries entries_;
+  std::string snapshot_path_;
+  std::shared_ptr<fml::UniqueFD> snapshot_directory_;
+  uint64_t fingerprint_ = 0;
+  bool dirty_ = false;
+  bool save_scheduled_ = false;
+
+  std::vector<uint8_t> SerializeLocked(uint64_t fingerprint) const;
+
+  // Reads the matches stored in |data| into |entries| without touching the
+  // cache, so that it can be done with |mutex_| unlocked.
+  static bool Parse(const uint8_t* data,
+                    size_t size,
+                    uint64_t fingerprint,
+                    Entries* entries);
+
+  void MergeLocked(Entries entries);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackFontCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_FALLBACK_FONT_CACHE_H_
@@ -28,6 +28,7 @@
 #include "flutter/fml/trace_event.h"
 #include "font_skia.h"
 #include "minikin/Layout.h"
+#include "txt/fallback_font_cache.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
@@ -66,7 +67,7 @@ class TxtFallbackFontProvider
   TxtFallbackFontProvider(std::shared_ptr<FontCollection> font_collection)
       : font_collection_(font_collection) {}
 
-  virtual const std::shared_ptr<minikin::FontFamily>& matchFallbackFont(
+  virtual std::shared_ptr<minikin::FontFamily> matchFallbackFont(
       uint32_t ch,
       std::string locale) {
     std::shared_ptr<FontCollection> fc = font_collection_.lock();
@@ -99,10 +100,12 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager() {
   default_font_manager_ = GetDefaultFontManager();
+  default_font_manager_is_platform_ = true;
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
+  default_font_manager_is_platform_ = false;
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -161,6 +164,7 @@ std::shared_ptr<minikin::FontCollection>
 FontCollection::GetMinikinFontCollectionForFamilies(
     const std::vector<std::string>& font_families,
     const std::string& locale) {
+  std::scoped_lock lock(cache_mutex_);
   // Look inside the font collections cache first.
   FamilyKey family_key(font_families, locale);
   auto cached = font_collections_cache_.find(family_key);
@@ -306,9 +310,10 @@ std::shared_ptr<minikin::FontFamily> FontCollection::CreateMinikinFontFamily(
   return std::make_shared<minikin::FontFamily>(std::move(minikin_fonts));
 }
 
-const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
+std::shared_ptr<minikin::FontFamily> FontCollection::MatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  std::scoped_lock lock(cache_mutex_);
   // Check if the ch's matched font has been cached. We cache the results of
   // this method as repeated matchFamilyStyleCharacter calls can become
   // extremely laggy when typing a large number of complex emojis.
@@ -325,19 +330,29 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
 const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  FallbackFontCache& shared_cache = FallbackFontCache::GetInstance();
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
-    std::vector<const char*> bcp47;
-    if (!locale.empty())
-      bcp47.push_back(locale.c_str());
-    sk_sp<SkTypeface> typeface(manager->matchFamilyStyleCharacter(
-        0, SkFontStyle(), bcp47.data(), bcp47.size(), ch));
-    if (!typeface)
+    bool use_shared_cache =
+        default_font_manager_is_platform_ && manager == default_font_manager_;
+    std::string family_name;
+    if (!use_shared_cache ||
+        !shared_cache.Lookup(ch, locale, SkFontStyle(), &family_name)) {
+      std::vector<const char*> bcp47;
+      if (!locale.empty())
+        bcp47.push_back(locale.c_str());
+      sk_sp<SkTypeface> typeface(manager->matchFamilyStyleCharacter(
+          0, SkFontStyle(), bcp47.data(), bcp47.size(), ch));
+      if (typeface) {
+        SkString sk_family_name;
+        typeface->getFamilyName(&sk_family_name);
+        family_name = sk_family_name.c_str();
+      }
+      if (use_shared_cache)
+        shared_cache.Insert(ch, locale, SkFontStyle(), family_name);
+    }
+    if (family_name.empty())
       continue;
 
-    SkString sk_family_name;
-    typeface->getFamilyName(&sk_family_name);
-    std::string family_name(sk_family_name.c_str());
-
     if (std::find(fallback_fonts_for_locale_[locale].begin(),
                   fallback_fonts_for_locale_[locale].end(),
                   family_name) == fallback_fonts_for_locale_[locale].end())
@@ -373,6 +388,7 @@ FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
 }
 
 void FontCollection::ClearFontFamilyCache() {
+  std::scoped_lock lock(cache_mutex_);
   font_collections_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
@@ -382,6 +398,19 @@ void FontCollection::ClearFontFamilyCache() {
 #endif
 }
 
+void FontCollection::SetLayoutCacheMaxBytes(size_t max_bytes) {
+  minikin::Layout::setCacheMaxBytes(max_bytes);
+}
+
+void FontCollection::TraceLayoutCacheStats() {
+#if !FLUTTER_RELEASE
+  minikin::LayoutCacheStats stats = minikin::Layout::getCacheStats();
+  FML_TRACE_COUNTER("flutter", "LayoutCache", 0, "Hits", stats.hits, "Misses",
+                    stats.misses, "Evictions", stats.evictions, "Entries",
+                    stats.entries, "KBytes", stats.bytes / 1024);
+#endif  // !FLUTTER_RELEASE
+}
+
 #if FLUTTER_ENABLE_SKSHAPER
 
 sk_sp<skia::textlayout::FontCollection>
@@ -18,6 +18,7 @@
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -37,6 +38,9 @@
 
 namespace txt {
 
+// The font managers of a collection are set up on a single thread. Once they
+// are, the collection may be used to lay out paragraphs on several threads at
+// once.
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -57,7 +61,10 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
 
   // Provides a FontFamily that contains glyphs for ch. This caches previously
   // matched fonts. Also see FontCollection::DoMatchFallbackFont.
-  const std::shared_ptr<minikin::FontFamily>& MatchFallbackFont(
+  //
+  // Returns a copy of the family, so that callers on other threads do not
+  // depend on the fallback font caches once the cache lock is released.
+  std::shared_ptr<minikin::FontFamily> MatchFallbackFont(
       uint32_t ch,
       std::string locale);
 
@@ -68,6 +75,14 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Set the size limit in bytes of the cache of shaped words, which is shared
+  // by all font collections.
+  static void SetLayoutCacheMaxBytes(size_t max_bytes);
+
+  // Emit the hit, miss and eviction counts of the cache of shaped words to the
+  // timeline.
+  static void TraceLayoutCacheStats();
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
@@ -94,6 +109,11 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
+  // Whether the default font manager is the platform's, whose fallback matches
+  // are shared with the other collections through the FallbackFontCache.
+  bool default_font_manager_is_platform_ = false;
+  // Guards the caches of font collections and fallback fonts below.
+  std::mutex cache_mutex_;
   std::unordered_map<FamilyKey,
                      std::shared_ptr<minikin::FontCollection>,
                      FamilyKey::Hasher>
@@ -114,7 +134,8 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
 #endif
 
   // Performs the actual work of MatchFallbackFont. The result is cached in
-  // fallback_match_cache_.
+  // fallback_match_cache_. The matches of the platform's default font manager
+  // are also cached for the whole process by the FallbackFontCache.
   const std::shared_ptr<minikin::FontFamily>& DoMatchFallbackFont(
       uint32_t ch,
       std::string locale);
@@ -175,6 +175,12 @@ class Paragraph {
   virtual Range<size_t> GetWordBoundary(size_t offset) = 0;
 
   virtual std::vector<LineMetrics>& GetLineMetrics() = 0;
+
+  // Returns a hash of everything Paint() draws, so that pictures holding the
+  // paragraph can be recognized when it is painted again with the same
+  // content. Paragraphs with equal hashes paint identical pixels. Returns 0 if
+  // the content is unknown. Only valid after Layout() is called.
+  virtual uint64_t GetContentHash() { return 0; }
 };
 
 }  // namespace txt
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "font_collection.h"
 #include "font_skia.h"
@@ -187,6 +188,41 @@ void FindWords(const std::vector<uint16_t>& text,
     words->emplace_back(word_start, end);
 }
 
+// Returns the paint the glyphs of a run with |style| are drawn with.
+SkPaint GetTextPaint(const TextStyle& style) {
+  if (style.has_foreground)
+    return style.foreground;
+  SkPaint paint;
+  paint.setColor(style.color);
+  return paint;
+}
+
+// Whether the blob of |record| can be drawn as part of a merged blob. Records
+// with shadows or decorations are drawn on their own to keep the order in
+// which these are painted over the glyphs of the neighbouring records.
+bool CanMergeTextBlob(const PaintRecord& record) {
+  return record.GetPlaceholderRun() == nullptr &&
+         record.style().decoration == TextDecoration::kNone &&
+         record.style().text_shadows.empty();
+}
+
+// Combines the parts of |paint| that change how shapes drawn with it look into
+// |hash|. Returns false if the paint has effects that are not hashed.
+bool HashPaint(const SkPaint& paint, uint64_t& hash) {
+  if (paint.getShader() || paint.getColorFilter() || paint.getMaskFilter() ||
+      paint.getPathEffect() || paint.getImageFilter())
+    return false;
+  SkColor4f color = paint.getColor4f();
+  fml::HashCombineSeed64(hash, color.fR, color.fG, color.fB, color.fA,
+                         static_cast<int>(paint.getBlendMode()),
+                         static_cast<int>(paint.getStyle()),
+                         paint.getStrokeWidth(), paint.getStrokeMiter(),
+                         static_cast<int>(paint.getStrokeCap()),
+                         static_cast<int>(paint.getStrokeJoin()),
+                         paint.isAntiAlias(), paint.isDither());
+  return true;
+}
+
 }  // namespace
 
 static const float kDoubleDecorationSpacing = 3.0f;
@@ -250,11 +286,26 @@ void ParagraphTxt::SetInlinePlaceholders(
   obj_replacement_char_indexes_ = std::move(obj_replacement_char_indexes);
 }
 
+void ParagraphTxt::ClearShapingCache() {
+  shaping_cached_ = false;
+  bidi_runs_.clear();
+  line_breaker_char_widths_.clear();
+  line_breaker_run_widths_.clear();
+  shaped_runs_.clear();
+}
+
 bool ParagraphTxt::ComputeLineBreaks() {
   line_metrics_.clear();
   line_widths_.clear();
   max_intrinsic_width_ = 0;
 
+  // Unless an earlier layout measured the text, record the widths measured by
+  // the line breaker so that they can be reused by the next layout.
+  if (!shaping_cached_) {
+    line_breaker_char_widths_.assign(text_.size(), 0);
+    line_breaker_run_widths_.clear();
+  }
+
   std::vector<size_t> newline_positions;
   // Discover and add all hard breaks.
   for (size_t i = 0; i < text_.size(); ++i) {
@@ -268,6 +319,7 @@ bool ParagraphTxt::ComputeLineBreaks() {
 
   // Calculate and add any breaks due to a line being too long.
   size_t run_index = 0;
+  size_t measured_run_index = 0;
   size_t inline_placeholder_index = 0;
   for (size_t newline_index = 0; newline_index < newline_positions.size();
        ++newline_index) {
@@ -293,6 +345,11 @@ bool ParagraphTxt::ComputeLineBreaks() {
     memcpy(breaker_.buffer(), text_.data() + block_start,
            block_size * sizeof(text_[0]));
     breaker_.setText();
+    if (shaping_cached_) {
+      std::copy(line_breaker_char_widths_.begin() + block_start,
+                line_breaker_char_widths_.begin() + block_end,
+                breaker_.charWidths());
+    }
 
     // Add the runs that include this line to the LineBreaker.
     double block_total_width = 0;
@@ -344,8 +401,17 @@ bool ParagraphTxt::ComputeLineBreaks() {
         inline_placeholder_index++;
       } else {
         // Is a regular text run.
-        double run_width = breaker_.addStyleRun(&paint, collection, font,
-                                                run_start, run_end, isRtl);
+        double run_width;
+        if (shaping_cached_) {
+          breaker_.addStyleRun(&paint, collection, font, run_start, run_end,
+                               isRtl, true);
+          run_width = line_breaker_run_widths_[measured_run_index];
+        } else {
+          run_width = breaker_.addStyleRun(&paint, collection, font, run_start,
+                                           run_end, isRtl);
+          line_breaker_run_widths_.push_back(run_width);
+        }
+        measured_run_index++;
         block_total_width += run_width;
       }
 
@@ -354,6 +420,10 @@ bool ParagraphTxt::ComputeLineBreaks() {
       run_index++;
     }
     max_intrinsic_width_ = std::max(max_intrinsic_width_, block_total_width);
+    if (!shaping_cached_) {
+      std::copy(breaker_.charWidths(), breaker_.charWidths() + block_size,
+                line_breaker_char_widths_.begin() + block_start);
+    }
 
     size_t breaks_count = breaker_.computeBreaks();
     const int* breaks = breaker_.getBreaks();
@@ -665,9 +735,16 @@ void ParagraphTxt::Layout(double width) {
 
   width_ = rounded_width;
 
+  // Only the width changed since the last layout unless the paragraph was
+  // marked dirty.
+  if (needs_layout_)
+    ClearShapingCache();
   needs_layout_ = false;
+  layout_generation_++;
 
   records_.clear();
+  merged_blobs_.clear();
+  content_hash_ = fml::HashCombine64();
   glyph_lines_.clear();
   code_unit_runs_.clear();
   inline_placeholder_code_unit_runs_.clear();
@@ -678,9 +755,12 @@ void ParagraphTxt::Layout(double width) {
   if (!ComputeLineBreaks())
     return;
 
-  std::vector<BidiRun> bidi_runs;
-  if (!ComputeBidiRuns(&bidi_runs))
-    return;
+  if (!shaping_cached_) {
+    bidi_runs_.clear();
+    if (!ComputeBidiRuns(&bidi_runs_))
+      return;
+    shaping_cached_ = true;
+  }
 
   SkFont font;
   font.setEdging(SkFont::Edging::kAntiAlias);
@@ -731,7 +811,7 @@ void ParagraphTxt::Layout(double width) {
 
     // Find the runs comprising this line.
     std::vector<BidiRun> line_runs;
-    for (const BidiRun& bidi_run : bidi_runs) {
+    for (const BidiRun& bidi_run : bidi_runs_) {
       // A "ghost" run is a run that does not impact the layout, breaking,
       // alignment, width, etc but is still "visible" through getRectsForRange.
       // For example, trailing whitespace on centered text can be scrolled
@@ -796,6 +876,7 @@ void ParagraphTxt::Layout(double width) {
     double run_x_offset = 0;
     double justify_x_offset = 0;
     std::vector<PaintRecord> paint_records;
+    std::vector<RecordGlyphs> line_record_glyphs;
 
     for (auto line_run_it = line_runs.begin(); line_run_it != line_runs.end();
          ++line_run_it) {
@@ -861,10 +942,18 @@ void ParagraphTxt::Layout(double width) {
         }
       }
 
-      layout.doLayout(text_ptr, text_start, text_count, text_size, run.is_rtl(),
-                      minikin_font, minikin_paint, minikin_font_collection);
+      // Only the ellipsized text has to be shaped for this line alone.
+      minikin::Layout* run_layout = &layout;
+      if (ellipsized_text.empty()) {
+        run_layout = GetShapedRun(run, minikin_font, minikin_paint,
+                                  minikin_font_collection);
+      } else {
+        layout.doLayout(text_ptr, text_start, text_count, text_size,
+                        run.is_rtl(), minikin_font, minikin_paint,
+                        minikin_font_collection);
+      }
 
-      if (layout.nGlyphs() == 0)
+      if (run_layout->nGlyphs() == 0)
         continue;
 
       // When laying out RTL ghost runs, shift the run_x_offset here by the
@@ -876,13 +965,14 @@ void ParagraphTxt::Layout(double width) {
       // later runs are laid out in the same position as if there were no ghost
       // run.
       if (run.is_ghost() && run.is_rtl())
-        run_x_offset -= layout.getAdvance();
+        run_x_offset -= run_layout->getAdvance();
 
       std::vector<float> layout_advances(text_count);
-      layout.getAdvances(layout_advances.data());
+      run_layout->getAdvances(layout_advances.data());
 
       // Break the layout into blobs that share the same SkPaint parameters.
-      std::vector<Range<size_t>> glyph_blobs = GetLayoutTypefaceRuns(layout);
+      std::vector<Range<size_t>> glyph_blobs =
+          GetLayoutTypefaceRuns(*run_layout);
 
       double word_start_position = std::numeric_limits<double>::quiet_NaN();
 
@@ -890,7 +980,7 @@ void ParagraphTxt::Layout(double width) {
       for (const Range<size_t>& glyph_blob : glyph_blobs) {
         std::vector<GlyphPosition> glyph_positions;
 
-        GetGlyphTypeface(layout, glyph_blob.start).apply(font);
+        GetGlyphTypeface(*run_layout, glyph_blob.start).apply(font);
         const SkTextBlobBuilder::RunBuffer& blob_buffer =
             builder.allocRunPos(font, glyph_blob.end - glyph_blob.start);
 
@@ -898,38 +988,40 @@ void ParagraphTxt::Layout(double width) {
         for (size_t glyph_index = glyph_blob.start;
              glyph_index < glyph_blob.end;) {
           size_t cluster_start_glyph_index = glyph_index;
-          uint32_t cluster = layout.getGlyphCluster(cluster_start_glyph_index);
+          uint32_t cluster =
+              run_layout->getGlyphCluster(cluster_start_glyph_index);
           double glyph_x_offset;
           // Add all the glyphs in this cluster to the text blob.
           do {
             size_t blob_index = glyph_index - glyph_blob.start;
-            blob_buffer.glyphs[blob_index] = layout.getGlyphId(glyph_index);
+            blob_buffer.glyphs[blob_index] =
+                run_layout->getGlyphId(glyph_index);
 
             size_t pos_index = blob_index * 2;
             blob_buffer.pos[pos_index] =
-                layout.getX(glyph_index) + justify_x_offset_delta;
-            blob_buffer.pos[pos_index + 1] = layout.getY(glyph_index);
+                run_layout->getX(glyph_index) + justify_x_offset_delta;
+            blob_buffer.pos[pos_index + 1] = run_layout->getY(glyph_index);
 
             if (glyph_index == cluster_start_glyph_index)
               glyph_x_offset = blob_buffer.pos[pos_index];
 
             glyph_index++;
           } while (glyph_index < glyph_blob.end &&
-                   layout.getGlyphCluster(glyph_index) == cluster);
+                   run_layout->getGlyphCluster(glyph_index) == cluster);
 
           Range<int32_t> glyph_code_units(cluster, 0);
           std::vector<size_t> grapheme_code_unit_counts;
           if (run.is_rtl()) {
             if (cluster_start_glyph_index > 0) {
               glyph_code_units.end =
-                  layout.getGlyphCluster(cluster_start_glyph_index - 1);
+                  run_layout->getGlyphCluster(cluster_start_glyph_index - 1);
             } else {
               glyph_code_units.end = text_count;
             }
             grapheme_code_unit_counts.push_back(glyph_code_units.width());
           } else {
-            if (glyph_index < layout.nGlyphs()) {
-              glyph_code_units.end = layout.getGlyphCluster(glyph_index);
+            if (glyph_index < run_layout->nGlyphs()) {
+              glyph_code_units.end = run_layout->getGlyphCluster(glyph_index);
             } else {
               glyph_code_units.end = text_count;
             }
@@ -956,10 +1048,10 @@ void ParagraphTxt::Layout(double width) {
             // The placeholder run's layout should yield one glyph representing
             // the object replacement character.  Replace its width with the
             // placeholder's width.
-            FML_DCHECK(layout.nGlyphs() == 1);
+            FML_DCHECK(run_layout->nGlyphs() == 1);
             glyph_advance = run.placeholder_run()->width;
           } else {
-            glyph_advance = layout.getCharAdvance(glyph_code_units.start);
+            glyph_advance = run_layout->getCharAdvance(glyph_code_units.start);
           }
           float grapheme_advance =
               glyph_advance / grapheme_code_unit_counts.size();
@@ -1025,6 +1117,16 @@ void ParagraphTxt::Layout(double width) {
         Range<double> record_x_pos(
             glyph_positions.front().x_pos.start - run_x_offset,
             glyph_positions.back().x_pos.end - run_x_offset);
+        RecordGlyphs record_glyphs;
+        if (!run.is_placeholder_run()) {
+          size_t glyph_count = glyph_blob.end - glyph_blob.start;
+          record_glyphs.font = font;
+          record_glyphs.glyphs.assign(blob_buffer.glyphs,
+                                      blob_buffer.glyphs + glyph_count);
+          record_glyphs.positions.assign(blob_buffer.points(),
+                                         blob_buffer.points() + glyph_count);
+        }
+        line_record_glyphs.push_back(std::move(record_glyphs));
         paint_records.emplace_back(
             run.style(), SkPoint::Make(run_x_offset + justify_x_offset, 0),
             builder.make(), *metrics, line_number, record_x_pos.start,
@@ -1070,7 +1172,7 @@ void ParagraphTxt::Layout(double width) {
         // run_x_offset. We do keep the record though so GetRectsForRange() can
         // find metrics for trailing spaces.
         if (!run.is_ghost() || run.is_rtl()) {
-          run_x_offset += layout.getAdvance();
+          run_x_offset += run_layout->getAdvance();
         }
       }
     }  // for each in line_runs
@@ -1152,11 +1254,14 @@ void ParagraphTxt::Layout(double width) {
 
     final_line_count_++;
 
+    size_t first_line_record = records_.size();
     for (PaintRecord& paint_record : paint_records) {
       paint_record.SetOffset(
           SkPoint::Make(paint_record.offset().x() + line_x_offset, y_offset));
       records_.emplace_back(std::move(paint_record));
     }
+    MergeTextBlobs(first_line_record, line_record_glyphs);
+    HashRecords(first_line_record, line_record_glyphs);
   }  // for each line_number
 
   if (paragraph_style_.max_lines == 1 ||
@@ -1172,6 +1277,111 @@ void ParagraphTxt::Layout(double width) {
             });
 
   longest_line_ = max_right_ - min_left_;
+
+  // Keep the runs shaped by this layout and the one before it.
+  for (auto it = shaped_runs_.begin(); it != shaped_runs_.end();) {
+    if (it->second.generation + 1 < layout_generation_) {
+      it = shaped_runs_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ParagraphTxt::MergeTextBlobs(size_t first_record,
+                                  const std::vector<RecordGlyphs>& glyphs) {
+  FML_DCHECK(records_.size() - first_record == glyphs.size());
+  SkTextBlobBuilder builder;
+  size_t start = first_record;
+  while (start < records_.size()) {
+    const PaintRecord& first = records_[start];
+    size_t end = start + 1;
+    if (CanMergeTextBlob(first)) {
+      SkPaint paint = GetTextPaint(first.style());
+      while (end < records_.size() && CanMergeTextBlob(records_[end]) &&
+             GetTextPaint(records_[end].style()) == paint)
+        end++;
+    }
+    if (end - start > 1) {
+      for (size_t i = start; i < end; ++i) {
+        const RecordGlyphs& record_glyphs = glyphs[i - first_record];
+        SkVector shift = records_[i].offset() - first.offset();
+        const SkTextBlobBuilder::RunBuffer& blob_buffer = builder.allocRunPos(
+            record_glyphs.font, record_glyphs.glyphs.size());
+        std::copy(record_glyphs.glyphs.begin(), record_glyphs.glyphs.end(),
+                  blob_buffer.glyphs);
+        for (size_t j = 0; j < record_glyphs.positions.size(); ++j)
+          blob_buffer.points()[j] = record_glyphs.positions[j] + shift;
+      }
+      merged_blobs_.push_back({start, end - start, builder.make()});
+    }
+    start = end;
+  }
+}
+
+void ParagraphTxt::HashRecords(size_t first_record,
+                               const std::vector<RecordGlyphs>& glyphs) {
+  if (content_hash_ == 0)
+    return;
+  uint64_t hash = content_hash_;
+  for (size_t i = first_record; i < records_.size(); ++i) {
+    const PaintRecord& record = records_[i];
+    const TextStyle& style = record.style();
+    const SkFontMetrics& metrics = record.metrics();
+    fml::HashCombineSeed64(
+        hash, record.offset().x(), record.offset().y(), record.x_start(),
+        record.x_end(), record.isGhost(), record.GetPlaceholderRun() == nullptr,
+        metrics.fAscent, metrics.fDescent, metrics.fFlags,
+        metrics.fUnderlinePosition, metrics.fUnderlineThickness);
+
+    const RecordGlyphs& record_glyphs = glyphs[i - first_record];
+    const SkFont& font = record_glyphs.font;
+    fml::HashCombineSeed64(hash, font.getTypefaceOrDefault()->uniqueID(),
+                           font.getSize(), font.getScaleX(), font.getSkewX(),
+                           font.isEmbolden());
+    for (size_t j = 0; j < record_glyphs.glyphs.size(); ++j) {
+      fml::HashCombineSeed64(hash, record_glyphs.glyphs[j],
+                             record_glyphs.positions[j].x(),
+                             record_glyphs.positions[j].y());
+    }
+
+    bool hashed = HashPaint(GetTextPaint(style), hash);
+    fml::HashCombineSeed64(hash, style.has_background);
+    if (style.has_background)
+      hashed = hashed && HashPaint(style.background, hash);
+    fml::HashCombineSeed64(hash, static_cast<int>(style.decoration),
+                           style.decoration_color,
+                           static_cast<int>(style.decoration_style),
+                           style.decoration_thickness_multiplier, style.color,
+                           style.font_size, style.text_shadows.size());
+    for (const TextShadow& shadow : style.text_shadows) {
+      fml::HashCombineSeed64(hash, shadow.color, shadow.offset.x(),
+                             shadow.offset.y(), shadow.blur_radius);
+    }
+    if (!hashed) {
+      content_hash_ = 0;
+      return;
+    }
+  }
+  // Keep 0 for paragraphs whose content is unknown.
+  content_hash_ = hash != 0 ? hash : 1;
+}
+
+minikin::Layout* ParagraphTxt::GetShapedRun(
+    const BidiRun& run,
+    const minikin::FontStyle& font,
+    const minikin::MinikinPaint& paint,
+    const std::shared_ptr<minikin::FontCollection>& collection) {
+  ShapedRunKey key(run.start(), run.end(), run.is_rtl());
+  auto found = shaped_runs_.find(key);
+  if (found == shaped_runs_.end()) {
+    minikin::Layout layout;
+    layout.doLayout(text_.data(), run.start(), run.size(), text_.size(),
+                    run.is_rtl(), font, paint, collection);
+    found = shaped_runs_.emplace(key, ShapedRun{std::move(layout), 0}).first;
+  }
+  found->second.generation = layout_generation_;
+  return &found->second.layout;
 }
 
 void ParagraphTxt::UpdateLineMetrics(const SkFontMetrics& metrics,
@@ -1377,28 +1587,38 @@ sk_sp<SkTypeface> ParagraphTxt::GetDefaultSkiaTypeface(const TextStyle& style) {
 // paragraph.
 void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
   SkPoint base_offset = SkPoint::Make(x, y);
-  SkPaint paint;
   // Paint the background first before painting any text to prevent
   // potential overlap.
   for (const PaintRecord& record : records_) {
     PaintBackground(canvas, record, base_offset);
   }
-  for (const PaintRecord& record : records_) {
-    if (record.style().has_foreground) {
-      paint = record.style().foreground;
-    } else {
-      paint.reset();
-      paint.setColor(record.style().color);
-    }
+  auto merged = merged_blobs_.begin();
+  for (size_t i = 0; i < records_.size(); ++i) {
+    const PaintRecord& record = records_[i];
+    if (merged != merged_blobs_.end() &&
+        i == merged->first_record + merged->record_count)
+      ++merged;
     SkPoint offset = base_offset + record.offset();
-    if (record.GetPlaceholderRun() == nullptr) {
+    if (merged != merged_blobs_.end() && i >= merged->first_record) {
+      // The glyphs of this record are drawn by the merged blob.
+      if (i == merged->first_record) {
+        canvas->drawTextBlob(merged->blob, offset.x(), offset.y(),
+                             GetTextPaint(record.style()));
+      }
+    } else if (record.GetPlaceholderRun() == nullptr) {
       PaintShadow(canvas, record, offset);
-      canvas->drawTextBlob(record.text(), offset.x(), offset.y(), paint);
+      canvas->drawTextBlob(record.text(), offset.x(), offset.y(),
+                           GetTextPaint(record.style()));
     }
     PaintDecorations(canvas, record, base_offset);
   }
 }
 
+uint64_t ParagraphTxt::GetContentHash() {
+  FML_DCHECK(!needs_layout_) << "only valid after layout";
+  return content_hash_;
+}
+
 void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
                                     const PaintRecord& record,
                                     SkPoint base_offset) {
@@ -17,7 +17,9 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_TXT_H_
 #define LIB_TXT_SRC_PARAGRAPH_TXT_H_
 
+#include <map>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -25,6 +27,7 @@
 #include "flutter/fml/macros.h"
 #include "font_collection.h"
 #include "line_metrics.h"
+#include "minikin/Layout.h"
 #include "minikin/LineBreaker.h"
 #include "paint_record.h"
 #include "paragraph.h"
@@ -33,8 +36,10 @@
 #include "run_metrics.h"
 #include "styled_runs.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
+#include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkFontMetrics.h"
 #include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 #include "utils/LinuxUtils.h"
 #include "utils/MacUtils.h"
 #include "utils/WindowsUtils.h"
@@ -110,6 +115,8 @@ class ParagraphTxt : public Paragraph {
 
   Range<size_t> GetWordBoundary(size_t offset) override;
 
+  uint64_t GetContentHash() override;
+
   // Returns the number of lines the paragraph takes up. If the text exceeds the
   // amount width and maxlines provides, Layout() truncates the extra text from
   // the layout and this will return the max lines allowed.
@@ -153,6 +160,8 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST_LINUX_ONLY(ParagraphTest, EmojiMultiLineRectsParagraph);
   FRIEND_TEST(ParagraphTest, HyphenBreakParagraph);
   FRIEND_TEST(ParagraphTest, RepeatLayoutParagraph);
+  FRIEND_TEST(ParagraphTest, RelayoutAtNewWidthReusesShaping);
+  FRIEND_TEST(ParagraphTest, MergedTextBlobsAndContentHash);
   FRIEND_TEST(ParagraphTest, Ellipsize);
   FRIEND_TEST(ParagraphTest, UnderlineShiftParagraph);
   FRIEND_TEST(ParagraphTest, WavyDecorationParagraph);
@@ -193,6 +202,21 @@ class ParagraphTxt : public Paragraph {
   // Stores the result of Layout().
   std::vector<PaintRecord> records_;
 
+  // The glyphs of consecutive records of a line that are drawn with the same
+  // paint, merged by Layout() into a single blob positioned relative to the
+  // offset of the first of them. Paint() draws it in place of the blobs of the
+  // individual records.
+  struct MergedTextBlob {
+    size_t first_record;
+    size_t record_count;
+    sk_sp<SkTextBlob> blob;
+  };
+  std::vector<MergedTextBlob> merged_blobs_;
+
+  // A hash of everything Paint() draws, or 0 if the paragraph is painted with
+  // effects that are not hashed (e.g. shaders).
+  uint64_t content_hash_ = 0;
+
   bool did_exceed_max_lines_;
 
   // Strut metrics of zero will have no effect on the layout.
@@ -320,6 +344,41 @@ class ParagraphTxt : public Paragraph {
 
   bool needs_layout_ = true;
 
+  // The results of the layout work that does not depend on the width, kept so
+  // that a layout at another width only has to break and position the lines.
+  // They are discarded by a layout that follows a call to SetDirty.
+  //
+  // Whether the bidi runs and the widths measured for the line breaker are
+  // valid.
+  bool shaping_cached_ = false;
+  std::vector<BidiRun> bidi_runs_;
+  // The widths of all the code units of the text, as measured for the line
+  // breaker, and the width of every style run in the order in which they are
+  // added to the line breaker.
+  std::vector<float> line_breaker_char_widths_;
+  std::vector<double> line_breaker_run_widths_;
+
+  // The start, end and direction of a shaped run.
+  using ShapedRunKey = std::tuple<size_t, size_t, bool>;
+  struct ShapedRun {
+    minikin::Layout layout;
+    // The last layout pass that used the run.
+    size_t generation;
+  };
+  // The runs shaped by the last two layout passes. The lines of a paragraph
+  // that is laid out at alternating widths (e.g. to compute its intrinsic
+  // width) keep finding their runs here.
+  std::map<ShapedRunKey, ShapedRun> shaped_runs_;
+  size_t layout_generation_ = 0;
+
+  // The glyphs of a paint record, kept by Layout() until the record has its
+  // final offset.
+  struct RecordGlyphs {
+    SkFont font;
+    std::vector<SkGlyphID> glyphs;
+    std::vector<SkPoint> positions;
+  };
+
   struct WaveCoordinates {
     double x_start;
     double y_start;
@@ -342,12 +401,33 @@ class ParagraphTxt : public Paragraph {
       std::vector<PlaceholderRun> inline_placeholders,
       std::unordered_set<size_t> obj_replacement_char_indexes);
 
+  // Discards the cached results of the width independent layout work.
+  void ClearShapingCache();
+
   // Break the text into lines.
   bool ComputeLineBreaks();
 
   // Break the text into runs based on LTR/RTL text direction.
   bool ComputeBidiRuns(std::vector<BidiRun>* result);
 
+  // Returns the shaped text of |run|, shaping it unless it was shaped by one
+  // of the last two layout passes.
+  minikin::Layout* GetShapedRun(
+      const BidiRun& run,
+      const minikin::FontStyle& font,
+      const minikin::MinikinPaint& paint,
+      const std::shared_ptr<minikin::FontCollection>& collection);
+
+  // Builds the merged blobs of the records of a line, which start at
+  // records_[first_record]. |glyphs| holds the glyphs of each of these records.
+  void MergeTextBlobs(size_t first_record,
+                      const std::vector<RecordGlyphs>& glyphs);
+
+  // Combines what Paint() draws for the records of a line, which start at
+  // records_[first_record], into content_hash_.
+  void HashRecords(size_t first_record,
+                   const std::vector<RecordGlyphs>& glyphs);
+
   // Calculates and populates strut based on paragraph_style_ strut info.
   void ComputeStrut(StrutMetrics* strut, SkFont& font);
 
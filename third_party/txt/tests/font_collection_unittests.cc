@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/utils/SkCustomTypeface.h"
+#include "txt/fallback_font_cache.h"
 #include "txt/font_collection.h"
 #include "txt_test_utils.h"
 
@@ -138,6 +140,68 @@ TEST(FontCollectionTest, CheckSkTypefacesSorting) {
             SkFontStyle::kExpanded_Width);
 }
 
+TEST(FallbackFontCache, SerializeRoundTrip) {
+  FallbackFontCache cache;
+  SkFontStyle bold = SkFontStyle::Bold();
+  cache.Insert(0x4e2d, "zh-Hans", SkFontStyle(), "Noto Sans CJK SC");
+  cache.Insert(0x4e2d, "ja", SkFontStyle(), "Noto Sans CJK JP");
+  cache.Insert(0x1f600, "", bold, "Noto Color Emoji");
+  // No family covers this code point.
+  cache.Insert(0xe000, "", SkFontStyle(), "");
+  std::vector<uint8_t> snapshot = cache.Serialize(42);
+
+  FallbackFontCache loaded;
+  ASSERT_FALSE(loaded.Deserialize(snapshot.data(), snapshot.size(), 43));
+  ASSERT_EQ(loaded.GetEntryCount(), 0ull);
+  ASSERT_TRUE(loaded.Deserialize(snapshot.data(), snapshot.size(), 42));
+  ASSERT_EQ(loaded.GetEntryCount(), 4ull);
+
+  std::string family_name;
+  ASSERT_TRUE(loaded.Lookup(0x4e2d, "ja", SkFontStyle(), &family_name));
+  EXPECT_EQ(family_name, "Noto Sans CJK JP");
+  ASSERT_TRUE(loaded.Lookup(0x1f600, "", bold, &family_name));
+  EXPECT_EQ(family_name, "Noto Color Emoji");
+  ASSERT_TRUE(loaded.Lookup(0xe000, "", SkFontStyle(), &family_name));
+  EXPECT_EQ(family_name, "");
+  EXPECT_FALSE(loaded.Lookup(0x1f600, "", SkFontStyle(), &family_name));
+  EXPECT_FALSE(loaded.Lookup(0x4e2d, "ko", SkFontStyle(), &family_name));
+
+  // A truncated snapshot keeps the records that are complete.
+  FallbackFontCache truncated;
+  ASSERT_TRUE(truncated.Deserialize(snapshot.data(), snapshot.size() - 1, 42));
+  EXPECT_EQ(truncated.GetEntryCount(), 3ull);
+}
+
+TEST(FallbackFontCache, SnapshotIsSavedAndLoaded) {
+  fml::ScopedTemporaryDirectory directory;
+
+  FallbackFontCache cache;
+  ASSERT_FALSE(cache.ScheduleSave());
+  cache.LoadSnapshot(directory.path(), 1);
+  ASSERT_FALSE(cache.ScheduleSave());
+  cache.Insert(0x4e2d, "", SkFontStyle(), "Noto Sans CJK SC");
+  ASSERT_TRUE(cache.ScheduleSave());
+  // A save is already scheduled.
+  ASSERT_FALSE(cache.ScheduleSave());
+  ASSERT_TRUE(cache.SaveSnapshot());
+  ASSERT_TRUE(fml::FileExists(directory.fd(),
+                              FallbackFontCache::kSnapshotFileName));
+  ASSERT_FALSE(cache.ScheduleSave());
+
+  FallbackFontCache loaded;
+  loaded.LoadSnapshot(directory.path(), 1);
+  std::string family_name;
+  ASSERT_TRUE(loaded.Lookup(0x4e2d, "", SkFontStyle(), &family_name));
+  EXPECT_EQ(family_name, "Noto Sans CJK SC");
+  // Nothing changed since the snapshot was loaded.
+  EXPECT_FALSE(loaded.ScheduleSave());
+
+  // The fonts of the platform changed.
+  FallbackFontCache stale;
+  stale.LoadSnapshot(directory.path(), 2);
+  EXPECT_EQ(stale.GetEntryCount(), 0ull);
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {
@@ -16,8 +16,10 @@
 
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "flutter/fml/logging.h"
+#include "minikin/Layout.h"
 #include "render_test.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -6560,4 +6562,227 @@ TEST_F(ParagraphTest, TextHeightBehaviorRectsParagraph) {
   ASSERT_TRUE(Snapshot());
 }
 
+TEST_F(ParagraphTest, LayoutOnMultipleThreadsMatchesSingleThreadedLayout) {
+  const char* text =
+      "Minikin lays out paragraphs on several threads at once. Each thread "
+      "shapes the same words, so they race on the layout cache.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  auto build_paragraph = [&]() {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  auto expected = build_paragraph();
+  expected->Layout(GetTestCanvasWidth());
+  // Force every thread to shape the words itself.
+  minikin::Layout::purgeCaches();
+
+  const size_t kThreadCount = 4;
+  std::vector<std::unique_ptr<ParagraphTxt>> paragraphs;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    paragraphs.push_back(build_paragraph());
+  }
+  std::vector<std::thread> threads;
+  for (auto& paragraph : paragraphs) {
+    threads.emplace_back([&paragraph, width = GetTestCanvasWidth()]() {
+      for (int i = 0; i < 10; i++) {
+        paragraph->Layout(width + i);
+        paragraph->Layout(width);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& paragraph : paragraphs) {
+    EXPECT_EQ(paragraph->GetLineCount(), expected->GetLineCount());
+    EXPECT_DOUBLE_EQ(paragraph->GetLongestLine(), expected->GetLongestLine());
+    EXPECT_DOUBLE_EQ(paragraph->GetMaxIntrinsicWidth(),
+                     expected->GetMaxIntrinsicWidth());
+    EXPECT_DOUBLE_EQ(paragraph->GetHeight(), expected->GetHeight());
+  }
+}
+
+TEST_F(ParagraphTest, LayoutCacheStaysWithinByteBudget) {
+  const char* text =
+      "Every word of this paragraph is shaped once and then found in the "
+      "layout cache, until the words evicted to respect its budget have to "
+      "be shaped again.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+
+  const size_t default_max_bytes = minikin::Layout::getCacheStats().maxBytes;
+  minikin::Layout::purgeCaches();
+
+  paragraph->Layout(GetTestCanvasWidth());
+  minikin::LayoutCacheStats first = minikin::Layout::getCacheStats();
+  EXPECT_GT(first.entries, 0u);
+  EXPECT_GT(first.bytes, 0u);
+  EXPECT_LE(first.bytes, first.maxBytes);
+
+  // Relaying out a dirty paragraph shapes its words again, which finds them in
+  // the layout cache rather than in the paragraph's own shaped runs.
+  paragraph->SetDirty();
+  paragraph->Layout(GetTestCanvasWidth() + 1);
+  minikin::LayoutCacheStats second = minikin::Layout::getCacheStats();
+  EXPECT_GT(second.hits, first.hits);
+
+  // Shrinking the budget evicts words immediately, and the evicted words
+  // miss the cache when the paragraph is laid out again.
+  minikin::Layout::setCacheMaxBytes(first.bytes / 2);
+  minikin::LayoutCacheStats shrunk = minikin::Layout::getCacheStats();
+  EXPECT_GT(shrunk.evictions, second.evictions);
+  EXPECT_LE(shrunk.bytes, first.bytes / 2);
+
+  paragraph->SetDirty();
+  paragraph->Layout(GetTestCanvasWidth());
+  EXPECT_GT(minikin::Layout::getCacheStats().misses, shrunk.misses);
+
+  minikin::Layout::setCacheMaxBytes(default_max_bytes);
+}
+
+TEST_F(ParagraphTest, RelayoutAtNewWidthReusesShaping) {
+  const char* text =
+      "A paragraph laid out at alternating widths, as when its intrinsic "
+      "width is measured before it is laid out at the width of its parent, "
+      "only has to break and position its lines again.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  auto build_paragraph = [&]() {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  auto expected = build_paragraph();
+  expected->Layout(300);
+
+  auto paragraph = build_paragraph();
+  paragraph->Layout(300);
+  paragraph->Layout(600);
+  ASSERT_TRUE(paragraph->shaping_cached_);
+  ASSERT_FALSE(paragraph->shaped_runs_.empty());
+
+  // Neither the line breaker nor the shaping of the runs looks up any words.
+  minikin::LayoutCacheStats before = minikin::Layout::getCacheStats();
+  paragraph->Layout(300);
+  minikin::LayoutCacheStats after = minikin::Layout::getCacheStats();
+  EXPECT_EQ(after.hits, before.hits);
+  EXPECT_EQ(after.misses, before.misses);
+
+  ASSERT_EQ(paragraph->GetLineCount(), expected->GetLineCount());
+  EXPECT_DOUBLE_EQ(paragraph->GetLongestLine(), expected->GetLongestLine());
+  EXPECT_DOUBLE_EQ(paragraph->GetMaxIntrinsicWidth(),
+                   expected->GetMaxIntrinsicWidth());
+  EXPECT_DOUBLE_EQ(paragraph->GetMinIntrinsicWidth(),
+                   expected->GetMinIntrinsicWidth());
+  EXPECT_DOUBLE_EQ(paragraph->GetHeight(), expected->GetHeight());
+  ASSERT_EQ(paragraph->records_.size(), expected->records_.size());
+  for (size_t i = 0; i < paragraph->records_.size(); i++) {
+    EXPECT_EQ(paragraph->records_[i].offset(), expected->records_[i].offset());
+    EXPECT_EQ(paragraph->records_[i].line(), expected->records_[i].line());
+  }
+  std::vector<txt::Paragraph::TextBox> boxes = paragraph->GetRectsForRange(
+      0, u16_text.length(), Paragraph::RectHeightStyle::kTight,
+      Paragraph::RectWidthStyle::kTight);
+  std::vector<txt::Paragraph::TextBox> expected_boxes =
+      expected->GetRectsForRange(0, u16_text.length(),
+                                 Paragraph::RectHeightStyle::kTight,
+                                 Paragraph::RectWidthStyle::kTight);
+  ASSERT_EQ(boxes.size(), expected_boxes.size());
+  for (size_t i = 0; i < boxes.size(); i++) {
+    EXPECT_EQ(boxes[i].rect, expected_boxes[i].rect);
+  }
+
+  // Changing the paragraph discards the shaped runs.
+  paragraph->SetDirty();
+  paragraph->Layout(300);
+  EXPECT_EQ(paragraph->GetLineCount(), expected->GetLineCount());
+  EXPECT_DOUBLE_EQ(paragraph->GetHeight(), expected->GetHeight());
+}
+
+TEST_F(ParagraphTest, MergedTextBlobsAndContentHash) {
+  auto build_paragraph = [](SkColor last_color) {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.color = SK_ColorBLACK;
+    text_style.font_size = 20;
+    builder.PushStyle(text_style);
+    builder.AddText(u"Counter ");
+    text_style.font_size = 30;
+    builder.PushStyle(text_style);
+    builder.AddText(u"42");
+    text_style.color = last_color;
+    builder.PushStyle(text_style);
+    builder.AddText(u"!");
+    builder.Pop();
+    builder.Pop();
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(GetTestCanvasWidth());
+    return paragraph;
+  };
+
+  auto paragraph = build_paragraph(SK_ColorRED);
+  ASSERT_EQ(paragraph->GetLineCount(), 1ull);
+  ASSERT_EQ(paragraph->records_.size(), 3ull);
+  // The two black runs are drawn as a single blob.
+  ASSERT_EQ(paragraph->merged_blobs_.size(), 1ull);
+  EXPECT_EQ(paragraph->merged_blobs_[0].first_record, 0ull);
+  EXPECT_EQ(paragraph->merged_blobs_[0].record_count, 2ull);
+
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  ASSERT_TRUE(Snapshot());
+
+  // The blobs are built by the layout, not by painting the paragraph.
+  SkTextBlob* blob = paragraph->merged_blobs_[0].blob.get();
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  EXPECT_EQ(paragraph->merged_blobs_[0].blob.get(), blob);
+
+  // Paragraphs that paint the same content have the same hash.
+  EXPECT_NE(paragraph->GetContentHash(), 0ull);
+  EXPECT_EQ(paragraph->GetContentHash(),
+            build_paragraph(SK_ColorRED)->GetContentHash());
+  EXPECT_NE(paragraph->GetContentHash(),
+            build_paragraph(SK_ColorBLUE)->GetContentHash());
+
+  // Relaying out the paragraph at the same width keeps the hash.
+  uint64_t content_hash = paragraph->GetContentHash();
+  paragraph->SetDirty();
+  paragraph->Layout(GetTestCanvasWidth());
+  EXPECT_EQ(paragraph->GetContentHash(), content_hash);
+}
+
 }  // namespace txt